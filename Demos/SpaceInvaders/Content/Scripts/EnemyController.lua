@@ -2,15 +2,19 @@
 --- Created by Astera
 ---
 
+local speed = 200
+
+--- State of each enemy, every entity gets its own copy passed to the callbacks below as self
+Instance = {
+    deltaX = speed,
+}
+
 --- Called at entity initialization
 ---@param this Entity
-function OnAwake(this)
+function Instance:OnAwake(this)
     Log:Debug(string.format("OnAwake() called for '%s'", this.name))
 end
 
-local speed = 200
-local deltaX = speed
-
 --- Check if current position is within specified bounds
 ---@param current number
 ---@param leftBound number
@@ -23,27 +27,27 @@ end
 --- Called every frame, before rendering
 ---@param this Entity
 ---@param clock Clock
-function OnUpdate(this, clock)
+function Instance:OnUpdate(this, clock)
     local transform = this.transform
     local xBounds = 200
     local centerX = Game:GetScreenSize().x / 2
     local currentPosX = transform.position.x
 
     if CheckOOB(currentPosX, (centerX - xBounds), (centerX + xBounds)) then
-        deltaX = -deltaX
+        self.deltaX = -self.deltaX
     end
 
-    transform:Translate(Vec2(deltaX * clock:GetDeltaTime(), 0))
+    transform:Translate(Vec2(self.deltaX * clock:GetDeltaTime(), 0))
 end
 
 --- Called every frame, after rendering
 ---@param this Entity
-function OnLateUpdate(this)
+function Instance:OnLateUpdate(this)
 
 end
 
 --- Called at entity destruction
 ---@param this Entity
-function OnDestroyed(this)
+function Instance:OnDestroyed(this)
     Log:Debug(string.format("OnDestroyed() called for '%s'", this.name))
 end
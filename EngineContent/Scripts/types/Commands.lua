@@ -0,0 +1,20 @@
+-- stubs/Commands.lua
+
+---@class Commands Changes to the world from isolated scripts (`Isolated = true`), applied once every lane has
+---finished. Only defined for isolated scripts.
+local Commands = {}
+
+---Spawn copies of a prefab
+---@param prefab string Name of the prefab
+---@param count number Number of instances
+---@param positions Vec2[]|nil Position of each instance, or nil to use the prefab's
+---@return boolean False if the prefab doesn't exist or the positions don't match the count
+function Commands:Instantiate(prefab, count, positions)
+end
+
+---Destroy an entity and its descendants
+---@param entity number Entity ID
+function Commands:Destroy(entity)
+end
+
+return Commands
\ No newline at end of file
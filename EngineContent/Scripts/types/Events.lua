@@ -0,0 +1,52 @@
+-- stubs/Events.lua
+
+-- Scripts talk to each other through events instead of finding each other by name. An event sent during a frame is
+-- delivered at the start of the next one. A behavior script registers handlers with `Subscribe` while it loads, at the
+-- top level of the file, and each handler is called at most once per frame with every event it receives. Isolated
+-- scripts can send events but not subscribe to them.
+
+---@class ScriptEvents Events one handler receives in a frame
+---The table is reused every frame, only indices 1..count are current.
+---@field count number Number of events
+---@field target (number|nil)[] Entity ID each event was sent to, nil for events sent to a tag or broadcast
+---@field sender (number|nil)[] Entity ID that sent each event, nil if the sender didn't say
+---@field value number[] Value sent with each event, 0 if none was
+---@field instance table[] Instance table of each target that runs this script, nil for other targets. Only present
+---when the script declares Instance.
+local ScriptEvents = {}
+
+---@class Events Sends events to the handlers scripts register with `Subscribe`
+local Events = {}
+
+---Send an event to one entity
+---@param type string Event name, like "Damage"
+---@param target number Entity ID
+---@param value number|nil Value handlers read from `events.value`
+---@param sender number|nil Entity ID of the sender, usually `entity.id`
+function Events:Send(type, target, value, sender)
+end
+
+---Send an event to every entity with a name, prefab instances are named after their prefab
+---@param type string Event name
+---@param tag string Entity name
+---@param value number|nil Value handlers read from `events.value`
+---@param sender number|nil Entity ID of the sender
+function Events:SendTag(type, tag, value, sender)
+end
+
+---Send an event without a target, only handlers without a filter receive it
+---@param type string Event name
+---@param value number|nil Value handlers read from `events.value`
+---@param sender number|nil Entity ID of the sender
+function Events:Broadcast(type, value, sender)
+end
+
+---Register a handler for an event type. Only works while the script loads, reloading the script replaces its handlers.
+---@param type string Event name
+---@param handler fun(events: ScriptEvents) Called once per frame with every event that passed the filter
+---@param filter number|string|nil Entity ID to only receive events sent to that entity, entity name to only receive
+---events sent to that tag or to entities with that name, nil to receive every event of the type
+function Subscribe(type, handler, filter)
+end
+
+return Events
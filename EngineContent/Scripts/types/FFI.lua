@@ -0,0 +1,57 @@
+-- stubs/FFI.lua
+
+---@class FFIVec2 Two dimensional vector stored as a LuaJIT FFI struct
+---@field x number The X coordinate
+---@field y number The Y coordinate
+local FFIVec2 = {}
+
+---Length of the vector
+---@return number
+function FFIVec2:Length()
+end
+
+---@class FFITransform Transform component accessed directly through LuaJIT FFI. Only valid during the callback it was
+---fetched in.
+---@field position FFIVec2 World position
+---@field rotation FFIVec2 Rotation, x holds the angle
+---@field scale FFIVec2 Scale factor
+local FFITransform = {}
+
+---Translate the transform by a delta
+---@param delta FFIVec2|Vec2 Translation offset
+function FFITransform:Translate(delta)
+end
+
+---Rotate the transform by an angle
+---@param angle number Rotation angle
+function FFITransform:Rotate(angle)
+end
+
+---Scale the transform by a factor
+---@param factor FFIVec2|Vec2 Scale multiplier
+function FFITransform:Scale(factor)
+end
+
+---@class FFI Fast component access through LuaJIT FFI, field reads and writes compile to plain memory accesses
+FFI = {}
+
+---Creates a vector that doesn't allocate inside compiled loops. Called with a dot, like a constructor.
+---@param x number
+---@param y number
+---@return FFIVec2
+function FFI.Vec2(x, y)
+end
+
+---Gets an entity's transform
+---@param entity Entity
+---@return FFITransform
+function FFI:Transform(entity)
+end
+
+---Gets the transforms of the entities handed to a batch callback, indexed from 0 to entities.count - 1
+---@param entities table
+---@return FFITransform[]
+function FFI:Transforms(entities)
+end
+
+return FFI
@@ -94,17 +94,37 @@ function Math:RadToDeg(a)
 end
 
 ---Generate random number between 0 and 1
----@return number Random value [0, 1]
+---@return number Random value [0, 1)
 function Math:Random()
 end
 
----Generate random number between min and max
+---Generate random integer between min and max
 ---@param min number
 ---@param max number
 ---@return number Random value [min, max]
 function Math:RandomInt(min, max)
 end
 
+---Generate random number between min and max
+---@param min number
+---@param max number
+---@return number Random value [min, max)
+function Math:RandomRange(min, max)
+end
+
+---Fill a table with random numbers, reuse the same table to avoid allocations
+---@param results table Receives values at indices 1..count
+---@param count number Number of values to generate
+---@param min number|nil Lower bound, defaults to 0
+---@param max number|nil Upper bound, defaults to 1
+function Math:RandomFill(results, count, min, max)
+end
+
+---Set the seed every random stream derives from, the same seed replays the same sequence
+---@param seed number Seed value
+function Math:SetSeed(seed)
+end
+
 ---Linear interpolation between two values
 ---@param a number Start value
 ---@param b number End value
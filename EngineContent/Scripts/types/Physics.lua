@@ -0,0 +1,114 @@
+---
+--- Generated by EmmyLua(https://github.com/EmmyLua)
+--- Created by jr.
+--- DateTime: 12/16/25 8:02 AM
+---
+
+---@class RaycastHit Closest collider hit by a ray, reuse one instance across queries
+---@field entity number Entity ID of the collider that was hit
+---@field point Vec2 World-space point where the ray entered the collider
+---@field normal Vec2 Surface normal at the hit point
+---@field distance number Distance from the ray origin to the hit point
+local RaycastHit = {}
+
+---Creates an empty hit to pass to Physics:Raycast
+---@return RaycastHit
+function RaycastHit.new()
+end
+
+---@class CollisionEvents Contacts that began or ended this frame for every entity using the behavior script
+---Passed to `OnCollisionEnter(events)` and `OnCollisionExit(events)`, which run once per frame per script.
+---The table is reused every frame, only indices 1..count are current.
+---@field count number Number of events
+---@field entity number[] Entity ID receiving each event, compare with `entity.id` from OnUpdate
+---@field other number[] Entity ID on the other side of each contact
+---@field trigger boolean[] Whether either collider of each contact is a trigger
+local CollisionEvents = {}
+
+---@class PhysicsEngine Spatial queries against the colliders as of the last physics update
+---Results are written into tables owned by the script so they can be reused every frame
+local PhysicsEngine = {}
+
+---Finds the closest collider crossed by a ray
+---@param origin Vec2 Start of the ray
+---@param direction Vec2 Direction of the ray, does not need to be normalized
+---@param maxDistance number Length of the ray
+---@param hit RaycastHit Receives the hit
+---@param ignore number|nil Entity ID to leave out, usually the caller
+---@return boolean Whether anything was hit
+function PhysicsEngine:Raycast(origin, direction, maxDistance, hit, ignore)
+end
+
+---Finds the colliders overlapping a box
+---@param min Vec2 Lower corner of the box
+---@param max Vec2 Upper corner of the box
+---@param results table Receives entity IDs at indices 1..n
+---@param ignore number|nil Entity ID to leave out
+---@return number Number of entities found
+function PhysicsEngine:OverlapAABB(min, max, results, ignore)
+end
+
+---Finds the colliders overlapping a circle
+---@param center Vec2 Center of the circle
+---@param radius number Radius of the circle
+---@param results table Receives entity IDs at indices 1..n
+---@param ignore number|nil Entity ID to leave out
+---@return number Number of entities found
+function PhysicsEngine:OverlapCircle(center, radius, results, ignore)
+end
+
+---Finds the colliders whose centers are closest to a point, nearest first
+---@param point Vec2 Point to search from
+---@param count number Maximum number of entities to return
+---@param results table Receives entity IDs at indices 1..n
+---@param maxDistance number|nil Colliders further away are ignored
+---@param ignore number|nil Entity ID to leave out
+---@return number Number of entities found
+function PhysicsEngine:QueryNearest(point, count, results, maxDistance, ignore)
+end
+
+---Casts many rays in one call, hit i is written to hits[i]
+---@param origins Vec2[] Ray origins
+---@param directions Vec2[] Ray directions
+---@param maxDistance number Length of every ray
+---@param hits RaycastHit[] Receives one hit per ray, missing entries are created
+---@param ignore number|nil Entity ID to leave out
+---@return number Number of rays that hit something
+function PhysicsEngine:RaycastBatch(origins, directions, maxDistance, hits, ignore)
+end
+
+---Runs many box overlaps in one call, entities of query i are at results[(i - 1) * maxResults + 1 .. + counts[i]]
+---@param mins Vec2[] Lower corners
+---@param maxs Vec2[] Upper corners
+---@param maxResults number Entities kept per query
+---@param results table Receives entity IDs
+---@param counts table Receives the number of entities per query
+---@param ignore number|nil Entity ID to leave out
+function PhysicsEngine:OverlapAABBBatch(mins, maxs, maxResults, results, counts, ignore)
+end
+
+---Runs many circle overlaps with the same radius in one call, results are laid out as in OverlapAABBBatch
+---@param centers Vec2[] Circle centers
+---@param radius number Radius of every circle
+---@param maxResults number Entities kept per query
+---@param results table Receives entity IDs
+---@param counts table Receives the number of entities per query
+---@param ignore number|nil Entity ID to leave out
+function PhysicsEngine:OverlapCircleBatch(centers, radius, maxResults, results, counts, ignore)
+end
+
+---Runs many nearest queries in one call, results are laid out as in OverlapAABBBatch
+---@param points Vec2[] Points to search from
+---@param count number Entities kept per query
+---@param results table Receives entity IDs
+---@param counts table Receives the number of entities per query
+---@param maxDistance number|nil Colliders further away are ignored
+---@param ignore number|nil Entity ID to leave out
+function PhysicsEngine:QueryNearestBatch(points, count, results, counts, maxDistance, ignore)
+end
+
+---The global physics instance
+---@type PhysicsEngine
+Physics = {}
+
+return PhysicsEngine
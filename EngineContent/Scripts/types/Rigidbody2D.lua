@@ -0,0 +1,41 @@
+---
+--- Generated by EmmyLua(https://github.com/EmmyLua)
+--- Created by jr.
+--- DateTime: 12/14/25 9:12 AM
+---
+
+---@class Rigidbody2D 2D rigid body simulated by the physics engine
+---@field velocity Vec2 Linear velocity in units per second
+---@field angularVelocity number Angular velocity in radians per second
+---@field gravityScale number Multiplier for gravity on this body
+---@field mass number Mass of the body (read-only, use UpdateMass)
+---@field allowSleep boolean Whether the body may be put to sleep when resting
+---@field awake boolean Whether the body is currently simulated (read-only, use WakeUp)
+---@field bullet boolean Whether the body is swept between steps so it can't tunnel through thin colliders
+local Rigidbody2D = {}
+
+---Set a new mass and recompute the inverse mass
+---@param mass number New mass
+function Rigidbody2D:UpdateMass(mass)
+end
+
+---Apply a force to the center of mass for the next physics step
+---@param force Vec2 Force vector
+function Rigidbody2D:ApplyForce(force)
+end
+
+---Apply an instantaneous impulse to the center of mass
+---@param impulse Vec2 Impulse vector
+function Rigidbody2D:ApplyImpulse(impulse)
+end
+
+---Apply a torque for the next physics step
+---@param torque number Torque value
+function Rigidbody2D:ApplyTorque(torque)
+end
+
+---Wake the body so it is simulated again, applying forces or impulses also wakes it
+function Rigidbody2D:WakeUp()
+end
+
+return Rigidbody2D
@@ -0,0 +1,26 @@
+-- stubs/Routine.lua
+
+-- A behavior script may declare `Routine(this)`, or `Instance:Routine(this)` alongside its other Instance methods. The
+-- engine runs it as a coroutine for every entity with the script, starting once the entity is created. A routine
+-- sleeps with the wait functions below and costs nothing while it sleeps. It ends when it returns, or when its entity
+-- is destroyed or switched off. Isolated scripts can't have one.
+
+---Sleep for a number of frames
+---@param frames number|nil Frames to wait, 1 if omitted
+function WaitFrames(frames)
+end
+
+---Sleep for a number of seconds, the routine resumes on the first frame after they have passed
+---@param seconds number
+function WaitSeconds(seconds)
+end
+
+---Sleep until an event is signalled, the routine resumes on the next frame
+---@param name string Event name
+function WaitEvent(name)
+end
+
+---Wake every routine waiting on an event
+---@param name string Event name
+function SignalEvent(name)
+end
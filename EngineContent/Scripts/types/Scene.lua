@@ -17,6 +17,24 @@ end
 function SceneState:GetEntityTransform(entity)
 end
 
+---@param entity number Entity ID
+---@return Rigidbody2D|nil Attached rigidbody component, or nil if the entity has none
+function SceneState:GetEntityRigidbody(entity)
+end
+
+--- Parents an entity to another, its transform becomes relative to the parent. Children are destroyed with their
+--- parent.
+---@param child number Entity ID
+---@param parent number|nil Parent entity ID, or nil to detach the child
+---@return boolean False if the parent is the child or one of its descendants
+function SceneState:SetParent(child, parent)
+end
+
+---@param entity number Entity ID
+---@return number|nil Parent entity ID, or nil for root entities
+function SceneState:GetParent(entity)
+end
+
 --- Active scene instance
 ---@type SceneState
 Scene = {}
@@ -46,6 +46,7 @@ namespace Astera {
         Sprite         = 6,
         SpriteSheet    = 7,
         TextData       = 8,
+        Tilemap        = 9,
     };
 
     inline constexpr u64 kAssetIdBitmask     = 0x00FFFFFFFFFFFFFF;
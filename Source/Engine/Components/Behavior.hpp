@@ -32,6 +32,13 @@
 
 namespace Astera {
     struct Behavior {
+        /// @brief The entity hasn't been given an instance table yet, see ScriptEngine::CreateInstances
+        static constexpr i32 kNoInstance = -2;
+        /// @brief The script doesn't declare an Instance prototype, so its entities share the script's state
+        static constexpr i32 kStateless = -1;
+
         u64 script;
+        /// @brief The entity's instance table as packed by ScriptInstance::Pack, or one of the constants above
+        i32 instance {kNoInstance};
     };
 }  // namespace Astera
@@ -31,7 +31,41 @@
 #include "EngineCommon.hpp"
 
 namespace Astera {
+    enum class ColliderShape {
+        AABB,    // Axis-aligned box, ignores the transform rotation
+        Circle,  // Circle, radius scales with the larger transform scale axis
+        OBB      // Oriented box, rotates with the transform
+    };
+
+    /// @brief 2D collision shape attached to an entity
+    ///
+    /// Dimensions are in local units and are scaled by the entity's Transform, so the default collider matches a
+    /// sprite drawn at the same transform. Entities with a Collider2D but no Rigidbody2D act as static geometry.
     struct Collider2D {
-        u32 value;
+        /// @brief Shape used for collision tests
+        ColliderShape shape {ColliderShape::AABB};
+
+        /// @brief Full width and height of box shapes in local units
+        Vec2 size {1.0f, 1.0f};
+
+        /// @brief Radius of circle shapes in local units
+        f32 radius {0.5f};
+
+        /// @brief Offset of the shape center from the transform position in local units
+        Vec2 offset {0.0f};
+
+        /// @brief Triggers report overlaps but never generate a collision response
+        bool isTrigger {false};
+
+        /// @brief Layer bits this collider belongs to
+        u32 layer {1};
+
+        /// @brief Layers this collider collides with, a pair only collides when both masks accept the other layer
+        u32 collisionMask {0xFFFFFFFF};
+
+        /// @brief Layers whose contact begin/end events are delivered to this entity's behavior
+        u32 eventMask {0xFFFFFFFF};
+
+        bool operator==(const Collider2D& other) const = default;
     };
 }  // namespace Astera
@@ -0,0 +1,61 @@
+/*
+ *  Filename: Hierarchy.hpp
+ *  This code is part of the Astera core library
+ *  Copyright 2025 Jake Rieger
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include "EngineCommon.hpp"
+#include "Transform.hpp"
+#include "Vendor/entt/entt.hpp"
+
+namespace Astera {
+    /// @brief Parent link of a child entity, managed through SceneState::SetParent
+    ///
+    /// Only entities with a parent carry this component. A child's Transform is relative to its parent's world
+    /// transform, and the child is destroyed along with its parent.
+    struct Hierarchy {
+        entt::entity parent {entt::null};
+        u32 depth {1};  ///< Number of ancestors, set when SceneState rebuilds its hierarchy order
+    };
+
+    /// @brief World space transform cached by SceneState::UpdateWorldTransforms
+    ///
+    /// Only rebuilt when the entity's Transform or one of its ancestors changed since the last update, so reading it
+    /// costs nothing compared to Transform::GetMatrix. Rotation and scale compose component-wise, non-uniformly scaled
+    /// parents don't shear their rotated children.
+    struct WorldTransform {
+        // Checked for every entity on every update, kept at the front so unchanged entities only touch one cache line
+        Transform local {};    ///< Local transform the cache was built from
+        bool cached {false};   ///< False until built, or after the entity was re-parented
+        bool changed {false};  ///< Rebuilt by the last update, children use this to rebuild too
+
+        Mat4 matrix {1.0f};
+        Vec2 position {0.0f};
+        f32 rotation {0.0f};  ///< Degrees
+        Vec2 scale {1.0f, 1.0f};
+    };
+}  // namespace Astera
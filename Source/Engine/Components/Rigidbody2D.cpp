@@ -50,11 +50,13 @@ namespace Astera {
     void Rigidbody2D::ApplyForce(const Vec2& f) {
         if (type != BodyType::Dynamic) return;
         force += f;
+        WakeUp();
     }
 
     void Rigidbody2D::ApplyImpulse(const Vec2& impulse) {
         if (type != BodyType::Dynamic) return;
         velocity += impulse * inverseMass;
+        WakeUp();
     }
 
     void Rigidbody2D::ApplyImpulseAtPoint(const Vec2& impulse, const Vec2& contactPoint, const Vec2& centerOfMass) {
@@ -62,6 +64,7 @@ namespace Astera {
 
         // Linear impulse
         velocity += impulse * inverseMass;
+        WakeUp();
 
         // Angular impulse
         if (!lockRotation) {
@@ -74,10 +77,16 @@ namespace Astera {
     void Rigidbody2D::ApplyTorque(f32 t) {
         if (type != BodyType::Dynamic || lockRotation) return;
         torque += t;
+        WakeUp();
     }
 
     void Rigidbody2D::ClearForces() {
         force  = Vec2(0.0f);
         torque = 0.0f;
     }
+
+    void Rigidbody2D::WakeUp() {
+        awake        = true;
+        restingSteps = 0;
+    }
 }  // namespace Astera
\ No newline at end of file
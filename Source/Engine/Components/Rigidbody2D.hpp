@@ -99,6 +99,19 @@ namespace Astera {
         /// @brief If true, prevents rotation of the body
         bool lockRotation {false};
 
+        /// @brief If true, the body is put to sleep once it has been resting long enough
+        bool allowSleep {true};
+
+        /// @brief If true, the body is swept against other colliders each step so it can't tunnel through them
+        /// Meant for small, fast bodies such as projectiles, other bullets are ignored by the sweep
+        bool bullet {false};
+
+        /// @brief Sleeping bodies are skipped by the simulation until something wakes them
+        bool awake {true};
+
+        /// @brief Consecutive physics steps the body has stayed below the sleep velocity thresholds
+        u32 restingSteps {0};
+
         /// @brief Default constructor
         Rigidbody2D();
 
@@ -127,5 +140,8 @@ namespace Astera {
         /// @brief Clears all accumulated forces and torques
         /// Typically called after physics integration step
         void ClearForces();
+
+        /// @brief Wakes the body and resets its resting counter
+        void WakeUp();
     };
 }  // namespace Astera
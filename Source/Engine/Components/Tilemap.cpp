@@ -0,0 +1,238 @@
+/*
+ *  Filename: Tilemap.cpp
+ *  This code is part of the Astera core library
+ *  Copyright 2025 Jake Rieger
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "Tilemap.hpp"
+#include "StringConvert.inl"
+#include "Rendering/Geometry.hpp"
+
+namespace Astera {
+    void Tilemap::Resize(u32 width, u32 height) {
+        mWidth   = width;
+        mHeight  = height;
+        mChunksX = (width + kChunkSize - 1) / kChunkSize;
+        mChunksY = (height + kChunkSize - 1) / kChunkSize;
+
+        mTiles.assign(CAST<size_t>(width) * height, 0);
+
+        // The shared index buffer only depends on the chunk size, so it outlives the chunks
+        mChunks.clear();
+        mChunks.resize(CAST<size_t>(mChunksX) * mChunksY);
+    }
+
+    void Tilemap::LoadCSV(std::string_view csv) {
+        vector<vector<u16>> rows;
+
+        while (!csv.empty()) {
+            const size_t lineEnd  = csv.find('\n');
+            std::string_view line = csv.substr(0, lineEnd);
+            csv                   = lineEnd == std::string_view::npos ? std::string_view {} : csv.substr(lineEnd + 1);
+
+            vector<u16> row;
+            while (!line.empty()) {
+                const size_t comma    = line.find(',');
+                std::string_view cell = line.substr(0, comma);
+                line = comma == std::string_view::npos ? std::string_view {} : line.substr(comma + 1);
+
+                while (!cell.empty() && std::isspace(CAST<u8>(cell.front())))
+                    cell.remove_prefix(1);
+                while (!cell.empty() && std::isspace(CAST<u8>(cell.back())))
+                    cell.remove_suffix(1);
+                if (cell.empty()) continue;
+
+                const u64 tile = StringConvert::StringToU64Or(cell, 0);
+                if (tile > std::numeric_limits<u16>::max()) {
+                    throw std::runtime_error(fmt::format(
+                      "Tile id {} is out of range, tile ids go up to {}", tile, std::numeric_limits<u16>::max()));
+                }
+                row.push_back(CAST<u16>(tile));
+            }
+
+            if (!row.empty()) { rows.push_back(std::move(row)); }
+        }
+
+        if (rows.empty()) {
+            Resize(0, 0);
+            return;
+        }
+
+        const auto width = CAST<u32>(rows.front().size());
+        for (const auto& row : rows) {
+            if (row.size() != width) { throw std::runtime_error("Tilemap rows must all have the same length"); }
+        }
+
+        const auto height = CAST<u32>(rows.size());
+        Resize(width, height);
+
+        // CSV rows are authored top-down, tile rows are stored bottom-up
+        for (u32 y = 0; y < height; ++y) {
+            std::ranges::copy(rows[height - 1 - y], mTiles.begin() + CAST<size_t>(y) * width);
+        }
+    }
+
+    void Tilemap::SetTile(u32 x, u32 y, u16 tile) {
+        ASTERA_ASSERT(x < mWidth && y < mHeight);
+
+        auto& current = mTiles[CAST<size_t>(y) * mWidth + x];
+        if (current == tile) return;
+
+        current = tile;
+        mChunks[(y / kChunkSize) * mChunksX + (x / kChunkSize)].dirty = true;
+    }
+
+    u16 Tilemap::GetTile(u32 x, u32 y) const {
+        ASTERA_ASSERT(x < mWidth && y < mHeight);
+        return mTiles[CAST<size_t>(y) * mWidth + x];
+    }
+
+    void Tilemap::RebuildDirtyChunks() {
+        for (u32 chunkY = 0; chunkY < mChunksY; ++chunkY) {
+            for (u32 chunkX = 0; chunkX < mChunksX; ++chunkX) {
+                if (mChunks[chunkY * mChunksX + chunkX].dirty) { RebuildChunk(chunkX, chunkY); }
+            }
+        }
+    }
+
+    bool Tilemap::GetVisibleChunks(const Mat4& model,
+                                   const Vec2& worldMin,
+                                   const Vec2& worldMax,
+                                   u32& outMinX,
+                                   u32& outMinY,
+                                   u32& outMaxX,
+                                   u32& outMaxY) const {
+        if (mChunks.empty()) return false;
+
+        // Bring the visible rectangle into tilemap-local space and take its bounds
+        const Mat4 inverseModel = glm::inverse(model);
+        const Vec2 corners[]    = {worldMin, {worldMax.x, worldMin.y}, {worldMin.x, worldMax.y}, worldMax};
+
+        Vec2 localMin {std::numeric_limits<f32>::max()};
+        Vec2 localMax {std::numeric_limits<f32>::lowest()};
+        for (const auto& corner : corners) {
+            const Vec2 local = Vec2(inverseModel * Vec4(corner, 0.0f, 1.0f));
+            localMin         = glm::min(localMin, local);
+            localMax         = glm::max(localMax, local);
+        }
+
+        const Vec2 chunkExtent = tileSize * CAST<f32>(kChunkSize);
+        const Vec2 first       = glm::floor(localMin / chunkExtent);
+        const Vec2 last        = glm::floor(localMax / chunkExtent);
+
+        if (last.x < 0.0f || last.y < 0.0f || first.x >= CAST<f32>(mChunksX) || first.y >= CAST<f32>(mChunksY)) {
+            return false;
+        }
+
+        outMinX = CAST<u32>(glm::max(first.x, 0.0f));
+        outMinY = CAST<u32>(glm::max(first.y, 0.0f));
+        outMaxX = CAST<u32>(glm::min(last.x, CAST<f32>(mChunksX - 1)));
+        outMaxY = CAST<u32>(glm::min(last.y, CAST<f32>(mChunksY - 1)));
+
+        return true;
+    }
+
+    void Tilemap::RebuildChunk(u32 chunkX, u32 chunkY) {
+        auto& chunk = mChunks[chunkY * mChunksX + chunkX];
+        chunk.dirty = false;
+
+        if (!mQuadIndices) {
+            constexpr u32 kQuadsPerChunk = kChunkSize * kChunkSize;
+
+            vector<u32> indices(kQuadsPerChunk * 6);
+            for (u32 quad = 0; quad < kQuadsPerChunk; ++quad) {
+                const u32 base = quad * 4;
+
+                indices[quad * 6 + 0] = base + 0;
+                indices[quad * 6 + 1] = base + 1;
+                indices[quad * 6 + 2] = base + 2;
+                indices[quad * 6 + 3] = base + 2;
+                indices[quad * 6 + 4] = base + 1;
+                indices[quad * 6 + 5] = base + 3;
+            }
+
+            VertexArray::Unbind();
+            mQuadIndices = make_shared<IndexBuffer>();
+            mQuadIndices->SetIndices(indices.data(), indices.size(), BufferUsage::Static);
+        }
+
+        const u32 startX = chunkX * kChunkSize;
+        const u32 startY = chunkY * kChunkSize;
+        const u32 endX   = std::min(startX + kChunkSize, mWidth);
+        const u32 endY   = std::min(startY + kChunkSize, mHeight);
+
+        const Vec2 cellUV = {1.0f / CAST<f32>(tilesetColumns), 1.0f / CAST<f32>(tilesetRows)};
+
+        vector<SpriteVertex> vertices;
+        vertices.reserve(CAST<size_t>(endX - startX) * (endY - startY) * 4);
+
+        for (u32 y = startY; y < endY; ++y) {
+            for (u32 x = startX; x < endX; ++x) {
+                const u16 tile = mTiles[CAST<size_t>(y) * mWidth + x];
+                if (tile == 0) continue;
+
+                const u32 cell   = tile - 1u;
+                const u32 column = cell % tilesetColumns;
+                const u32 row    = cell / tilesetColumns;
+
+                // Textures are flipped on load, so the first tileset row sits at the top of UV space
+                const f32 u0 = CAST<f32>(column) * cellUV.x;
+                const f32 u1 = u0 + cellUV.x;
+                const f32 v1 = 1.0f - CAST<f32>(row) * cellUV.y;
+                const f32 v0 = v1 - cellUV.y;
+
+                const f32 x0 = CAST<f32>(x) * tileSize.x;
+                const f32 y0 = CAST<f32>(y) * tileSize.y;
+                const f32 x1 = x0 + tileSize.x;
+                const f32 y1 = y0 + tileSize.y;
+
+                vertices.push_back({x0, y0, u0, v0});
+                vertices.push_back({x1, y0, u1, v0});
+                vertices.push_back({x0, y1, u0, v1});
+                vertices.push_back({x1, y1, u1, v1});
+            }
+        }
+
+        chunk.indexCount = CAST<u32>(vertices.size() / 4 * 6);
+        if (vertices.empty()) return;
+
+        if (!chunk.vertexArray) {
+            chunk.vertexBuffer = make_shared<VertexBuffer>();
+            chunk.vertexBuffer->SetData(vertices.data(), vertices.size() * sizeof(SpriteVertex), BufferUsage::Static);
+
+            VertexLayout layout;
+            layout.AddAttribute(VertexAttribute("aVertex", AttributeType::Float4));
+
+            chunk.vertexArray = make_shared<VertexArray>();
+            chunk.vertexArray->AddVertexBuffer(chunk.vertexBuffer, layout);
+            chunk.vertexArray->SetIndexBuffer(mQuadIndices);
+        } else {
+            chunk.vertexArray->Bind();
+            chunk.vertexBuffer->SetData(vertices.data(), vertices.size() * sizeof(SpriteVertex), BufferUsage::Static);
+        }
+
+        VertexArray::Unbind();
+    }
+}  // namespace Astera
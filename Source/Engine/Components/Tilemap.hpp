@@ -0,0 +1,131 @@
+/*
+ *  Filename: Tilemap.hpp
+ *  This code is part of the Astera core library
+ *  Copyright 2025 Jake Rieger
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include "EngineCommon.hpp"
+#include "ResourceManager.hpp"
+#include "Texture.hpp"
+#include "Rendering/VertexArray.hpp"
+
+namespace Astera {
+    /// @brief GPU resources for a square block of tiles. Vertex data is static and only re-uploaded when a tile
+    /// inside the chunk changes.
+    struct TilemapChunk {
+        shared_ptr<VertexArray> vertexArray;
+        shared_ptr<VertexBuffer> vertexBuffer;
+        u32 indexCount {0};
+        bool dirty {true};
+    };
+
+    /// @brief Dense grid of tile indices rendered from a single tileset texture
+    ///
+    /// Tiles are stored row-major with (0, 0) at the bottom-left of the map. A tile value of 0 is empty, any other
+    /// value N samples cell N - 1 of the tileset (cells are counted left-to-right, top-to-bottom). The map is split
+    /// into chunks of kChunkSize x kChunkSize tiles, each with its own static vertex buffer, so editing a tile only
+    /// rebuilds the chunk that contains it.
+    struct Tilemap {
+        static constexpr u32 kChunkSize = 32;
+
+        /// @brief Tileset texture all tiles sample from
+        ResourceHandle<TextureSprite> tileset;
+
+        /// @brief Number of tile columns in the tileset texture
+        u32 tilesetColumns {1};
+
+        /// @brief Number of tile rows in the tileset texture
+        u32 tilesetRows {1};
+
+        /// @brief Size of a single tile in world units
+        Vec2 tileSize {32.0f, 32.0f};
+
+        /// @brief Draw layer, lower layers are drawn first. Sprites are drawn on layer 0.
+        i16 layer {-1};
+
+        /// @brief Resizes the map and clears every tile
+        /// @param width Width in tiles
+        /// @param height Height in tiles
+        void Resize(u32 width, u32 height);
+
+        /// @brief Loads tiles from comma-separated rows. The first row is the top of the map.
+        /// @param csv CSV tile data, one map row per line
+        void LoadCSV(std::string_view csv);
+
+        /// @brief Sets a single tile and marks its chunk for rebuild
+        void SetTile(u32 x, u32 y, u16 tile);
+
+        ASTERA_KEEP u16 GetTile(u32 x, u32 y) const;
+
+        ASTERA_KEEP u32 GetWidth() const {
+            return mWidth;
+        }
+
+        ASTERA_KEEP u32 GetHeight() const {
+            return mHeight;
+        }
+
+        ASTERA_KEEP u32 GetChunksX() const {
+            return mChunksX;
+        }
+
+        ASTERA_KEEP u32 GetChunksY() const {
+            return mChunksY;
+        }
+
+        ASTERA_KEEP const TilemapChunk& GetChunk(u32 chunkX, u32 chunkY) const {
+            return mChunks[chunkY * mChunksX + chunkX];
+        }
+
+        /// @brief Re-uploads vertex data for every chunk that has been modified since the last call
+        void RebuildDirtyChunks();
+
+        /// @brief Computes the inclusive range of chunks overlapping a world-space rectangle
+        /// @param model Model matrix of the tilemap entity
+        /// @param worldMin Bottom-left corner of the visible rectangle
+        /// @param worldMax Top-right corner of the visible rectangle
+        /// @return False if no chunk is visible
+        bool GetVisibleChunks(const Mat4& model,
+                              const Vec2& worldMin,
+                              const Vec2& worldMax,
+                              u32& outMinX,
+                              u32& outMinY,
+                              u32& outMaxX,
+                              u32& outMaxY) const;
+
+    private:
+        u32 mWidth {0};
+        u32 mHeight {0};
+        u32 mChunksX {0};
+        u32 mChunksY {0};
+        vector<u16> mTiles;
+        vector<TilemapChunk> mChunks;
+        shared_ptr<IndexBuffer> mQuadIndices;  ///< Shared by all chunks, sized for a full chunk
+
+        void RebuildChunk(u32 chunkX, u32 chunkY);
+    };
+}  // namespace Astera
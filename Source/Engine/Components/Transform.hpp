@@ -48,12 +48,22 @@ namespace Astera {
             scale *= scaleFactor;
         }
 
+        /// @brief Builds the local matrix, translation * rotation * scale
         ASTERA_KEEP Mat4 GetMatrix() const {
-            auto mat = Mat4(1.0f);
-            mat      = glm::translate(mat, glm::vec3(position.x, position.y, 0.0f));
-            mat = glm::rotate(mat, glm::radians(rotation.x), glm::vec3(0.0f, 0.0f, 1.0f));  // Z-axis rotation for 2D
-            mat = glm::scale(mat, glm::vec3(scale.x, scale.y, 1.0f));
+            const f32 angle = glm::radians(rotation.x);  // Z-axis rotation for 2D
+            const f32 c     = glm::cos(angle);
+            const f32 s     = glm::sin(angle);
+
+            auto mat  = Mat4(1.0f);
+            mat[0][0] = c * scale.x;
+            mat[0][1] = s * scale.x;
+            mat[1][0] = -s * scale.y;
+            mat[1][1] = c * scale.y;
+            mat[3][0] = position.x;
+            mat[3][1] = position.y;
             return mat;
         }
+
+        bool operator==(const Transform& other) const = default;
     };
 }  // namespace Astera
@@ -36,16 +36,15 @@
 #include "Components/SoundSource.hpp"
 
 namespace Astera {
-    EntityBuilder& EntityBuilder::SetTransform(const TransformDescriptor& descriptor) {
-        auto& state        = mScene->GetState();
-        auto& transform    = state.GetTransform(mEntity);
+    Transform EntityBuilder::MakeTransform(const TransformDescriptor& descriptor) {
+        Transform transform;
         transform.position = descriptor.position;
         transform.rotation = descriptor.rotation;
         transform.scale    = descriptor.scale;
-        return *this;
+        return transform;
     }
 
-    EntityBuilder& EntityBuilder::AddBehavior(const BehaviorDescriptor& descriptor, ScriptEngine& scriptEngine) {
+    Behavior EntityBuilder::MakeBehavior(const BehaviorDescriptor& descriptor, ScriptEngine& scriptEngine) {
         // Load script
         const auto scriptSource = AssetManager::GetAssetText(descriptor.script);
         if (!scriptSource.has_value()) {
@@ -53,19 +52,12 @@ namespace Astera {
         }
         scriptEngine.LoadScript(*scriptSource, descriptor.script);
 
-        // TODO: Compile to, load from, and cache Lua byyecode
-
-        // Update entity
-        auto& state     = mScene->GetState();
-        auto& behavior  = state.AddComponent<Behavior>(mEntity);
-        behavior.script = descriptor.script;
-
-        return *this;
+        return Behavior {descriptor.script};
     }
 
-    EntityBuilder& EntityBuilder::AddSpriteRenderer(const SpriteRendererDescriptor& descriptor) {
+    SpriteRenderer EntityBuilder::MakeSpriteRenderer(Scene* scene, const SpriteRendererDescriptor& descriptor) {
         // Load texture
-        auto& resourceManager = mScene->GetResourceManager();
+        auto& resourceManager = scene->GetResourceManager();
         const auto loadResult = resourceManager.LoadResource<TextureSprite>(descriptor.texture);
         if (!loadResult) {
             throw std::runtime_error("Could not load texture sprite");
@@ -77,19 +69,107 @@ namespace Astera {
             throw std::runtime_error("Could not load texture sprite - handle invalid");
         }
 
-        // Update entity
-        auto& sprite    = mScene->GetState().AddComponent<SpriteRenderer>(mEntity);
+        SpriteRenderer sprite;
         sprite.geometry = Geometry::CreateQuad();
         sprite.sprite   = spriteHandle;
+        return sprite;
+    }
+
+    Rigidbody2D EntityBuilder::MakeRigidbody2D(const Rigidbody2DDescriptor& descriptor) {
+        Rigidbody2D rigidbody;
+
+        if (descriptor.type == "Static") {
+            rigidbody.type = BodyType::Static;
+        } else if (descriptor.type == "Kinematic") {
+            rigidbody.type = BodyType::Kinematic;
+        } else if (descriptor.type == "Dynamic") {
+            rigidbody.type = BodyType::Dynamic;
+        } else {
+            throw std::runtime_error(fmt::format("Unknown rigidbody type: '{}'", descriptor.type));
+        }
+
+        rigidbody.velocity            = descriptor.velocity;
+        rigidbody.acceleration        = descriptor.acceleration;
+        rigidbody.force               = descriptor.force;
+        rigidbody.angularVelocity     = descriptor.angularVelocity;
+        rigidbody.angularAcceleration = descriptor.angularAcceleration;
+        rigidbody.torque              = descriptor.torque;
+        rigidbody.restitution         = descriptor.restitution;
+        rigidbody.friction            = descriptor.friction;
+        rigidbody.linearDamping       = descriptor.linearDamping;
+        rigidbody.angularDamping      = descriptor.angularDamping;
+        rigidbody.gravityScale        = descriptor.gravityScale;
+        rigidbody.lockRotation        = descriptor.lockRotation;
+        rigidbody.allowSleep          = descriptor.allowSleep;
+        rigidbody.bullet              = descriptor.bullet;
+
+        // Inverse mass and inertia are always derived rather than trusted from the descriptor
+        rigidbody.UpdateMass(descriptor.mass);
+
+        return rigidbody;
+    }
+
+    Collider2D EntityBuilder::MakeCollider2D(const Collider2DDescriptor& descriptor) {
+        Collider2D collider;
+
+        if (descriptor.shape == "AABB") {
+            collider.shape = ColliderShape::AABB;
+        } else if (descriptor.shape == "Circle") {
+            collider.shape = ColliderShape::Circle;
+        } else if (descriptor.shape == "OBB") {
+            collider.shape = ColliderShape::OBB;
+        } else {
+            throw std::runtime_error(fmt::format("Unknown collider shape: '{}'", descriptor.shape));
+        }
+
+        collider.size      = descriptor.size;
+        collider.radius    = descriptor.radius;
+        collider.offset    = descriptor.offset;
+        collider.isTrigger = descriptor.isTrigger;
+
+        return collider;
+    }
+
+    SoundSource EntityBuilder::MakeSoundSource(Scene* scene, const SoundSourceDescriptor& descriptor) {
+        auto& resMgr      = scene->GetResourceManager();
+        const auto result = resMgr.LoadResource<Sound>(descriptor.sound);
+        if (!result) {
+            throw std::runtime_error("Could not load sound");
+        }
+
+        const ResourceHandle<Sound> soundHandle = resMgr.FetchResource<Sound>(descriptor.sound);
+        if (!soundHandle.IsValid()) {
+            throw std::runtime_error("Could not load sound. Resource handle invalid.");
+        }
+
+        SoundSource sound;
+        sound.sound  = soundHandle;
+        sound.volume = descriptor.volume;
+        return sound;
+    }
+
+    EntityBuilder& EntityBuilder::SetTransform(const TransformDescriptor& descriptor) {
+        mScene->GetState().GetTransform(mEntity) = MakeTransform(descriptor);
+        return *this;
+    }
 
+    EntityBuilder& EntityBuilder::AddBehavior(const BehaviorDescriptor& descriptor, ScriptEngine& scriptEngine) {
+        mScene->GetState().AddComponent<Behavior>(mEntity, MakeBehavior(descriptor, scriptEngine));
+        return *this;
+    }
+
+    EntityBuilder& EntityBuilder::AddSpriteRenderer(const SpriteRendererDescriptor& descriptor) {
+        mScene->GetState().AddComponent<SpriteRenderer>(mEntity, MakeSpriteRenderer(mScene, descriptor));
         return *this;
     }
 
     EntityBuilder& EntityBuilder::AddRigidbody2D(const Rigidbody2DDescriptor& descriptor) {
+        mScene->GetState().AddComponent<Rigidbody2D>(mEntity, MakeRigidbody2D(descriptor));
         return *this;
     }
 
     EntityBuilder& EntityBuilder::AddCollider2D(const Collider2DDescriptor& descriptor) {
+        mScene->GetState().AddComponent<Collider2D>(mEntity, MakeCollider2D(descriptor));
         return *this;
     }
 
@@ -98,20 +178,38 @@ namespace Astera {
     }
 
     EntityBuilder& EntityBuilder::AddSoundSource(const SoundSourceDescriptor& descriptor) {
-        auto& resMgr      = mScene->GetResourceManager();
-        const auto result = resMgr.LoadResource<Sound>(descriptor.sound);
-        if (!result) {
-            throw std::runtime_error("Could not load sound");
+        mScene->GetState().AddComponent<SoundSource>(mEntity, MakeSoundSource(mScene, descriptor));
+        return *this;
+    }
+
+    EntityBuilder& EntityBuilder::AddTilemap(const TilemapDescriptor& descriptor) {
+        auto& resourceManager = mScene->GetResourceManager();
+        if (!resourceManager.LoadResource<TextureSprite>(descriptor.tileset)) {
+            throw std::runtime_error("Could not load tileset texture");
         }
 
-        const ResourceHandle<Sound> soundHandle = resMgr.FetchResource<Sound>(descriptor.sound);
-        if (!soundHandle.IsValid()) {
-            throw std::runtime_error("Could not load sound. Resource handle invalid.");
+        const ResourceHandle<TextureSprite> tilesetHandle =
+          resourceManager.FetchResource<TextureSprite>(descriptor.tileset);
+        if (!tilesetHandle.IsValid()) {
+            throw std::runtime_error("Could not load tileset texture - handle invalid");
         }
 
-        auto& sound  = mScene->GetState().AddComponent<SoundSource>(mEntity);
-        sound.sound  = soundHandle;
-        sound.volume = descriptor.volume;
+        auto& tilemap          = mScene->GetState().AddComponent<Tilemap>(mEntity);
+        tilemap.tileset        = tilesetHandle;
+        tilemap.tilesetColumns = std::max(descriptor.tilesetColumns, 1u);
+        tilemap.tilesetRows    = std::max(descriptor.tilesetRows, 1u);
+        tilemap.tileSize       = descriptor.tileSize;
+        tilemap.layer          = descriptor.layer;
+
+        if (descriptor.source != kInvalidAssetID) {
+            const auto tileData = AssetManager::GetAssetText(descriptor.source);
+            if (!tileData.has_value()) {
+                throw std::runtime_error("Could not load tilemap data");
+            }
+            tilemap.LoadCSV(*tileData);
+        } else {
+            tilemap.LoadCSV(descriptor.data);
+        }
 
         return *this;
     }
@@ -64,6 +64,15 @@ namespace Astera {
             return mEntity;
         }
 
+        /// @brief Builds components from their descriptors without attaching them, loading any resource or script they
+        /// refer to. Used by the Add methods and to resolve prefabs once up front.
+        static Transform MakeTransform(const TransformDescriptor& descriptor);
+        static Behavior MakeBehavior(const BehaviorDescriptor& descriptor, class ScriptEngine& scriptEngine);
+        static SpriteRenderer MakeSpriteRenderer(Scene* scene, const SpriteRendererDescriptor& descriptor);
+        static Rigidbody2D MakeRigidbody2D(const Rigidbody2DDescriptor& descriptor);
+        static Collider2D MakeCollider2D(const Collider2DDescriptor& descriptor);
+        static SoundSource MakeSoundSource(Scene* scene, const SoundSourceDescriptor& descriptor);
+
         EntityBuilder& SetTransform(const TransformDescriptor& descriptor);
         EntityBuilder& AddBehavior(const BehaviorDescriptor& descriptor, class ScriptEngine& scriptEngine);
         EntityBuilder& AddSpriteRenderer(const SpriteRendererDescriptor& descriptor);
@@ -71,5 +80,6 @@ namespace Astera {
         EntityBuilder& AddCollider2D(const Collider2DDescriptor& descriptor);
         EntityBuilder& AddCamera(const CameraDescriptor& descriptor);
         EntityBuilder& AddSoundSource(const SoundSourceDescriptor& descriptor);
+        EntityBuilder& AddTilemap(const TilemapDescriptor& descriptor);
     };
 }  // namespace Astera
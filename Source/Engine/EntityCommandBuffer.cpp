@@ -0,0 +1,144 @@
+/*
+ *  Filename: EntityCommandBuffer.cpp
+ *  This code is part of the Astera core library
+ *  Copyright 2025 Jake Rieger
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "EntityCommandBuffer.hpp"
+#include "JobSystem.hpp"
+
+namespace Astera {
+    EntityCommandBuffer::PendingEntity EntityCommandBuffer::CreateEntity(NameID name) {
+        ASTERA_ASSERT(!name.IsNone());
+        const u32 slot = CurrentThreadSlot();
+        auto& thread   = GetThreadBuffer(slot);
+
+        thread.createNames.push_back(name);
+        return {slot, CAST<u32>(thread.createNames.size() - 1)};
+    }
+
+    void EntityCommandBuffer::Instantiate(const Prefab& prefab, u32 count, std::span<const Transform> transforms) {
+        ASTERA_ASSERT(transforms.empty() || transforms.size() == count);
+        if (count == 0) return;
+
+        auto& thread = GetThreadBuffer(CurrentThreadSlot());
+        if (transforms.empty()) {
+            thread.instances.push_back({&prefab, count, UINT32_MAX});
+            return;
+        }
+
+        thread.instances.push_back({&prefab, count, CAST<u32>(thread.instanceTransforms.size())});
+        thread.instanceTransforms.insert(thread.instanceTransforms.end(), transforms.begin(), transforms.end());
+    }
+
+    void EntityCommandBuffer::DestroyEntity(Entity entity) {
+        GetThreadBuffer(CurrentThreadSlot()).destroys.push_back(entity);
+    }
+
+    void EntityCommandBuffer::Playback(SceneState& state) {
+        for (auto& thread : mThreads) {
+            if (!thread) continue;
+
+            thread->created.resize(thread->createNames.size());
+            if (!thread->createNames.empty()) { state.CreateEntities(thread->createNames, thread->created); }
+
+            for (const auto& [prefab, count, firstTransform] : thread->instances) {
+                const auto transforms = firstTransform == UINT32_MAX
+                                          ? std::span<const Transform> {}
+                                          : std::span(thread->instanceTransforms).subspan(firstTransform, count);
+                state.Instantiate(*prefab, count, transforms);
+            }
+            thread->instances.clear();
+            thread->instanceTransforms.clear();
+        }
+
+        for (auto& thread : mThreads) {
+            if (!thread) continue;
+            for (auto& [type, queue] : thread->components) {
+                queue->PlaybackAdds(state, *this);
+            }
+        }
+
+        mDestroys.clear();
+        for (auto& thread : mThreads) {
+            if (!thread) continue;
+            for (auto& [type, queue] : thread->components) {
+                queue->PlaybackRemoves(state);
+                queue->Clear();
+            }
+
+            mDestroys.insert(mDestroys.end(), thread->destroys.begin(), thread->destroys.end());
+            thread->destroys.clear();
+            thread->createNames.clear();
+        }
+
+        if (!mDestroys.empty()) { state.DestroyEntities(mDestroys); }
+    }
+
+    void EntityCommandBuffer::Clear() {
+        for (auto& thread : mThreads) {
+            if (!thread) continue;
+            for (auto& [type, queue] : thread->components) {
+                queue->Clear();
+            }
+
+            thread->createNames.clear();
+            thread->created.clear();
+            thread->instances.clear();
+            thread->instanceTransforms.clear();
+            thread->destroys.clear();
+        }
+    }
+
+    Entity EntityCommandBuffer::GetCreatedEntity(PendingEntity entity) const {
+        const auto& thread = mThreads[entity.thread];
+        ASTERA_ASSERT(thread && entity.index < thread->created.size());
+        return thread->created[entity.index];
+    }
+
+    bool EntityCommandBuffer::IsEmpty() const {
+        return std::ranges::all_of(mThreads, [](const auto& thread) {
+            return !thread || (thread->createNames.empty() && thread->instances.empty() && thread->destroys.empty() &&
+                               std::ranges::all_of(thread->components, [](const auto& entry) {
+                                   return entry.second->IsEmpty();
+                               }));
+        });
+    }
+
+    u32 EntityCommandBuffer::CurrentThreadSlot() {
+        // Looking the worker index up takes a lock, so each thread only asks once. Threads never become workers after
+        // starting, so a cached -1 stays right.
+        static thread_local const i32 tWorkerID = gJobSystem ? gJobSystem->GetCurrentWorkerID() : -1;
+        ASTERA_ASSERT(tWorkerID < CAST<i32>(kMaxThreads) - 1);
+        return tWorkerID >= 0 ? CAST<u32>(tWorkerID) : kMaxThreads - 1;
+    }
+
+    EntityCommandBuffer::ThreadBuffer& EntityCommandBuffer::GetThreadBuffer(u32 slot) {
+        // Only the owning thread touches its slot while recording
+        auto& thread = mThreads[slot];
+        if (!thread) { thread = make_unique<ThreadBuffer>(); }
+        return *thread;
+    }
+}  // namespace Astera
@@ -0,0 +1,224 @@
+/*
+ *  Filename: EntityCommandBuffer.hpp
+ *  This code is part of the Astera core library
+ *  Copyright 2025 Jake Rieger
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include "EngineCommon.hpp"
+#include "SceneState.hpp"
+
+namespace Astera {
+    /// @brief Records structural changes to a scene and applies them later in one go
+    ///
+    /// Creating or destroying entities, or adding and removing components, invalidates views that are being iterated.
+    /// Record those changes here instead, from the main thread or any job system worker, and call Playback at a point
+    /// where nothing is iterating. Every thread records into its own buffer, so recording never locks.
+    ///
+    /// Playback applies every create first, then component adds, then removes, and destroys last, regardless of the
+    /// order they were recorded in. This lets each step run as one bulk registry operation.
+    class EntityCommandBuffer {
+    public:
+        /// @brief Entity created by this buffer, resolved to a real entity by Playback
+        struct PendingEntity {
+            u32 thread {0};
+            u32 index {0};
+        };
+
+        EntityCommandBuffer() = default;
+
+        ASTERA_CLASS_PREVENT_MOVES_COPIES(EntityCommandBuffer)
+
+        /// @brief Records creating an entity with a default Transform
+        /// @param name Entity name, intern it on the main thread beforehand since NameID isn't thread-safe
+        /// @returns Handle that other commands in this buffer can target
+        PendingEntity CreateEntity(NameID name);
+
+        /// @brief Records spawning copies of a prefab, see SceneState::Instantiate
+        /// @param prefab Prefab to copy, must stay registered until Playback
+        /// @param count Number of instances
+        /// @param transforms Transform of each instance, or empty to give every instance the prefab's
+        void Instantiate(const Prefab& prefab, u32 count, std::span<const Transform> transforms = {});
+
+        /// @brief Records destroying an entity and its descendants, entities that are already gone are skipped
+        void DestroyEntity(Entity entity);
+
+        /// @brief Records attaching a component to an existing entity, replacing it if already attached
+        template<typename Component>
+            requires ValidComponent<Component> && (!std::is_same_v<Component, WorldTransform>)
+        void AddComponent(Entity entity, Component component) {
+            auto& queue = GetQueue<Component>();
+            queue.existing.push_back(entity);
+            queue.existingValues.push_back(std::move(component));
+        }
+
+        /// @brief Records attaching a component to an entity created by this buffer. Attaching the same component type
+        /// to one pending entity twice is not allowed, except Transform which replaces the default one.
+        template<typename Component>
+            requires ValidComponent<Component> && (!std::is_same_v<Component, WorldTransform>)
+        void AddComponent(PendingEntity entity, Component component) {
+            auto& queue = GetQueue<Component>();
+            queue.pending.push_back(entity);
+            queue.pendingValues.push_back(std::move(component));
+        }
+
+        /// @brief Records detaching a component, entities without it are skipped
+        template<typename Component>
+            requires ValidComponent<Component> && (!std::is_same_v<Component, Transform>) &&
+                     (!std::is_same_v<Component, WorldTransform>)
+        void RemoveComponent(Entity entity) {
+            GetQueue<Component>().removes.push_back(entity);
+        }
+
+        /// @brief Applies and clears every recorded command. Call on the main thread while nothing is recording.
+        void Playback(SceneState& state);
+
+        /// @brief Drops every recorded command without applying it
+        void Clear();
+
+        /// @brief Gets the entity a create command made
+        /// @returns The entity, valid from the Playback that ran the command until the next Playback
+        ASTERA_KEEP Entity GetCreatedEntity(PendingEntity entity) const;
+
+        /// @brief Checks whether any command has been recorded since the last Playback
+        ASTERA_KEEP bool IsEmpty() const;
+
+    private:
+        /// @brief Workers use their own index, every other thread shares the last buffer
+        static constexpr u32 kMaxThreads = 64;
+
+        class ComponentQueueBase {
+        public:
+            virtual ~ComponentQueueBase() = default;
+
+            virtual void PlaybackAdds(SceneState& state, const EntityCommandBuffer& buffer) = 0;
+            virtual void PlaybackRemoves(SceneState& state) = 0;
+            virtual bool IsEmpty() const = 0;
+            virtual void Clear() = 0;
+        };
+
+        template<typename Component>
+        class ComponentQueue;
+
+        struct PendingInstances {
+            const Prefab* prefab;
+            u32 count;
+            u32 firstTransform;  ///< Into ThreadBuffer::instanceTransforms, or UINT32_MAX for the prefab's own
+        };
+
+        struct ThreadBuffer {
+            vector<NameID> createNames;
+            vector<Entity> created;  ///< Result of the last Playback, indexed like createNames
+            vector<PendingInstances> instances;
+            vector<Transform> instanceTransforms;
+            vector<Entity> destroys;
+            vector<std::pair<entt::id_type, unique_ptr<ComponentQueueBase>>> components;
+        };
+
+        std::array<unique_ptr<ThreadBuffer>, kMaxThreads> mThreads {};
+        vector<Entity> mDestroys;
+
+        static u32 CurrentThreadSlot();
+        ThreadBuffer& GetThreadBuffer(u32 slot);
+
+        template<typename Component>
+        ComponentQueue<Component>& GetQueue();
+    };
+
+    template<typename Component>
+    class EntityCommandBuffer::ComponentQueue final : public ComponentQueueBase {
+    public:
+        vector<PendingEntity> pending;
+        vector<Component> pendingValues;
+        vector<Entity> existing;
+        vector<Component> existingValues;
+        vector<Entity> removes;
+
+        void PlaybackAdds(SceneState& state, const EntityCommandBuffer& buffer) override {
+            if (!pending.empty()) {
+                mResolved.clear();
+                mResolved.reserve(pending.size());
+                for (const auto& entity : pending) {
+                    mResolved.push_back(buffer.GetCreatedEntity(entity));
+                }
+
+                // Every new entity already has a Transform, the rest can't have the component yet and go in bulk
+                if constexpr (std::is_same_v<Component, Transform>) {
+                    for (size_t i = 0; i < mResolved.size(); ++i) {
+                        state.GetTransform(mResolved[i]) = std::move(pendingValues[i]);
+                    }
+                } else {
+                    state.InsertComponents<Component>(mResolved, pendingValues);
+                }
+            }
+
+            for (size_t i = 0; i < existing.size(); ++i) {
+                if (!state.IsValid(existing[i])) continue;
+
+                if (auto* component = state.TryGetComponent<Component>(existing[i])) {
+                    *component = std::move(existingValues[i]);
+                } else {
+                    state.AddComponent<Component>(existing[i], std::move(existingValues[i]));
+                }
+            }
+        }
+
+        void PlaybackRemoves(SceneState& state) override {
+            if constexpr (!std::is_same_v<Component, Transform>) {
+                std::erase_if(removes, [&](Entity entity) { return !state.IsValid(entity); });
+                state.RemoveComponents<Component>(removes);
+            }
+        }
+
+        bool IsEmpty() const override {
+            return pending.empty() && existing.empty() && removes.empty();
+        }
+
+        void Clear() override {
+            pending.clear();
+            pendingValues.clear();
+            existing.clear();
+            existingValues.clear();
+            removes.clear();
+        }
+
+    private:
+        vector<Entity> mResolved;
+    };
+
+    template<typename Component>
+    EntityCommandBuffer::ComponentQueue<Component>& EntityCommandBuffer::GetQueue() {
+        auto& thread    = GetThreadBuffer(CurrentThreadSlot());
+        const auto type = entt::type_hash<Component>::value();
+
+        for (auto& [id, queue] : thread.components) {
+            if (id == type) return static_cast<ComponentQueue<Component>&>(*queue);
+        }
+
+        auto& queue = thread.components.emplace_back(type, make_unique<ComponentQueue<Component>>()).second;
+        return static_cast<ComponentQueue<Component>&>(*queue);
+    }
+}  // namespace Astera
@@ -0,0 +1,82 @@
+/*
+ *  Filename: EntityPool.cpp
+ *  This code is part of the Astera core library
+ *  Copyright 2025 Jake Rieger
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "EntityPool.hpp"
+
+#include <algorithm>
+
+namespace Astera {
+    EntityPool::EntityPool(SceneState& state, const Prefab& prefab, u32 capacity)
+        : mState(state), mPrefab(prefab), mCapacity(capacity) {
+        mMembers.resize(capacity);
+        mState.Instantiate(mPrefab, capacity, {}, mMembers);
+        for (const auto entity : mMembers) {
+            mState.SetActive(entity, false);
+        }
+
+        mFree = mMembers;
+        std::ranges::sort(mMembers);
+    }
+
+    Entity EntityPool::Acquire() {
+        if (mFree.empty()) {
+            ++mMisses;
+            return entt::null;
+        }
+
+        const Entity entity = mFree.back();
+        mFree.pop_back();
+
+        mState.GetTransform(entity) = mPrefab.transform;
+        ResetComponent(entity, mPrefab.spriteRenderer);
+        mState.ResetScriptInstance(entity);  // Copying the prototype over would leak the entity's instance table
+        ResetComponent(entity, mPrefab.behavior);
+        ResetComponent(entity, mPrefab.rigidbody2D);
+        ResetComponent(entity, mPrefab.collider2D);
+        ResetComponent(entity, mPrefab.soundSource);
+        mState.SetActive(entity, true);
+
+        mPeakActive = std::max(mPeakActive, mCapacity - CAST<u32>(mFree.size()));
+        return entity;
+    }
+
+    bool EntityPool::Release(Entity entity) {
+        if (!std::ranges::binary_search(mMembers, entity)) return false;
+        ASTERA_ASSERT(mState.IsValid(entity));
+
+        if (mState.IsActive(entity)) {
+            mState.SetActive(entity, false);
+            mFree.push_back(entity);
+        }
+        return true;
+    }
+
+    EntityPoolStats EntityPool::GetStats() const {
+        return {mPrefab.name, mCapacity, mCapacity - CAST<u32>(mFree.size()), mPeakActive, mMisses};
+    }
+}  // namespace Astera
@@ -0,0 +1,84 @@
+/*
+ *  Filename: EntityPool.hpp
+ *  This code is part of the Astera core library
+ *  Copyright 2025 Jake Rieger
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include "EngineCommon.hpp"
+#include "SceneState.hpp"
+
+namespace Astera {
+    /// @brief Occupancy of an EntityPool, for the debug overlay
+    struct EntityPoolStats {
+        NameID prefab;
+        u32 capacity {0};
+        u32 active {0};
+        u32 peakActive {0};
+        u32 misses {0};  ///< Acquire calls that found the pool empty
+    };
+
+    /// @brief Fixed set of prefab instances that are deactivated and reused instead of destroyed
+    ///
+    /// Every instance is created up front and parked with the Inactive tag. Acquire and Release only move the tag and
+    /// copy the prefab's components back, so they never allocate and don't disturb views being iterated. Release
+    /// pooled entities instead of destroying them.
+    class EntityPool {
+    public:
+        /// @brief Creates the pool's instances. Don't call while the scene is being iterated.
+        /// @param state Scene the instances live in
+        /// @param prefab Prefab to copy, must stay registered for the pool's lifetime
+        /// @param capacity Number of instances
+        EntityPool(SceneState& state, const Prefab& prefab, u32 capacity);
+
+        ASTERA_CLASS_PREVENT_MOVES_COPIES(EntityPool)
+
+        /// @brief Activates a parked instance, with every component reset to the prefab's
+        /// @returns The instance, or entt::null if every instance is in use
+        Entity Acquire();
+
+        /// @brief Parks an instance acquired from this pool, releasing an inactive one does nothing
+        /// @returns False if the entity isn't one of this pool's instances
+        bool Release(Entity entity);
+
+        ASTERA_KEEP EntityPoolStats GetStats() const;
+
+    private:
+        SceneState& mState;
+        const Prefab& mPrefab;
+        vector<Entity> mMembers;  ///< Every instance, sorted
+        vector<Entity> mFree;     ///< Parked instances, the most recently released on top
+        u32 mCapacity {0};
+        u32 mPeakActive {0};
+        u32 mMisses {0};
+
+        /// @brief Copies a prototype over an instance's component
+        template<typename Component>
+        void ResetComponent(Entity entity, const optional<Component>& prototype) {
+            if (prototype) { mState.GetComponent<Component>(entity) = *prototype; }
+        }
+    };
+}  // namespace Astera
@@ -0,0 +1,109 @@
+/*
+ *  Filename: EventBus.hpp
+ *  This code is part of the Astera core library
+ *  Copyright 2025 Jake Rieger
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include "EngineCommon.hpp"
+#include "FrameAllocator.hpp"
+#include "NameID.hpp"
+
+namespace Astera {
+    /// @brief A message between scripts, sent with EventBus::Send and delivered on the next frame
+    struct ScriptEvent {
+        /// @brief Interned event name, like "Damage"
+        NameID type;
+        /// @brief Entity the event is sent to, or EventBus::kNoEntity
+        u32 target;
+        /// @brief Name of the entities the event is sent to, empty unless sent to a tag
+        NameID tag;
+        /// @brief Entity that sent the event, or EventBus::kNoEntity
+        u32 sender;
+        f32 value;
+    };
+
+    /// @brief Double-buffered queue of script events
+    ///
+    /// Events sent during a frame are stored in blocks taken from the frame allocator and become readable after the
+    /// next NextFrame, which keeps them in the allocator's previous buffer. Events sent while those are delivered go to
+    /// the following frame, so handlers that answer events can't loop within a frame. Events that don't fit in the
+    /// frame allocator are dropped.
+    class EventBus {
+    public:
+        /// @brief Stands in for a missing target or sender, the same bits as entt::null
+        static constexpr u32 kNoEntity = UINT32_MAX;
+        /// @brief Events allocated at a time
+        static constexpr u32 kEventsPerBlock = 1024;
+
+        explicit EventBus(FrameAllocator& allocator) : mAllocator(allocator) {}
+
+        ASTERA_CLASS_PREVENT_MOVES_COPIES(EventBus)
+
+        /// @brief Queues an event for the next frame
+        void Send(const ScriptEvent& event);
+
+        /// @brief Makes the events sent since the last call readable. Call once per frame, right after
+        /// FrameAllocator::NextFrame.
+        void NextFrame();
+
+        /// @brief Drops every event, e.g. when the entities they refer to are unloaded
+        void Clear();
+
+        /// @brief Calls a function with each readable event, in the order they were sent
+        template<typename Fn>
+        void ForEach(Fn&& fn) const {
+            for (const auto& block : mBlocks[mRead]) {
+                for (u32 i = 0; i < block.count; ++i) {
+                    fn(block.events[i]);
+                }
+            }
+        }
+
+        /// @brief Gets the number of readable events
+        ASTERA_KEEP u32 GetEventCount() const {
+            return mEventCount[mRead];
+        }
+
+        /// @brief Gets the number of events dropped since the last NextFrame because the frame allocator was full
+        ASTERA_KEEP u32 GetDroppedCount() const {
+            return mDropped;
+        }
+
+    private:
+        struct Block {
+            ScriptEvent* events;
+            u32 count;
+        };
+
+        FrameAllocator& mAllocator;
+        /// @brief Blocks of the frame being written and of the frame being read, the arrays keep their capacity
+        vector<Block> mBlocks[2];
+        u32 mEventCount[2] {0, 0};
+        u32 mRead {0};
+        u32 mDropped {0};
+    };
+}  // namespace Astera
@@ -0,0 +1,141 @@
+/*
+ *  Filename: FileWatcher.cpp
+ *  This code is part of the Astera core library
+ *  Copyright 2025 Jake Rieger
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "FileWatcher.hpp"
+#include "Log.hpp"
+
+#include <algorithm>
+
+#ifdef ASTERA_PLATFORM_LINUX
+    #include <sys/inotify.h>
+    #include <unistd.h>
+    #include <cerrno>
+    #include <cstring>
+#endif
+
+namespace Astera {
+    FileWatcher::FileWatcher() {
+#ifdef ASTERA_PLATFORM_LINUX
+        mInotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (mInotify < 0) { Log::Error("FileWatcher", "Failed to create inotify instance: {}", strerror(errno)); }
+#endif
+    }
+
+    FileWatcher::~FileWatcher() {
+#ifdef ASTERA_PLATFORM_LINUX
+        if (mInotify >= 0) { close(mInotify); }
+#endif
+    }
+
+    bool FileWatcher::Watch(const Path& filename) {
+        const string key = MakeKey(filename);
+        if (mFiles.contains(key)) return true;
+
+#ifdef ASTERA_PLATFORM_LINUX
+        if (mInotify < 0) return false;
+
+        // Watching the folder rather than the file keeps the watch alive when an editor replaces the file
+        const Path folder = Path(key).parent_path();
+        const i32 watch   = inotify_add_watch(mInotify, folder.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+        if (watch < 0) {
+            Log::Error("FileWatcher", "Failed to watch `{}`: {}", folder.string(), strerror(errno));
+            return false;
+        }
+        mFolders[watch] = folder;
+#else
+        std::error_code error;
+        mWriteTimes[key] = fs::last_write_time(filename, error);
+#endif
+
+        mFiles.emplace(key, filename);
+        return true;
+    }
+
+    void FileWatcher::Clear() {
+#ifdef ASTERA_PLATFORM_LINUX
+        for (const i32 watch : mFolders | std::views::keys) {
+            inotify_rm_watch(mInotify, watch);
+        }
+        mFolders.clear();
+#else
+        mWriteTimes.clear();
+#endif
+        mFiles.clear();
+    }
+
+    void FileWatcher::Poll(vector<Path>& outChanged) {
+        outChanged.clear();
+        if (mFiles.empty()) return;
+
+        // Editors often write a file several times per save, only report it once
+        const auto report = [&](const string& key) {
+            const auto it = mFiles.find(key);
+            if (it != mFiles.end() && std::ranges::find(outChanged, it->second) == outChanged.end()) {
+                outChanged.push_back(it->second);
+            }
+        };
+
+#ifdef ASTERA_PLATFORM_LINUX
+        if (mInotify < 0) return;
+
+        alignas(inotify_event) char buffer[4096];
+        for (;;) {
+            const ssize_t length = read(mInotify, buffer, sizeof(buffer));
+            if (length <= 0) break;
+
+            for (ssize_t offset = 0; offset < length;) {
+                const auto* event = RCAST<const inotify_event*>(buffer + offset);
+                offset += CAST<ssize_t>(sizeof(inotify_event) + event->len);
+
+                const auto folder = mFolders.find(event->wd);
+                if (event->len == 0 || folder == mFolders.end()) continue;
+                report((folder->second / event->name).string());
+            }
+        }
+#else
+        const auto now = std::chrono::steady_clock::now();
+        if (now - mLastPoll < kPollInterval) return;
+        mLastPoll = now;
+
+        std::error_code error;
+        for (auto& [key, writeTime] : mWriteTimes) {
+            const auto current = fs::last_write_time(key, error);
+            if (error || current == writeTime) continue;
+
+            writeTime = current;
+            report(key);
+        }
+#endif
+    }
+
+    string FileWatcher::MakeKey(const Path& filename) {
+        std::error_code error;
+        const Path absolute = fs::absolute(filename, error);
+        return (error ? filename : absolute).lexically_normal().string();
+    }
+}  // namespace Astera
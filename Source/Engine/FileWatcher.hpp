@@ -0,0 +1,82 @@
+/*
+ *  Filename: FileWatcher.hpp
+ *  This code is part of the Astera core library
+ *  Copyright 2025 Jake Rieger
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include "EngineCommon.hpp"
+
+#include <chrono>
+
+namespace Astera {
+    /// @brief Reports files that were written to, polled once per frame without blocking
+    ///
+    /// On Linux an inotify instance watches the folders of the watched files and Poll only drains its queue, so
+    /// watching hundreds of files costs nothing until one of them changes. Saves that replace the file through a rename,
+    /// like most editors do, are reported too. Elsewhere Poll compares modification times, at most every
+    /// kPollInterval.
+    class FileWatcher {
+    public:
+        /// @brief How often the modification time fallback checks the files
+        static constexpr auto kPollInterval = std::chrono::milliseconds(250);
+
+        FileWatcher();
+        ~FileWatcher();
+
+        ASTERA_CLASS_PREVENT_MOVES_COPIES(FileWatcher)
+
+        /// @brief Starts watching a file
+        /// @return False if the file's folder can't be watched
+        bool Watch(const Path& filename);
+
+        /// @brief Stops watching every file
+        void Clear();
+
+        /// @brief Collects the files written to since the last Poll, each one once
+        /// @param outChanged Receives the changed files as they were passed to Watch
+        void Poll(vector<Path>& outChanged);
+
+        ASTERA_KEEP size_t GetWatchedCount() const {
+            return mFiles.size();
+        }
+
+    private:
+        /// @brief Watched files by normalized absolute path
+        unordered_map<string, Path> mFiles;
+
+#ifdef ASTERA_PLATFORM_LINUX
+        i32 mInotify {-1};
+        /// @brief Folder of each inotify watch, several files in one folder share a watch
+        unordered_map<i32, Path> mFolders;
+#else
+        unordered_map<string, fs::file_time_type> mWriteTimes;
+        std::chrono::steady_clock::time_point mLastPoll;
+#endif
+
+        static string MakeKey(const Path& filename);
+    };
+}  // namespace Astera
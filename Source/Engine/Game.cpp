@@ -32,6 +32,7 @@
 #include "TextureManager.hpp"
 #include "ShaderManager.hpp"
 #include "ScriptTypeRegistry.hpp"
+#include "ScriptFFI.hpp"
 #include "Input.hpp"
 #include "Math.hpp"
 #include "AssetManager.hpp"
@@ -44,6 +45,24 @@
 namespace Astera {
     using Astera::Log;
 
+    /// @brief Reads the optional positions table of Instantiate
+    /// @return False if the table doesn't hold one position per instance
+    static bool ReadSpawnPositions(const sol::optional<sol::table>& positions, u32 count, vector<Vec2>& outPositions) {
+        outPositions.clear();
+        if (!positions) return true;
+
+        outPositions.reserve(positions->size());
+        for (size_t i = 1; i <= positions->size(); ++i) {
+            outPositions.push_back(positions->get<Vec2>(i));
+        }
+
+        if (outPositions.size() != count) {
+            Log::Warn("Scene", "Instantiate got {} positions for {} instances", outPositions.size(), count);
+            return false;
+        }
+        return true;
+    }
+
     Game::~Game() = default;
 
     void Game::Quit() {
@@ -71,7 +90,13 @@ namespace Astera {
             return false;
         }
 
+        // Queued events refer to entities of the scene that's going away
+        mPhysicsEngine.Reset();
+        mEventBus.Clear();
         mActiveScene->LoadDescriptor(mSceneCache[name], GetScriptEngine());
+
+        // Loading is the one place a full collection is fine, gameplay only runs budgeted steps
+        mScriptEngine.CollectGarbage();
         return true;
     }
 
@@ -118,11 +143,79 @@ namespace Astera {
         if (inputMap.Load(inputMapPath)) {
             mInputManager.SetInputMap(inputMap);
         }
+
+        // [Random] Seed = <u64> fixes every random stream, e.g. for replays and benchmarks
+        const auto enginePath = fs::current_path() / "Config" / "Engine.ini";
+        mINI::INIStructure engineIni;
+        if (exists(enginePath) && mINI::INIFile(enginePath.string()).read(engineIni) &&
+            engineIni["Random"].has("Seed")) {
+            const auto& value = engineIni["Random"]["Seed"];
+            u64 seed          = 0;
+            if (std::from_chars(value.data(), value.data() + value.size(), seed).ec == std::errc {}) {
+                Math::SetSeed(seed);
+            } else {
+                Log::Warn("Game", "Invalid random seed '{}' in Engine.ini", value);
+            }
+        }
+        Log::Debug("Game", "Random seed: {}", Math::GetSeed());
+
+        // [Scripts] GCBudget = <milliseconds> caps the time spent collecting Lua garbage each frame
+        if (engineIni["Scripts"].has("GCBudget")) {
+            const auto& value = engineIni["Scripts"]["GCBudget"];
+            f32 budget        = 0;
+            if (std::from_chars(value.data(), value.data() + value.size(), budget).ec == std::errc {} && budget > 0) {
+                mScriptEngine.SetGCBudget(budget);
+            } else {
+                Log::Warn("Game", "Invalid GC budget '{}' in Engine.ini", value);
+            }
+        }
+
+        // [Scripts] HotReload = true reloads behavior scripts as their files are saved, keeping the scene running
+        if (engineIni["Scripts"].has("HotReload")) {
+            const auto& value = engineIni["Scripts"]["HotReload"];
+            mScriptHotReload  = value == "true" || value == "1";
+        }
+    }
+
+    void Game::WatchScripts() {
+        mScriptWatcher = make_unique<FileWatcher>();
+        mWatchedScripts.clear();
+        for (const auto& [id, path] : AssetManager::sAssetPaths) {
+            if (AssetTypeFromID(id) != AssetType::Script) continue;
+            if (mScriptWatcher->Watch(path)) { mWatchedScripts[path.string()] = id; }
+        }
+        Log::Debug("Game", "Watching {} scripts for changes", mWatchedScripts.size());
+    }
+
+    void Game::ReloadChangedScripts() {
+        if (!mScriptWatcher || !mActiveScene) return;
+
+        mScriptWatcher->Poll(mChangedScripts);
+        for (const auto& path : mChangedScripts) {
+            const auto it = mWatchedScripts.find(path.string());
+            // Scripts no scene has used yet are read fresh when they're first loaded
+            if (it == mWatchedScripts.end() || !mScriptEngine.HasScript(it->second)) continue;
+
+            const auto source = AssetManager::GetAssetText(it->second);
+            if (!source.has_value()) {
+                Log::Error("Game", "Failed to read changed script: {}", source.error());
+                continue;
+            }
+            mActiveScene->ReloadScript(it->second, *source, mScriptEngine);
+        }
     }
 
     void Game::LoadDebugLayers(u32 width, u32 height) {
         mImGuiDebugLayer   = make_unique<ImGuiDebugLayer>(GetHandle());
         mPhysicsDebugLayer = make_unique<PhysicsDebugLayer>(width, height);
+
+        // Scripts are named by their asset file in the profiler, AssetManager is initialized by now
+        auto& profiler = mScriptEngine.GetProfiler();
+        profiler.SetNameResolver([](const u64 script) -> string {
+            const auto path = AssetManager::GetAssetPath(script);
+            return path ? path->filename().string() : string {};
+        });
+        mImGuiDebugLayer->SetScriptProfiler(&profiler);
     }
 
     void Game::OnAwake() {
@@ -164,18 +257,25 @@ namespace Astera {
             return;
         }
 
+        if (mScriptHotReload) { WatchScripts(); }
+
         // Debug layers
         LoadDebugLayers(width, height);
 
+        // Initialize job system
+        gJobSystem = make_unique<JobSystem>();
+        gJobSystem->Initialize();
+
+        // One lane per thread that takes part in a ParallelFor. The lanes have to exist before the entry scene loads
+        // its scripts, or isolated ones fall back to the main state.
+        mScriptEngine.EnableIsolatedScripts(CAST<u32>(GetParallelSlotCount()),
+                                            [this](sol::state& lua) { RegisterIsolatedLuaGlobals(lua); });
+
         // Create the initial scene
         mActiveScene = make_unique<Scene>(GetRenderContext());
 
         UpdateSceneCache();
 
-        // Initialize job system
-        gJobSystem = make_unique<JobSystem>();
-        gJobSystem->Initialize();
-
         LoadPlugins();
 
         Log::Debug("Game",
@@ -202,11 +302,27 @@ namespace Astera {
         LoadContent();
     }
 
+    void Game::OnFixedUpdate(f32 timeStep) {
+        if (!mActiveScene) return;
+
+        mActiveScene->FixedUpdate(timeStep, GetScriptEngine());
+        mPhysicsEngine.Step(mActiveScene->GetState(), timeStep);
+        mActiveScene->DispatchCollisionEvents(mPhysicsEngine.GetContactEvents(), GetScriptEngine());
+
+        mPhysicsFrameTime += mPhysicsEngine.GetStats().updateTime;
+    }
+
     void Game::OnUpdate(const Clock& clock) {
+        // The allocator advances once per frame, here, so the events the bus makes readable stay in its previous
+        // buffer until the next frame
+        mFrameAllocator.NextFrame();
+        mEventBus.NextFrame();
+
         // update debug ui
         mImGuiDebugLayer->UpdateFrameRate((f32)clock.GetFramesPerSecond());
         const auto fT = (1.f / clock.GetFramesPerSecond()) * 1000.f;
         mImGuiDebugLayer->UpdateFrameTime((f32)fT);
+        mImGuiDebugLayer->RecordFrameTime(clock.GetDeltaTime() * 1000.f);
         // silly hack, will calculate once threading is actually implemented
         mImGuiDebugLayer->UpdateMainThreadTime((f32)fT / 2.f);
         mImGuiDebugLayer->UpdateRenderThreadTime((f32)fT / 2.f);
@@ -217,8 +333,23 @@ namespace Astera {
         mImGuiDebugLayer->UpdateResourcePoolUsedBytes(resMgr.GetAllocator().GetUsedMemory());
 
         if (mActiveScene) {
+            ReloadChangedScripts();
+            mActiveScene->DispatchEvents(mEventBus, GetScriptEngine());
             mActiveScene->Update(clock, GetScriptEngine());
 
+            // Physics runs in OnFixedUpdate, report the last step and the time spent over the whole frame
+            const auto& physicsStats = mPhysicsEngine.GetStats();
+            mImGuiDebugLayer->UpdatePhysicsStats(physicsStats.bodies,
+                                                 physicsStats.awakeBodies,
+                                                 physicsStats.islands,
+                                                 physicsStats.contacts,
+                                                 GetFixedStepCount(),
+                                                 mPhysicsFrameTime);
+            mPhysicsFrameTime = 0.0f;
+            mImGuiDebugLayer->UpdateBroadphaseStats(physicsStats.candidatePairs, physicsStats.broadphaseMemory);
+            mImGuiDebugLayer->UpdateSystemTimings(mActiveScene->GetSystems().GetTimings());
+            mImGuiDebugLayer->UpdatePoolStats(mActiveScene->GetPoolStats());
+
             vector<Transform> transforms;
             const auto iter = mActiveScene->GetState().View<Transform>().each();
             for (auto [entity, transform] : iter) {
@@ -230,9 +361,6 @@ namespace Astera {
         for (const auto& plugin : mPlugins | std::views::values) {
             plugin->OnSceneUpdate(this);
         }
-
-        // Advance frame allocator
-        mFrameAllocator.NextFrame();
     }
 
     void Game::OnLateUpdate() {
@@ -246,6 +374,11 @@ namespace Astera {
         for (const auto& plugin : mPlugins | std::views::values) {
             plugin->OnSceneLateUpdate(this);
         }
+
+        // The frame has been presented and scripts are done with it, pay for their garbage here
+        mScriptEngine.StepGC();
+        mScriptEngine.GetProfiler().NextFrame();
+        mImGuiDebugLayer->UpdateScriptStats(mScriptEngine.GetGCStats(), mScriptEngine.GetAllocator());
     }
 
     void Game::OnDestroyed() {
@@ -286,7 +419,7 @@ namespace Astera {
         {
             // Submit drawing commands here
             if (mActiveScene) {
-                mActiveScene->Render(GetRenderContext());
+                mActiveScene->Render(GetRenderContext(), GetInterpolationAlpha());
             }
         }
         mMainRenderTarget->GetContext().EndFrame();
@@ -308,6 +441,7 @@ namespace Astera {
         mScriptEngine.Initialize();
         if (!mScriptEngine.IsInitialized())
             return false;
+        mScriptEngine.EnableScriptCache(fs::current_path() / "Cache" / "Scripts");
 
         // Register globals
         auto& lua                   = mScriptEngine.GetLuaState();
@@ -328,10 +462,121 @@ namespace Astera {
         Log::RegisterLuaGlobals(lua);
         Math::RegisterLuaGlobals(lua);
         Coordinates::RegisterLuaGlobals(lua);
+        ScriptFFI::RegisterLuaGlobals(lua);
         GetInputManager().RegisterLuaGlobals(lua);  // Use Window's InputManager
         mAudioEngine.RegisterLuaGlobals(lua);
+        mPhysicsEngine.RegisterLuaGlobals(lua);
         ScriptTypeRegistry::RegisterTypes(mScriptEngine);
 
+        // Spawns go through the active scene's command buffer, behaviors call this while the scene is being iterated
+        sol::usertype<SceneState> sceneState = lua["SceneState"];
+        sceneState["Instantiate"] =
+          [this](SceneState&, std::string_view prefab, u32 count, sol::optional<sol::table> positions) -> bool {
+            const NameID name = NameID::Find(prefab);
+            if (name.IsNone()) {
+                Log::Warn("Scene", "No prefab named '{}'", prefab);
+                return false;
+            }
+
+            vector<Vec2> spawnPositions;
+            if (!ReadSpawnPositions(positions, count, spawnPositions)) return false;
+
+            return mActiveScene->Instantiate(name, count, spawnPositions);
+        };
+
+        sceneState["Acquire"] = [this](SceneState& state,
+                                       std::string_view prefab,
+                                       sol::optional<Vec2> position) -> sol::optional<Entity> {
+            auto* pool = mActiveScene->FindPool(NameID::Find(prefab));
+            if (!pool) {
+                Log::Warn("Scene", "No pool for prefab '{}'", prefab);
+                return sol::nullopt;
+            }
+
+            const Entity entity = pool->Acquire();
+            if (entity == entt::null) return sol::nullopt;
+            if (position) { state.GetTransform(entity).position = *position; }
+            return entity;
+        };
+
+        sceneState["Release"] = [this](SceneState& state, Entity entity) -> bool {
+            if (!state.IsValid(entity)) return false;
+
+            auto* pool = mActiveScene->FindPool(state.GetEntityNameID(entity));
+            return pool && pool->Release(entity);
+        };
+
+        // Delivered at the start of the next Update to the handlers scripts register with Subscribe
+        const auto send = [this](std::string_view type,
+                                 const u32 target,
+                                 const NameID tag,
+                                 const sol::optional<f32>& value,
+                                 const sol::optional<u32>& sender) {
+            // Subscribing interns the type, so a type that was never interned has nobody listening
+            const NameID name = NameID::Find(type);
+            if (name.IsNone()) return;
+            mEventBus.Send({name, target, tag, sender.value_or(EventBus::kNoEntity), value.value_or(0.f)});
+        };
+
+        auto events    = lua.create_named_table("Events");
+        events["Send"] = [send](const sol::table&,
+                                std::string_view type,
+                                u32 target,
+                                sol::optional<f32> value,
+                                sol::optional<u32> sender) { send(type, target, {}, value, sender); };
+        events["SendTag"] = [send](const sol::table&,
+                                   std::string_view type,
+                                   std::string_view tag,
+                                   sol::optional<f32> value,
+                                   sol::optional<u32> sender) {
+            send(type, EventBus::kNoEntity, NameID(tag), value, sender);
+        };
+        events["Broadcast"] =
+          [send](const sol::table&, std::string_view type, sol::optional<f32> value, sol::optional<u32> sender) {
+              send(type, EventBus::kNoEntity, {}, value, sender);
+          };
+
         return true;
     }
-}  // namespace Astera
\ No newline at end of file
+
+    void Game::RegisterIsolatedLuaGlobals(sol::state& lua) {
+        // Lanes run on worker threads, so only bindings that don't touch engine state are shared with them
+        Log::RegisterLuaGlobals(lua);
+        Math::RegisterLuaGlobals(lua);
+        Coordinates::RegisterLuaGlobals(lua);
+        ScriptFFI::RegisterLuaGlobals(lua);
+        ScriptTypeRegistry::RegisterIsolatedTypes(lua);
+
+        // Changes to the world are recorded into the active scene's command buffer, which every thread can record into
+        auto commands           = lua.create_named_table("Commands");
+        commands["Instantiate"] = [this](const sol::table&,
+                                         std::string_view prefab,
+                                         u32 count,
+                                         sol::optional<sol::table> positions) -> bool {
+            const Prefab* found = mActiveScene->GetState().FindPrefab(NameID::Find(prefab));
+            if (!found) {
+                Log::Warn("Scene", "No prefab named '{}'", prefab);
+                return false;
+            }
+
+            thread_local vector<Vec2> spawnPositions;
+            thread_local vector<Transform> transforms;
+            if (!ReadSpawnPositions(positions, count, spawnPositions)) return false;
+            if (spawnPositions.empty()) {
+                mActiveScene->GetCommands().Instantiate(*found, count);
+                return true;
+            }
+
+            transforms.assign(count, found->transform);
+            for (u32 i = 0; i < count; ++i) {
+                transforms[i].position = spawnPositions[i];
+            }
+            mActiveScene->GetCommands().Instantiate(*found, count, transforms);
+            return true;
+        };
+
+        commands["Destroy"] = [this](const sol::table&, Entity entity) {
+            mActiveScene->GetCommands().DestroyEntity(entity);
+        };
+    }
+}  // namespace Astera
@@ -32,10 +32,13 @@
 #include "AudioEngine.hpp"
 #include "EngineConfig.hpp"
 #include "EnginePlugin.hpp"
+#include "EventBus.hpp"
+#include "FileWatcher.hpp"
 #include "FrameAllocator.hpp"
 #include "Scene.hpp"
 #include "ScriptEngine.hpp"
 #include "Window.hpp"
+#include "Physics/PhysicsEngine.hpp"
 #include "Rendering/DebugInterface.hpp"
 #include "Rendering/ImGuiDebugLayer.hpp"
 #include "Rendering/PhysicsDebugLayer.hpp"
@@ -112,12 +115,24 @@ namespace Astera {
             return mAudioEngine;
         }
 
+        /// @brief Gets the physics engine
+        /// @return Reference to the PhysicsEngine simulating the active scene
+        ASTERA_KEEP PhysicsEngine& GetPhysicsEngine() {
+            return mPhysicsEngine;
+        }
+
         /// @brief Gets the frame allocator
         /// @return Reference to the frame allocator instance
         ASTERA_KEEP FrameAllocator& GetFrameAllocator() {
             return mFrameAllocator;
         }
 
+        /// @brief Gets the bus scripts send events through
+        /// @return Reference to the event bus, its events are delivered at the start of each Update
+        ASTERA_KEEP EventBus& GetEventBus() {
+            return mEventBus;
+        }
+
         /// @brief Checks if the window is in fullscreen mode
         /// @return True if fullscreen, false if windowed
         ASTERA_KEEP bool GetFullscreen() const {
@@ -144,6 +159,10 @@ namespace Astera {
         /// Override this to initialize game systems and load resources
         void OnAwake() override;
 
+        /// @brief Called at the fixed update rate, runs fixed behaviors, the physics step and collision callbacks
+        /// @param timeStep Fixed time step in seconds
+        void OnFixedUpdate(f32 timeStep) override;
+
         /// @brief Called every frame for game logic updates
         /// @param clock Clock object containing delta time and frame information
         void OnUpdate(const Clock& clock) override;
@@ -181,11 +200,20 @@ namespace Astera {
         /// @return True if initialization succeeded, false otherwise
         bool InitializeScriptEngine();
 
+        /// @brief Registers what isolated scripts can use on a lane, see ScriptEngine::EnableIsolatedScripts
+        void RegisterIsolatedLuaGlobals(sol::state& lua);
+
         void LoadPlugins();
         void UpdateSceneCache();
         void LoadEngineConfigurations();
         void LoadDebugLayers(u32 width, u32 height);
 
+        /// @brief Watches every script asset for changes, see ReloadChangedScripts
+        void WatchScripts();
+
+        /// @brief Reloads the loaded scripts whose files changed since the last frame into the active scene
+        void ReloadChangedScripts();
+
         // Core rendering
 
         /// @brief Main render target for the game window
@@ -199,9 +227,30 @@ namespace Astera {
         /// @brief Audio playback and management engine
         AudioEngine mAudioEngine;
 
+        /// @brief Rigid body simulation for the active scene
+        PhysicsEngine mPhysicsEngine;
+
+        /// @brief Milliseconds spent in physics steps during the current frame
+        f32 mPhysicsFrameTime {0.0f};
+
+        /// @brief Whether script assets are reloaded as they change, `[Scripts] HotReload` in Engine.ini
+        bool mScriptHotReload {false};
+
+        /// @brief Watches script assets while hot reload is on
+        unique_ptr<FileWatcher> mScriptWatcher;
+
+        /// @brief Asset ID of each watched script file
+        unordered_map<string, AssetID> mWatchedScripts;
+
+        /// @brief Scratch for ReloadChangedScripts
+        vector<Path> mChangedScripts;
+
         /// @brief Frame allocator for temporary, fast allocations
         FrameAllocator mFrameAllocator;
 
+        /// @brief Events between scripts, stored in the frame allocator
+        EventBus mEventBus {mFrameAllocator};
+
         unordered_map<string, Plugin> mPlugins;
 
         // Client systems
@@ -66,7 +66,7 @@ namespace Astera {
         if (!file.is_open()) {
             return false;
         }
-        file << bytes.data();
+        file.write(RCAST<const char*>(bytes.data()), CAST<std::streamsize>(bytes.size()));
         file.close();
         return true;
     }
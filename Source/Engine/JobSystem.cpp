@@ -243,13 +243,13 @@ namespace Astera {
             }
         } else {
             // We're on the main thread or external thread, try global queue
-            std::lock_guard<std::mutex> lock(mGlobalMutex);
+            std::unique_lock<std::mutex> lock(mGlobalMutex);
             if (!mGlobalQueue.empty()) {
                 job = std::move(mGlobalQueue.front());
                 mGlobalQueue.pop();
 
                 // Execute without lock
-                lock.~lock_guard();
+                lock.unlock();
                 job();
                 mTotalJobsCompleted.fetch_add(1, std::memory_order_relaxed);
                 return true;
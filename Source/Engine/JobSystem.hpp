@@ -241,8 +241,15 @@ namespace Astera {
         gJobSystem->WaitForCounter(counter);
     }
 
+    /// @brief Number of distinct worker indices ParallelForIndexed can pass, use this to size per-worker storage
+    inline size_t GetParallelSlotCount() {
+        if (!gJobSystem || !gJobSystem->IsInitialized()) return 1;
+        return gJobSystem->GetWorkerCount() + 1;
+    }
+
     /// @brief Helper for parallel-for loops with worker ID awareness
     /// @tparam Func Function signature: void(size_t index, size_t workerID)
+    /// @note The calling thread helps run jobs while waiting and is given the last index, see GetParallelSlotCount
     template<typename Func>
     void ParallelForIndexed(size_t start, size_t end, Func func, size_t chunkSize = 0) {
         if (!gJobSystem || !gJobSystem->IsInitialized()) {
@@ -266,7 +273,7 @@ namespace Astera {
             size_t chunkEnd = Math::Min(i + chunkSize, end);
             jobs.push_back([i, chunkEnd, &func]() {
                 i32 workerID       = gJobSystem->GetCurrentWorkerID();
-                size_t workerIndex = workerID >= 0 ? static_cast<size_t>(workerID) : 0;
+                size_t workerIndex = workerID >= 0 ? static_cast<size_t>(workerID) : gJobSystem->GetWorkerCount();
                 for (size_t j = i; j < chunkEnd; ++j) {
                     func(j, workerIndex);
                 }
@@ -27,7 +27,9 @@
  */
 
 #include "Math.hpp"
+#include "JobSystem.hpp"
 
+#include <atomic>
 #include <random>
 
 namespace Astera {
@@ -83,18 +85,61 @@ namespace Astera {
         return CAST<f64>(a) * kPi;
     }
 
+    /// @brief Seeds from the OS until a seed is set, so runs differ unless a replay asks for a fixed seed
+    static u64 MakeDefaultSeed() {
+        std::random_device device;
+        return (CAST<u64>(device()) << 32) | device();
+    }
+
+    static std::atomic<u64> gRandomSeed {MakeDefaultSeed()};
+
+    /// @brief Bumped by SetSeed so thread streams know to restart
+    static std::atomic<u32> gRandomSeedGeneration {1};
+
     f32 Math::Random() {
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
-        std::uniform_real_distribution<f32> dis(0.0f, 1.0f);
-        return dis(gen);
+        return GetThreadStream().NextFloat();
     }
 
     i32 Math::RandomInt(i32 min, i32 max) {
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
-        std::uniform_int_distribution<i32> dis(min, max);
-        return dis(gen);
+        return GetThreadStream().NextInt(min, max);
+    }
+
+    f32 Math::RandomRange(f32 min, f32 max) {
+        return GetThreadStream().NextRange(min, max);
+    }
+
+    void Math::RandomFill(std::span<f32> out, f32 min, f32 max) {
+        GetThreadStream().Fill(out, min, max);
+    }
+
+    void Math::SetSeed(u64 seed) {
+        gRandomSeed.store(seed, std::memory_order_relaxed);
+        gRandomSeedGeneration.fetch_add(1, std::memory_order_release);
+    }
+
+    u64 Math::GetSeed() {
+        return gRandomSeed.load(std::memory_order_relaxed);
+    }
+
+    RandomStream& Math::GetThreadStream() {
+        struct ThreadStream {
+            RandomStream stream;
+            u32 generation {0};
+        };
+        thread_local ThreadStream local;
+
+        const u32 generation = gRandomSeedGeneration.load(std::memory_order_acquire);
+        if (local.generation != generation) {
+            const i32 worker = gJobSystem ? gJobSystem->GetCurrentWorkerID() : -1;
+            local.stream     = CreateStream(worker >= 0 ? CAST<u64>(worker) + 1 : 0);
+            local.generation = generation;
+        }
+
+        return local.stream;
+    }
+
+    RandomStream Math::CreateStream(u64 streamId) {
+        return RandomStream(GetSeed(), streamId);
     }
 
     f32 Math::Lerp(f32 a, f32 b, f32 t) {
@@ -123,5 +168,22 @@ namespace Astera {
         math["Random"]    = [](const sol::object&) -> f32 { return Random(); };
         math["RandomInt"] = [](const sol::object&, i32 a, i32 b) -> i32 { return RandomInt(a, b); };
         math["Lerp"]      = [](const sol::object&, f32 a, f32 b, f32 t) -> f32 { return Lerp(a, b, t); };
+
+        math["RandomRange"] = [](const sol::object&, f32 a, f32 b) -> f32 { return RandomRange(a, b); };
+        math["SetSeed"]     = [](const sol::object&, f64 seed) { SetSeed(CAST<u64>(seed)); };
+
+        // Writes into a table owned by the script, so refilling the same table every frame doesn't allocate
+        math["RandomFill"] = [](const sol::object&,
+                                sol::table out,
+                                u32 count,
+                                sol::optional<f32> min,
+                                sol::optional<f32> max) {
+            auto& stream   = GetThreadStream();
+            const f32 low  = min.value_or(0.0f);
+            const f32 high = max.value_or(1.0f);
+            for (u32 i = 1; i <= count; ++i) {
+                out.raw_set(i, stream.NextRange(low, high));
+            }
+        };
     }
 }  // namespace Astera
\ No newline at end of file
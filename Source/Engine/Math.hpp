@@ -29,8 +29,10 @@
 #pragma once
 
 #include "EngineCommon.hpp"
+#include "Random.hpp"
 
 #include <sol/sol.hpp>
+#include <span>
 
 namespace sol {
     class state;
@@ -113,14 +115,37 @@ namespace Astera {
         /// @return The angle in degrees
         static f32 RadToDeg(f32 a);
 
-        /// @brief Generates a random float between 0.0 and 1.0
+        /// @brief Generates a random float in [0, 1) from the calling thread's stream
         /// @return A random float value
         static f32 Random();
 
-        /// @brief Generates a random integer between min and max
+        /// @brief Generates a random integer between min and max (inclusive) from the calling thread's stream
         /// @return A random signed integer value
         static i32 RandomInt(i32 min, i32 max);
 
+        /// @brief Generates a random float in [min, max) from the calling thread's stream
+        static f32 RandomRange(f32 min, f32 max);
+
+        /// @brief Fills a buffer with random floats in [min, max) from the calling thread's stream
+        static void RandomFill(std::span<f32> out, f32 min = 0.0f, f32 max = 1.0f);
+
+        /// @brief Sets the seed all random streams derive from, thread streams restart on their next use
+        static void SetSeed(u64 seed);
+
+        /// @brief Gets the seed all random streams derive from, log it to replay a run
+        static u64 GetSeed();
+
+        /// @brief Gets the calling thread's random stream
+        ///
+        /// Job system workers each have their own stream, every other thread uses stream 0. Results only repeat
+        /// between runs when the same thread draws the same values, use CreateStream when the work is spread over
+        /// workers.
+        static RandomStream& GetThreadStream();
+
+        /// @brief Creates a stream derived from the global seed whose sequence doesn't depend on the calling thread
+        /// @param streamId Identifies the stream, e.g. a hash of the owning system's name
+        static RandomStream CreateStream(u64 streamId);
+
         /// @brief Linearly interpolates between two values
         /// @param a The start value
         /// @param b The end value
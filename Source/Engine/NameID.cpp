@@ -0,0 +1,80 @@
+/*
+ *  Filename: NameID.cpp
+ *  This code is part of the Astera core library
+ *  Copyright 2025 Jake Rieger
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "NameID.hpp"
+
+namespace Astera {
+    namespace {
+        /// @brief Lets the table be probed with a string_view without building a string
+        struct NameHash {
+            using is_transparent = void;
+
+            size_t operator()(std::string_view name) const noexcept {
+                return std::hash<std::string_view> {}(name);
+            }
+        };
+
+        struct NameTable {
+            unordered_map<string, u32, NameHash, std::equal_to<>> ids;
+            vector<const string*> strings;  ///< Map keys, which stay put as the map grows
+
+            NameTable() {
+                const auto empty = ids.emplace(string {}, 0).first;
+                strings.push_back(&empty->first);
+            }
+        };
+
+        NameTable& GetNameTable() {
+            static NameTable table;
+            return table;
+        }
+    }  // namespace
+
+    NameID::NameID(std::string_view name) {
+        auto& table = GetNameTable();
+
+        if (const auto it = table.ids.find(name); it != table.ids.end()) {
+            mIndex = it->second;
+            return;
+        }
+
+        mIndex        = CAST<u32>(table.strings.size());
+        const auto it = table.ids.emplace(string {name}, mIndex).first;
+        table.strings.push_back(&it->first);
+    }
+
+    NameID NameID::Find(std::string_view name) {
+        const auto& table = GetNameTable();
+        const auto it     = table.ids.find(name);
+        return it != table.ids.end() ? NameID {it->second} : NameID {};
+    }
+
+    const string& NameID::ToString() const {
+        return *GetNameTable().strings[mIndex];
+    }
+}  // namespace Astera
@@ -0,0 +1,82 @@
+/*
+ *  Filename: NameID.hpp
+ *  This code is part of the Astera core library
+ *  Copyright 2025 Jake Rieger
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include "EngineCommon.hpp"
+
+#include <string_view>
+
+namespace Astera {
+    /// @brief Handle to an interned string, copies, compares and hashes as a single integer
+    ///
+    /// Every distinct string is stored once in a process-wide table and lives until exit. Names are interned when a
+    /// NameID is constructed from a string; NameID::Find only looks a string up, so probing with names that were never
+    /// used doesn't grow the table. The table is not thread-safe, create names on the main thread.
+    class NameID {
+    public:
+        /// @brief The empty name
+        NameID() = default;
+
+        /// @brief Interns a string, returning the existing id if it was seen before
+        explicit NameID(std::string_view name);
+
+        /// @brief Looks up a string without interning it
+        /// @return The name's id, or the empty name if the string was never interned
+        static NameID Find(std::string_view name);
+
+        /// @brief Gets the interned string
+        ASTERA_KEEP const string& ToString() const;
+
+        ASTERA_KEEP u32 GetIndex() const {
+            return mIndex;
+        }
+
+        ASTERA_KEEP bool IsNone() const {
+            return mIndex == 0;
+        }
+
+        bool operator==(const NameID& other) const = default;
+
+    private:
+        u32 mIndex {0};
+
+        explicit NameID(u32 index) : mIndex(index) {}
+    };
+}  // namespace Astera
+
+#ifndef ASTERA_NAMEID_HASH_SPECIALIZATION
+    #define ASTERA_NAMEID_HASH_SPECIALIZATION
+/// @brief std::hash specialization for NameID, names are already unique indices
+template<>
+struct std::hash<Astera::NameID> {
+    std::size_t operator()(const Astera::NameID& name) const noexcept {
+        return std::hash<Astera::u32> {}(name.GetIndex());
+    }
+};
+#endif
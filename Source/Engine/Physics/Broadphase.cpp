@@ -0,0 +1,525 @@
+/*
+ *  Filename: Broadphase.cpp
+ *  This code is part of the Astera core library
+ *  Copyright 2025 Jake Rieger
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "Broadphase.hpp"
+#include "JobSystem.hpp"
+
+#include <algorithm>
+
+namespace Astera {
+    /// @brief Minimum number of query items per job, below this the tree walks are cheaper than scheduling
+    static constexpr size_t kPairsChunkSize = 64;
+
+    void MergeBroadphasePairs(vector<vector<BroadphasePair>>& threadPairs, vector<BroadphasePair>& outPairs) {
+        size_t total = 0;
+        for (const auto& pairs : threadPairs) {
+            total += pairs.size();
+        }
+
+        outPairs.clear();
+        outPairs.reserve(total);
+        for (auto& pairs : threadPairs) {
+            outPairs.insert(outPairs.end(), pairs.begin(), pairs.end());
+            pairs.clear();
+        }
+
+        std::sort(outPairs.begin(), outPairs.end());
+    }
+
+    static void PrepareThreadPairs(vector<vector<BroadphasePair>>& threadPairs) {
+        threadPairs.resize(GetParallelSlotCount());
+        for (auto& pairs : threadPairs) {
+            pairs.clear();
+        }
+    }
+
+    static BroadphasePair MakePair(u32 a, u32 b) {
+        return a < b ? BroadphasePair {a, b} : BroadphasePair {b, a};
+    }
+
+    // ============================================================================================================== //
+    // DynamicAABBTree
+    // ============================================================================================================== //
+
+    void DynamicAABBTree::Synchronize(std::span<const BroadphaseProxy> proxies) {
+        ++mGeneration;
+        Update(proxies);
+
+        for (auto it = mProxies.begin(); it != mProxies.end();) {
+            if (it->second.generation == mGeneration) {
+                ++it;
+                continue;
+            }
+
+            SetMovable(it->second.node, false);
+            RemoveLeaf(it->second.node);
+            FreeNode(it->second.node);
+            --mLeafCount;
+            it = mProxies.erase(it);
+        }
+
+        mStats.proxies = mLeafCount;
+    }
+
+    void DynamicAABBTree::Update(std::span<const BroadphaseProxy> proxies) {
+        for (const auto& proxy : proxies) {
+            UpsertProxy(proxy);
+        }
+
+        mStats.proxies = mLeafCount;
+    }
+
+    void DynamicAABBTree::UpsertProxy(const BroadphaseProxy& proxy) {
+        auto [it, inserted]   = mProxies.try_emplace(proxy.key, ProxyState {kNullNode, mGeneration});
+        it->second.generation = mGeneration;
+
+        if (inserted) {
+            const i32 leaf      = AllocateNode();
+            mNodes[leaf].bounds = proxy.bounds.Expanded(mFatMargin);
+            mNodes[leaf].height = 0;
+            it->second.node     = leaf;
+            InsertLeaf(leaf);
+            ++mLeafCount;
+        } else if (!mNodes[it->second.node].bounds.Contains(proxy.bounds)) {
+            const i32 leaf = it->second.node;
+            RemoveLeaf(leaf);
+            mNodes[leaf].bounds = proxy.bounds.Expanded(mFatMargin);
+            InsertLeaf(leaf);
+        }
+
+        // Body indices can change between syncs, the leaf only keeps its place in the tree
+        mNodes[it->second.node].body = proxy.body;
+        SetMovable(it->second.node, !proxy.isStatic);
+    }
+
+    void DynamicAABBTree::SetMovable(i32 leaf, bool movable) {
+        Node& node = mNodes[leaf];
+        if (movable == (node.movableIndex >= 0)) return;
+
+        if (movable) {
+            node.movableIndex = CAST<i32>(mMovableLeaves.size());
+            mMovableLeaves.push_back(leaf);
+            return;
+        }
+
+        const i32 last                    = mMovableLeaves.back();
+        mMovableLeaves[node.movableIndex] = last;
+        mNodes[last].movableIndex         = node.movableIndex;
+        mMovableLeaves.pop_back();
+        node.movableIndex = -1;
+    }
+
+    void DynamicAABBTree::FindPairs(vector<BroadphasePair>& outPairs) {
+        PrepareThreadPairs(mThreadPairs);
+
+        ParallelForIndexed(
+          0,
+          mMovableLeaves.size(),
+          [this](size_t i, size_t worker) { QueryLeaf(mMovableLeaves[i], mThreadPairs[worker]); },
+          kPairsChunkSize);
+
+        MergeBroadphasePairs(mThreadPairs, outPairs);
+        mStats.candidatePairs = CAST<u32>(outPairs.size());
+    }
+
+    void DynamicAABBTree::QueryLeaf(i32 leaf, vector<BroadphasePair>& outPairs) const {
+        const Node& query = mNodes[leaf];
+
+        VisitLeaves(query.bounds, [&](i32 index) {
+            // Movable pairs are reported by the leaf with the lower index, static ones never query
+            const Node& node = mNodes[index];
+            if (index == leaf || (node.movableIndex >= 0 && index < leaf)) return;
+            outPairs.push_back(MakePair(query.body, node.body));
+        });
+    }
+
+    void DynamicAABBTree::Query(const AABB& bounds, vector<u32>& outBodies) const {
+        VisitLeaves(bounds, [&](i32 index) { outBodies.push_back(mNodes[index].body); });
+    }
+
+    void DynamicAABBTree::QuerySegment(const Vec2& origin, const Vec2& translation, vector<u32>& outBodies) const {
+        VisitLeavesWhere(
+          [&](const AABB& nodeBounds) { return nodeBounds.IntersectsSegment(origin, translation); },
+          [&](i32 index) { outBodies.push_back(mNodes[index].body); });
+    }
+
+    void DynamicAABBTree::Clear() {
+        mNodes.clear();
+        mProxies.clear();
+        mMovableLeaves.clear();
+        mRoot      = kNullNode;
+        mFreeList  = kNullNode;
+        mLeafCount = 0;
+        mStats     = {};
+    }
+
+    BroadphaseStats DynamicAABBTree::GetStats() const {
+        BroadphaseStats stats = mStats;
+        stats.memoryBytes     = mNodes.capacity() * sizeof(Node) + mMovableLeaves.capacity() * sizeof(i32) +
+                            mProxies.size() * (sizeof(u32) + sizeof(ProxyState) + sizeof(void*)) +
+                            mProxies.bucket_count() * sizeof(void*);
+        for (const auto& pairs : mThreadPairs) {
+            stats.memoryBytes += pairs.capacity() * sizeof(BroadphasePair);
+        }
+
+        return stats;
+    }
+
+    i32 DynamicAABBTree::GetHeight() const {
+        return mRoot == kNullNode ? 0 : mNodes[mRoot].height;
+    }
+
+    i32 DynamicAABBTree::AllocateNode() {
+        if (mFreeList == kNullNode) {
+            mNodes.emplace_back();
+            return CAST<i32>(mNodes.size() - 1);
+        }
+
+        const i32 node = mFreeList;
+        mFreeList      = mNodes[node].parent;
+        mNodes[node]   = Node {};
+
+        return node;
+    }
+
+    void DynamicAABBTree::FreeNode(i32 node) {
+        mNodes[node].parent = mFreeList;
+        mNodes[node].height = -1;
+        mFreeList           = node;
+    }
+
+    void DynamicAABBTree::InsertLeaf(i32 leaf) {
+        if (mRoot == kNullNode) {
+            mRoot               = leaf;
+            mNodes[leaf].parent = kNullNode;
+            return;
+        }
+
+        // Descend towards the sibling that minimizes the perimeter added to the tree
+        const AABB leafBounds = mNodes[leaf].bounds;
+        i32 index             = mRoot;
+        while (!mNodes[index].IsLeaf()) {
+            const Node& node = mNodes[index];
+
+            const f32 area         = node.bounds.Perimeter();
+            const f32 combinedArea = AABB::Union(node.bounds, leafBounds).Perimeter();
+
+            // Cost of pairing with this node versus pushing the leaf further down
+            const f32 cost            = 2.0f * combinedArea;
+            const f32 inheritanceCost = 2.0f * (combinedArea - area);
+
+            auto descendCost = [&](i32 child) {
+                const AABB& childBounds = mNodes[child].bounds;
+                const f32 unionArea     = AABB::Union(childBounds, leafBounds).Perimeter();
+                if (mNodes[child].IsLeaf()) return unionArea + inheritanceCost;
+                return unionArea - childBounds.Perimeter() + inheritanceCost;
+            };
+
+            const f32 cost1 = descendCost(node.child1);
+            const f32 cost2 = descendCost(node.child2);
+
+            if (cost < cost1 && cost < cost2) break;
+            index = cost1 < cost2 ? node.child1 : node.child2;
+        }
+
+        const i32 sibling   = index;
+        const i32 oldParent = mNodes[sibling].parent;
+        const i32 newParent = AllocateNode();
+
+        mNodes[newParent].parent = oldParent;
+        mNodes[newParent].bounds = AABB::Union(leafBounds, mNodes[sibling].bounds);
+        mNodes[newParent].height = mNodes[sibling].height + 1;
+        mNodes[newParent].child1 = sibling;
+        mNodes[newParent].child2 = leaf;
+        mNodes[sibling].parent   = newParent;
+        mNodes[leaf].parent      = newParent;
+
+        if (oldParent == kNullNode) {
+            mRoot = newParent;
+        } else if (mNodes[oldParent].child1 == sibling) {
+            mNodes[oldParent].child1 = newParent;
+        } else {
+            mNodes[oldParent].child2 = newParent;
+        }
+
+        Refit(mNodes[leaf].parent);
+    }
+
+    void DynamicAABBTree::RemoveLeaf(i32 leaf) {
+        if (leaf == mRoot) {
+            mRoot = kNullNode;
+            return;
+        }
+
+        const i32 parent      = mNodes[leaf].parent;
+        const i32 grandParent = mNodes[parent].parent;
+        const i32 sibling     = mNodes[parent].child1 == leaf ? mNodes[parent].child2 : mNodes[parent].child1;
+
+        mNodes[sibling].parent = grandParent;
+        FreeNode(parent);
+
+        if (grandParent == kNullNode) {
+            mRoot = sibling;
+            return;
+        }
+
+        if (mNodes[grandParent].child1 == parent) {
+            mNodes[grandParent].child1 = sibling;
+        } else {
+            mNodes[grandParent].child2 = sibling;
+        }
+
+        Refit(grandParent);
+    }
+
+    void DynamicAABBTree::Refit(i32 node) {
+        i32 index = node;
+        while (index != kNullNode) {
+            index = Balance(index);
+
+            Node& current  = mNodes[index];
+            current.height = 1 + std::max(mNodes[current.child1].height, mNodes[current.child2].height);
+            current.bounds = AABB::Union(mNodes[current.child1].bounds, mNodes[current.child2].bounds);
+
+            index = current.parent;
+        }
+    }
+
+    i32 DynamicAABBTree::Balance(i32 iA) {
+        Node& A = mNodes[iA];
+        if (A.IsLeaf() || A.height < 2) return iA;
+
+        const i32 iB = A.child1;
+        const i32 iC = A.child2;
+        Node& B      = mNodes[iB];
+        Node& C      = mNodes[iC];
+
+        const i32 balance = C.height - B.height;
+        if (balance > 1) {
+            // Rotate C up
+            const i32 iF = C.child1;
+            const i32 iG = C.child2;
+            Node& F      = mNodes[iF];
+            Node& G      = mNodes[iG];
+
+            C.child1 = iA;
+            C.parent = A.parent;
+            A.parent = iC;
+
+            if (C.parent == kNullNode) {
+                mRoot = iC;
+            } else if (mNodes[C.parent].child1 == iA) {
+                mNodes[C.parent].child1 = iC;
+            } else {
+                mNodes[C.parent].child2 = iC;
+            }
+
+            if (F.height > G.height) {
+                C.child2 = iF;
+                A.child2 = iG;
+                G.parent = iA;
+                A.bounds = AABB::Union(B.bounds, G.bounds);
+                C.bounds = AABB::Union(A.bounds, F.bounds);
+                A.height = 1 + std::max(B.height, G.height);
+                C.height = 1 + std::max(A.height, F.height);
+            } else {
+                C.child2 = iG;
+                A.child2 = iF;
+                F.parent = iA;
+                A.bounds = AABB::Union(B.bounds, F.bounds);
+                C.bounds = AABB::Union(A.bounds, G.bounds);
+                A.height = 1 + std::max(B.height, F.height);
+                C.height = 1 + std::max(A.height, G.height);
+            }
+
+            return iC;
+        }
+
+        if (balance < -1) {
+            // Rotate B up
+            const i32 iD = B.child1;
+            const i32 iE = B.child2;
+            Node& D      = mNodes[iD];
+            Node& E      = mNodes[iE];
+
+            B.child1 = iA;
+            B.parent = A.parent;
+            A.parent = iB;
+
+            if (B.parent == kNullNode) {
+                mRoot = iB;
+            } else if (mNodes[B.parent].child1 == iA) {
+                mNodes[B.parent].child1 = iB;
+            } else {
+                mNodes[B.parent].child2 = iB;
+            }
+
+            if (D.height > E.height) {
+                B.child2 = iD;
+                A.child1 = iE;
+                E.parent = iA;
+                A.bounds = AABB::Union(C.bounds, E.bounds);
+                B.bounds = AABB::Union(A.bounds, D.bounds);
+                A.height = 1 + std::max(C.height, E.height);
+                B.height = 1 + std::max(A.height, D.height);
+            } else {
+                B.child2 = iE;
+                A.child1 = iD;
+                D.parent = iA;
+                A.bounds = AABB::Union(C.bounds, D.bounds);
+                B.bounds = AABB::Union(A.bounds, E.bounds);
+                A.height = 1 + std::max(C.height, D.height);
+                B.height = 1 + std::max(A.height, E.height);
+            }
+
+            return iB;
+        }
+
+        return iA;
+    }
+
+    // ============================================================================================================== //
+    // SweepAndPrune
+    // ============================================================================================================== //
+
+    void SweepAndPrune::Synchronize(std::span<const BroadphaseProxy> proxies) {
+        ++mGeneration;
+        for (const auto& proxy : proxies) {
+            UpsertEntry(proxy);
+        }
+
+        // Drop stale entries while keeping the remaining ones in their previous order
+        std::erase_if(mEntries, [this](const Entry& entry) { return entry.generation != mGeneration; });
+        Sort();
+    }
+
+    void SweepAndPrune::Update(std::span<const BroadphaseProxy> proxies) {
+        for (const auto& proxy : proxies) {
+            UpsertEntry(proxy);
+        }
+
+        Sort();
+    }
+
+    void SweepAndPrune::UpsertEntry(const BroadphaseProxy& proxy) {
+        auto [it, inserted] = mKeyToEntry.try_emplace(proxy.key, CAST<u32>(mEntries.size()));
+        if (inserted) { mEntries.emplace_back(); }
+
+        Entry& entry     = mEntries[it->second];
+        entry.bounds     = proxy.bounds;
+        entry.key        = proxy.key;
+        entry.body       = proxy.body;
+        entry.generation = mGeneration;
+        entry.isStatic   = proxy.isStatic;
+    }
+
+    void SweepAndPrune::Sort() {
+        // Insertion sort stays close to linear because most entries are already in place
+        bool moved = false;
+        for (size_t i = 1; i < mEntries.size(); ++i) {
+            if (mEntries[i - 1].bounds.min.x <= mEntries[i].bounds.min.x) continue;
+
+            const Entry entry = mEntries[i];
+            size_t j          = i;
+            while (j > 0 && mEntries[j - 1].bounds.min.x > entry.bounds.min.x) {
+                mEntries[j] = mEntries[j - 1];
+                --j;
+            }
+            mEntries[j] = entry;
+            moved       = true;
+        }
+
+        if (moved || mKeyToEntry.size() != mEntries.size()) {
+            mKeyToEntry.clear();
+            for (size_t i = 0; i < mEntries.size(); ++i) {
+                mKeyToEntry[mEntries[i].key] = CAST<u32>(i);
+            }
+        }
+
+        mStats.proxies = CAST<u32>(mEntries.size());
+    }
+
+    void SweepAndPrune::FindPairs(vector<BroadphasePair>& outPairs) {
+        PrepareThreadPairs(mThreadPairs);
+
+        ParallelForIndexed(
+          0,
+          mEntries.size(),
+          [this](size_t i, size_t worker) {
+              const Entry& entry = mEntries[i];
+              auto& pairs        = mThreadPairs[worker];
+
+              for (size_t j = i + 1; j < mEntries.size(); ++j) {
+                  const Entry& other = mEntries[j];
+                  if (other.bounds.min.x > entry.bounds.max.x) break;
+                  if (entry.isStatic && other.isStatic) continue;
+                  if (other.bounds.min.y > entry.bounds.max.y || other.bounds.max.y < entry.bounds.min.y) continue;
+
+                  pairs.push_back(MakePair(entry.body, other.body));
+              }
+          },
+          kPairsChunkSize);
+
+        MergeBroadphasePairs(mThreadPairs, outPairs);
+        mStats.candidatePairs = CAST<u32>(outPairs.size());
+    }
+
+    void SweepAndPrune::Query(const AABB& bounds, vector<u32>& outBodies) const {
+        // Entries are only ordered by min.x, so everything before the cutoff still has to be checked
+        for (const auto& entry : mEntries) {
+            if (entry.bounds.min.x > bounds.max.x) break;
+            if (entry.bounds.Overlaps(bounds)) { outBodies.push_back(entry.body); }
+        }
+    }
+
+    void SweepAndPrune::QuerySegment(const Vec2& origin, const Vec2& translation, vector<u32>& outBodies) const {
+        const f32 maxX = std::max(origin.x, origin.x + translation.x);
+        for (const auto& entry : mEntries) {
+            if (entry.bounds.min.x > maxX) break;
+            if (entry.bounds.IntersectsSegment(origin, translation)) { outBodies.push_back(entry.body); }
+        }
+    }
+
+    void SweepAndPrune::Clear() {
+        mEntries.clear();
+        mKeyToEntry.clear();
+        mStats = {};
+    }
+
+    BroadphaseStats SweepAndPrune::GetStats() const {
+        BroadphaseStats stats = mStats;
+        stats.memoryBytes     = mEntries.capacity() * sizeof(Entry) +
+                            mKeyToEntry.size() * (2 * sizeof(u32) + sizeof(void*)) +
+                            mKeyToEntry.bucket_count() * sizeof(void*);
+        for (const auto& pairs : mThreadPairs) {
+            stats.memoryBytes += pairs.capacity() * sizeof(BroadphasePair);
+        }
+
+        return stats;
+    }
+}  // namespace Astera
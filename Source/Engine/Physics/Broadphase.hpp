@@ -0,0 +1,226 @@
+/*
+ *  Filename: Broadphase.hpp
+ *  This code is part of the Astera core library
+ *  Copyright 2025 Jake Rieger
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include "EngineCommon.hpp"
+#include "Physics/CollisionDetection.hpp"
+
+#include <span>
+
+namespace Astera {
+    /// @brief Collider bounds submitted to the broadphase for one step
+    struct BroadphaseProxy {
+        u32 key;        ///< Identifies the collider across steps (entity id)
+        u32 body;       ///< Body index reported back in pairs
+        AABB bounds;    ///< Tight world-space bounds
+        bool isStatic;  ///< Static proxies never pair with each other, sleeping bodies count as static
+    };
+
+    /// @brief Two bodies whose bounds may overlap, with a < b
+    struct BroadphasePair {
+        u32 a;
+        u32 b;
+
+        auto operator<=>(const BroadphasePair&) const = default;
+    };
+
+    struct BroadphaseStats {
+        u32 proxies {0};
+        u32 candidatePairs {0};
+        size_t memoryBytes {0};
+    };
+
+    /// @brief Interface for broadphase structures that cull collider pairs before the narrowphase
+    class IBroadphase {
+    public:
+        virtual ~IBroadphase() = default;
+
+        /// @brief Replaces the full set of colliders, proxies whose key is missing from `proxies` are removed
+        virtual void Synchronize(std::span<const BroadphaseProxy> proxies) = 0;
+
+        /// @brief Adds or moves the given proxies and leaves every other proxy untouched
+        virtual void Update(std::span<const BroadphaseProxy> proxies) = 0;
+
+        /// @brief Writes every candidate pair to `outPairs`, sorted so results don't depend on thread timing
+        virtual void FindPairs(vector<BroadphasePair>& outPairs) = 0;
+
+        /// @brief Appends the bodies whose proxy bounds overlap `bounds` to `outBodies`
+        virtual void Query(const AABB& bounds, vector<u32>& outBodies) const = 0;
+
+        /// @brief Appends the bodies whose proxy bounds are crossed by the segment from `origin` to
+        /// `origin + translation` to `outBodies`
+        virtual void QuerySegment(const Vec2& origin, const Vec2& translation, vector<u32>& outBodies) const = 0;
+
+        /// @brief Removes all proxies
+        virtual void Clear() = 0;
+
+        ASTERA_KEEP virtual BroadphaseStats GetStats() const = 0;
+    };
+
+    /// @brief Bounding volume hierarchy with fattened leaves that is refitted incrementally
+    ///
+    /// Leaves store bounds expanded by a margin so small movements don't touch the tree at all. When a collider
+    /// leaves its fat bounds the leaf is removed and reinserted, and the tree is kept balanced with AVL rotations.
+    class DynamicAABBTree final : public IBroadphase {
+    public:
+        explicit DynamicAABBTree(f32 fatMargin = 4.0f) : mFatMargin(fatMargin) {}
+
+        void Synchronize(std::span<const BroadphaseProxy> proxies) override;
+        void Update(std::span<const BroadphaseProxy> proxies) override;
+        void FindPairs(vector<BroadphasePair>& outPairs) override;
+        void Query(const AABB& bounds, vector<u32>& outBodies) const override;
+        void QuerySegment(const Vec2& origin, const Vec2& translation, vector<u32>& outBodies) const override;
+        void Clear() override;
+
+        ASTERA_KEEP BroadphaseStats GetStats() const override;
+
+        /// @brief Height of the tree, zero for a single leaf
+        ASTERA_KEEP i32 GetHeight() const;
+
+    private:
+        static constexpr i32 kNullNode = -1;
+
+        struct Node {
+            AABB bounds;
+            i32 parent {kNullNode};  ///< Next free node while on the free list
+            i32 child1 {kNullNode};
+            i32 child2 {kNullNode};
+            i32 height {-1};  ///< Leaves are 0, free nodes are -1
+            u32 body {0};
+            i32 movableIndex {-1};  ///< Position in mMovableLeaves, -1 for static leaves
+
+            ASTERA_KEEP bool IsLeaf() const {
+                return child1 == kNullNode;
+            }
+        };
+
+        struct ProxyState {
+            i32 node;
+            u32 generation;
+        };
+
+        f32 mFatMargin;
+        vector<Node> mNodes;
+        i32 mRoot {kNullNode};
+        i32 mFreeList {kNullNode};
+        u32 mLeafCount {0};
+
+        unordered_map<u32, ProxyState> mProxies;
+        u32 mGeneration {0};
+        vector<i32> mMovableLeaves;
+        vector<vector<BroadphasePair>> mThreadPairs;
+        BroadphaseStats mStats;
+
+        i32 AllocateNode();
+        void FreeNode(i32 node);
+        void InsertLeaf(i32 leaf);
+        void RemoveLeaf(i32 leaf);
+        i32 Balance(i32 node);
+
+        void UpsertProxy(const BroadphaseProxy& proxy);
+        void SetMovable(i32 leaf, bool movable);
+
+        /// @brief Recomputes bounds and heights from `node` up to the root
+        void Refit(i32 node);
+
+        void QueryLeaf(i32 leaf, vector<BroadphasePair>& outPairs) const;
+
+        /// @brief Calls `visit(index)` for every leaf whose fat bounds overlap `bounds`
+        template<typename Visitor>
+        void VisitLeaves(const AABB& bounds, Visitor&& visit) const {
+            VisitLeavesWhere([&bounds](const AABB& nodeBounds) { return nodeBounds.Overlaps(bounds); }, visit);
+        }
+
+        /// @brief Calls `visit(index)` for every leaf whose fat bounds, and those of all its ancestors, pass `test`
+        template<typename Test, typename Visitor>
+        void VisitLeavesWhere(Test&& test, Visitor&& visit) const {
+            // A balanced tree never needs more than a few dozen entries, the cap is for degenerate cases
+            constexpr size_t kStackCapacity = 256;
+            i32 stack[kStackCapacity];
+            size_t stackSize   = 0;
+            stack[stackSize++] = mRoot;
+
+            while (stackSize > 0) {
+                const i32 index = stack[--stackSize];
+                if (index == kNullNode) continue;
+
+                const Node& node = mNodes[index];
+                if (!test(node.bounds)) continue;
+
+                if (node.IsLeaf()) {
+                    visit(index);
+                    continue;
+                }
+
+                ASTERA_ASSERT_MSG(stackSize + 2 <= kStackCapacity, "AABB tree query stack overflow");
+                stack[stackSize++] = node.child1;
+                stack[stackSize++] = node.child2;
+            }
+        }
+    };
+
+    /// @brief Sort-and-sweep along the x axis
+    ///
+    /// Proxies keep their order between steps, so the insertion sort that restores it is close to linear when
+    /// colliders move coherently. Every step sweeps all proxies, so prefer the dynamic tree when most bodies sleep.
+    class SweepAndPrune final : public IBroadphase {
+    public:
+        void Synchronize(std::span<const BroadphaseProxy> proxies) override;
+        void Update(std::span<const BroadphaseProxy> proxies) override;
+        void FindPairs(vector<BroadphasePair>& outPairs) override;
+        void Query(const AABB& bounds, vector<u32>& outBodies) const override;
+        void QuerySegment(const Vec2& origin, const Vec2& translation, vector<u32>& outBodies) const override;
+        void Clear() override;
+
+        ASTERA_KEEP BroadphaseStats GetStats() const override;
+
+    private:
+        struct Entry {
+            AABB bounds;
+            u32 key;
+            u32 body;
+            u32 generation;
+            bool isStatic;
+        };
+
+        vector<Entry> mEntries;
+        unordered_map<u32, u32> mKeyToEntry;
+        u32 mGeneration {0};
+        vector<vector<BroadphasePair>> mThreadPairs;
+        BroadphaseStats mStats;
+
+        void UpsertEntry(const BroadphaseProxy& proxy);
+
+        /// @brief Restores ordering on min.x and rebuilds the key lookup
+        void Sort();
+    };
+
+    /// @brief Gathers per-thread pair buffers into a single sorted list
+    void MergeBroadphasePairs(vector<vector<BroadphasePair>>& threadPairs, vector<BroadphasePair>& outPairs);
+}  // namespace Astera
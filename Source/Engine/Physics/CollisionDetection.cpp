@@ -0,0 +1,443 @@
+/*
+ *  Filename: CollisionDetection.cpp
+ *  This code is part of the Astera core library
+ *  Copyright 2025 Jake Rieger
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "CollisionDetection.hpp"
+
+namespace Astera {
+    /// @brief Box expressed as a center, two unit axes and half extents along those axes
+    struct OrientedBox {
+        Vec2 center;
+        Vec2 axes[2];
+        Vec2 half;
+    };
+
+    static Vec2 RotateVector(const Vec2& v, f32 cosine, f32 sine) {
+        return {cosine * v.x - sine * v.y, sine * v.x + cosine * v.y};
+    }
+
+    static OrientedBox MakeOrientedBox(const CollisionShape& shape) {
+        const f32 cosine = std::cos(shape.rotation);
+        const f32 sine   = std::sin(shape.rotation);
+        return {shape.center, {{cosine, sine}, {-sine, cosine}}, shape.halfExtents};
+    }
+
+    /// @brief Half-length of a box projected onto an axis
+    static f32 ProjectRadius(const OrientedBox& box, const Vec2& axis) {
+        return box.half.x * std::abs(glm::dot(box.axes[0], axis)) + box.half.y * std::abs(glm::dot(box.axes[1], axis));
+    }
+
+    /// @brief Finds the face axis of `reference` with the smallest overlap against `other`
+    /// @return False if a separating axis was found
+    static bool FindMinOverlapAxis(const OrientedBox& reference,
+                                   const OrientedBox& other,
+                                   u32& outAxis,
+                                   f32& outOverlap,
+                                   f32& outSign) {
+        const Vec2 delta = other.center - reference.center;
+        outOverlap       = std::numeric_limits<f32>::max();
+
+        for (u32 i = 0; i < 2; ++i) {
+            const f32 distance = glm::dot(delta, reference.axes[i]);
+            const f32 overlap  = reference.half[i] + ProjectRadius(other, reference.axes[i]) - std::abs(distance);
+            if (overlap < 0.0f) return false;
+
+            if (overlap < outOverlap) {
+                outOverlap = overlap;
+                outAxis    = i;
+                outSign    = distance < 0.0f ? -1.0f : 1.0f;
+            }
+        }
+
+        return true;
+    }
+
+    /// @brief Clips a segment to the half-plane dot(normal, p) <= offset
+    /// @return Number of points written to `out`
+    static u32 ClipSegment(const Vec2 in[2], Vec2 out[2], const Vec2& normal, f32 offset) {
+        u32 count       = 0;
+        const f32 dist0 = glm::dot(normal, in[0]) - offset;
+        const f32 dist1 = glm::dot(normal, in[1]) - offset;
+
+        if (dist0 <= 0.0f) out[count++] = in[0];
+        if (dist1 <= 0.0f) out[count++] = in[1];
+
+        if (dist0 * dist1 < 0.0f) {
+            const f32 t  = dist0 / (dist0 - dist1);
+            out[count++] = in[0] + t * (in[1] - in[0]);
+        }
+
+        return count;
+    }
+
+    CollisionShape
+    CollisionDetection::MakeShape(const Collider2D& collider, const Vec2& position, f32 rotation, const Vec2& scale) {
+        const Vec2 absScale = glm::abs(scale);
+
+        CollisionShape shape {};
+        shape.type        = collider.shape;
+        shape.halfExtents = collider.size * absScale * 0.5f;
+        shape.radius      = collider.radius * std::max(absScale.x, absScale.y);
+        shape.rotation    = collider.shape == ColliderShape::AABB ? 0.0f : rotation;
+
+        const Vec2 offset = collider.offset * scale;
+        shape.center      = position + RotateVector(offset, std::cos(shape.rotation), std::sin(shape.rotation));
+
+        return shape;
+    }
+
+    AABB CollisionDetection::ComputeBounds(const CollisionShape& shape) {
+        if (shape.type == ColliderShape::Circle) {
+            return {shape.center - Vec2(shape.radius), shape.center + Vec2(shape.radius)};
+        }
+
+        const f32 cosine  = std::abs(std::cos(shape.rotation));
+        const f32 sine    = std::abs(std::sin(shape.rotation));
+        const Vec2 extent = {cosine * shape.halfExtents.x + sine * shape.halfExtents.y,
+                             sine * shape.halfExtents.x + cosine * shape.halfExtents.y};
+
+        return {shape.center - extent, shape.center + extent};
+    }
+
+    bool CollisionDetection::Collide(const CollisionShape& a, const CollisionShape& b, ContactManifold& outManifold) {
+        const bool boxA = a.type != ColliderShape::Circle;
+        const bool boxB = b.type != ColliderShape::Circle;
+
+        if (!boxA && !boxB) { return CircleVsCircle(a, b, outManifold); }
+
+        if (boxA && boxB) {
+            if (a.rotation == 0.0f && b.rotation == 0.0f) { return AABBVsAABB(a, b, outManifold); }
+            return BoxVsBox(a, b, outManifold);
+        }
+
+        if (boxA) { return BoxVsCircle(a, b, outManifold); }
+
+        if (!BoxVsCircle(b, a, outManifold)) return false;
+        outManifold.normal = -outManifold.normal;
+
+        return true;
+    }
+
+    bool CollisionDetection::Raycast(const CollisionShape& shape,
+                                     const Vec2& origin,
+                                     const Vec2& translation,
+                                     f32& outFraction,
+                                     Vec2& outNormal) {
+        if (shape.type == ColliderShape::Circle) {
+            const Vec2 offset = origin - shape.center;
+            const f32 a       = glm::dot(translation, translation);
+            const f32 b       = glm::dot(offset, translation);
+            const f32 c       = glm::dot(offset, offset) - shape.radius * shape.radius;
+            if (c <= 0.0f || b >= 0.0f || a == 0.0f) return false;
+
+            const f32 discriminant = b * b - a * c;
+            if (discriminant < 0.0f) return false;
+
+            const f32 fraction = (-b - std::sqrt(discriminant)) / a;
+            if (fraction > 1.0f) return false;
+
+            outFraction = fraction;
+            outNormal   = glm::normalize(offset + translation * fraction);
+            return true;
+        }
+
+        // Boxes are tested in their local frame, where they become a pair of slabs
+        const f32 cosine    = std::cos(shape.rotation);
+        const f32 sine      = std::sin(shape.rotation);
+        const Vec2 start    = RotateVector(origin - shape.center, cosine, -sine);
+        const Vec2 movement = RotateVector(translation, cosine, -sine);
+
+        f32 enter = -std::numeric_limits<f32>::max();
+        f32 exit  = std::numeric_limits<f32>::max();
+        Vec2 normal {0.0f};
+
+        for (i32 axis = 0; axis < 2; ++axis) {
+            const f32 half = shape.halfExtents[axis];
+            if (movement[axis] == 0.0f) {
+                if (std::abs(start[axis]) > half) return false;
+                continue;
+            }
+
+            // Moving in the positive direction enters through the negative face
+            const f32 sign = movement[axis] > 0.0f ? -1.0f : 1.0f;
+            const f32 axisEnter = (sign * half - start[axis]) / movement[axis];
+            const f32 axisExit  = (-sign * half - start[axis]) / movement[axis];
+
+            if (axisEnter > enter) {
+                enter        = axisEnter;
+                normal       = Vec2(0.0f);
+                normal[axis] = sign;
+            }
+            exit = std::min(exit, axisExit);
+            if (enter > exit) return false;
+        }
+
+        if (enter < 0.0f || enter > 1.0f) return false;
+
+        outFraction = enter;
+        outNormal   = RotateVector(normal, cosine, sine);
+        return true;
+    }
+
+    f32 CollisionDetection::InnerRadius(const CollisionShape& shape) {
+        if (shape.type == ColliderShape::Circle) { return shape.radius; }
+        return std::min(shape.halfExtents.x, shape.halfExtents.y);
+    }
+
+    bool CollisionDetection::TimeOfImpact(const CollisionShape& shape,
+                                          const Vec2& translation,
+                                          const CollisionShape& target,
+                                          f32 tolerance,
+                                          f32& outFraction) {
+        // Moving bounds against target bounds narrows the sweep to the interval where the shapes can touch
+        const AABB bounds       = ComputeBounds(shape);
+        const AABB targetBounds = ComputeBounds(target);
+
+        f32 enter = 0.0f;
+        f32 exit  = 1.0f;
+        for (i32 axis = 0; axis < 2; ++axis) {
+            const f32 lower = targetBounds.min[axis] - bounds.max[axis];
+            const f32 upper = targetBounds.max[axis] - bounds.min[axis];
+
+            if (translation[axis] == 0.0f) {
+                if (lower > 0.0f || upper < 0.0f) return false;
+                continue;
+            }
+
+            f32 t0 = lower / translation[axis];
+            f32 t1 = upper / translation[axis];
+            if (t0 > t1) { std::swap(t0, t1); }
+
+            enter = std::max(enter, t0);
+            exit  = std::min(exit, t1);
+            if (enter > exit) return false;
+        }
+
+        ContactManifold manifold;
+        const auto overlapsAt = [&](f32 fraction) {
+            CollisionShape moved = shape;
+            moved.center += translation * fraction;
+            return Collide(moved, target, manifold);
+        };
+
+        // Already touching at the start, the discrete contact test owns this pair
+        if (enter == 0.0f && overlapsAt(0.0f)) return false;
+
+        const f32 length  = glm::length(translation);
+        const f32 spacing = std::max(InnerRadius(shape), tolerance);
+        const u32 samples = CAST<u32>(std::ceil((exit - enter) * length / spacing));
+
+        f32 lower = enter;
+        for (u32 i = enter == 0.0f ? 1 : 0; i <= samples; ++i) {
+            const f32 upper = samples > 0 ? enter + (exit - enter) * CAST<f32>(i) / CAST<f32>(samples) : exit;
+            if (!overlapsAt(upper)) {
+                lower = upper;
+                continue;
+            }
+
+            // Bounds only just touch at `enter`, so an overlap there is already within tolerance
+            f32 hit = upper;
+            while ((hit - lower) * length > tolerance) {
+                const f32 middle = 0.5f * (lower + hit);
+                if (overlapsAt(middle)) {
+                    hit = middle;
+                } else {
+                    lower = middle;
+                }
+            }
+
+            outFraction = hit;
+            return true;
+        }
+
+        return false;
+    }
+
+    bool
+    CollisionDetection::CircleVsCircle(const CollisionShape& a, const CollisionShape& b, ContactManifold& outManifold) {
+        const Vec2 delta      = b.center - a.center;
+        const f32 radii       = a.radius + b.radius;
+        const f32 distanceSqr = glm::dot(delta, delta);
+        if (distanceSqr > radii * radii) return false;
+
+        const f32 distance     = std::sqrt(distanceSqr);
+        const Vec2 normal      = distance > 0.0f ? delta / distance : Vec2(0.0f, 1.0f);
+        outManifold.normal     = normal;
+        outManifold.points[0]  = a.center + normal * (a.radius - (radii - distance) * 0.5f);
+        outManifold.depths[0]  = radii - distance;
+        outManifold.pointCount = 1;
+
+        return true;
+    }
+
+    bool CollisionDetection::BoxVsCircle(const CollisionShape& box,
+                                         const CollisionShape& circle,
+                                         ContactManifold& outManifold) {
+        const f32 cosine = std::cos(box.rotation);
+        const f32 sine   = std::sin(box.rotation);
+
+        // Work in the box's local frame
+        const Vec2 delta   = circle.center - box.center;
+        const Vec2 local   = {cosine * delta.x + sine * delta.y, -sine * delta.x + cosine * delta.y};
+        const Vec2 clamped = glm::clamp(local, -box.halfExtents, box.halfExtents);
+
+        Vec2 localNormal, localPoint;
+        f32 depth;
+
+        if (clamped == local) {
+            // Circle center is inside the box, push it out through the nearest face
+            const f32 distanceX = box.halfExtents.x - std::abs(local.x);
+            const f32 distanceY = box.halfExtents.y - std::abs(local.y);
+
+            if (distanceX < distanceY) {
+                const f32 side = local.x < 0.0f ? -1.0f : 1.0f;
+                localNormal    = {side, 0.0f};
+                localPoint     = {side * box.halfExtents.x, local.y};
+                depth          = circle.radius + distanceX;
+            } else {
+                const f32 side = local.y < 0.0f ? -1.0f : 1.0f;
+                localNormal    = {0.0f, side};
+                localPoint     = {local.x, side * box.halfExtents.y};
+                depth          = circle.radius + distanceY;
+            }
+        } else {
+            const Vec2 difference = local - clamped;
+            const f32 distanceSqr = glm::dot(difference, difference);
+            if (distanceSqr > circle.radius * circle.radius) return false;
+
+            const f32 distance = std::sqrt(distanceSqr);
+            localNormal        = difference / distance;
+            localPoint         = clamped;
+            depth              = circle.radius - distance;
+        }
+
+        outManifold.normal     = RotateVector(localNormal, cosine, sine);
+        outManifold.points[0]  = box.center + RotateVector(localPoint, cosine, sine);
+        outManifold.depths[0]  = depth;
+        outManifold.pointCount = 1;
+
+        return true;
+    }
+
+    bool
+    CollisionDetection::AABBVsAABB(const CollisionShape& a, const CollisionShape& b, ContactManifold& outManifold) {
+        const Vec2 delta   = b.center - a.center;
+        const Vec2 overlap = a.halfExtents + b.halfExtents - glm::abs(delta);
+        if (overlap.x < 0.0f || overlap.y < 0.0f) return false;
+
+        // Resolve along the axis of least penetration, contacts span the overlapping edge
+        const u32 axis  = overlap.x < overlap.y ? 0 : 1;
+        const u32 other = 1 - axis;
+        const f32 side  = delta[axis] < 0.0f ? -1.0f : 1.0f;
+
+        const f32 face = a.center[axis] + side * (a.halfExtents[axis] - overlap[axis] * 0.5f);
+        const f32 low  = std::max(a.center[other] - a.halfExtents[other], b.center[other] - b.halfExtents[other]);
+        const f32 high = std::min(a.center[other] + a.halfExtents[other], b.center[other] + b.halfExtents[other]);
+
+        outManifold.normal       = Vec2(0.0f);
+        outManifold.normal[axis] = side;
+
+        outManifold.points[0][axis]  = face;
+        outManifold.points[0][other] = low;
+        outManifold.points[1][axis]  = face;
+        outManifold.points[1][other] = high;
+        outManifold.depths[0]        = overlap[axis];
+        outManifold.depths[1]        = overlap[axis];
+        outManifold.pointCount       = high > low ? 2 : 1;
+
+        return true;
+    }
+
+    bool CollisionDetection::BoxVsBox(const CollisionShape& a, const CollisionShape& b, ContactManifold& outManifold) {
+        const OrientedBox boxA = MakeOrientedBox(a);
+        const OrientedBox boxB = MakeOrientedBox(b);
+
+        u32 axisA {}, axisB {};
+        f32 overlapA {}, overlapB {}, signA {}, signB {};
+        if (!FindMinOverlapAxis(boxA, boxB, axisA, overlapA, signA)) return false;
+        if (!FindMinOverlapAxis(boxB, boxA, axisB, overlapB, signB)) return false;
+
+        // Favor A as the reference box so the chosen face doesn't flicker between nearly equal axes
+        constexpr f32 kRelativeTolerance = 0.95f;
+        constexpr f32 kAbsoluteTolerance = 0.01f;
+        const bool flip = overlapB < kRelativeTolerance * overlapA - kAbsoluteTolerance;
+
+        const OrientedBox& reference = flip ? boxB : boxA;
+        const OrientedBox& incident  = flip ? boxA : boxB;
+        const u32 axis               = flip ? axisB : axisA;
+        const Vec2 normal            = reference.axes[axis] * (flip ? signB : signA);
+
+        // Incident face is the one most anti-parallel to the reference normal
+        u32 incidentAxis = 0;
+        f32 incidentSide = 1.0f;
+        f32 mostOpposed  = std::numeric_limits<f32>::max();
+        for (u32 i = 0; i < 2; ++i) {
+            const f32 alignment = glm::dot(incident.axes[i], normal);
+            if (alignment < mostOpposed) {
+                mostOpposed  = alignment;
+                incidentAxis = i;
+                incidentSide = 1.0f;
+            }
+            if (-alignment < mostOpposed) {
+                mostOpposed  = -alignment;
+                incidentAxis = i;
+                incidentSide = -1.0f;
+            }
+        }
+
+        const Vec2 faceCenter =
+          incident.center + incident.axes[incidentAxis] * (incidentSide * incident.half[incidentAxis]);
+        const Vec2 faceTangent     = incident.axes[1 - incidentAxis] * incident.half[1 - incidentAxis];
+        const Vec2 incidentEdge[2] = {faceCenter - faceTangent, faceCenter + faceTangent};
+
+        // Clip the incident edge against the side planes of the reference face
+        const Vec2 tangent      = reference.axes[1 - axis];
+        const f32 tangentCenter = glm::dot(tangent, reference.center);
+        const f32 tangentHalf   = reference.half[1 - axis];
+
+        Vec2 clipped[2], clippedTwice[2];
+        if (ClipSegment(incidentEdge, clipped, -tangent, -(tangentCenter - tangentHalf)) < 2) return false;
+        if (ClipSegment(clipped, clippedTwice, tangent, tangentCenter + tangentHalf) < 2) return false;
+
+        const f32 frontOffset = glm::dot(normal, reference.center) + reference.half[axis];
+
+        u32 count = 0;
+        for (const auto& point : clippedTwice) {
+            const f32 separation = glm::dot(normal, point) - frontOffset;
+            if (separation <= 0.0f) {
+                outManifold.points[count] = point - normal * (separation * 0.5f);
+                outManifold.depths[count] = -separation;
+                ++count;
+            }
+        }
+
+        outManifold.normal     = flip ? -normal : normal;
+        outManifold.pointCount = count;
+
+        return count > 0;
+    }
+}  // namespace Astera
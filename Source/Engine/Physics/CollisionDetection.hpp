@@ -28,6 +28,134 @@
 
 #pragma once
 
+#include "EngineCommon.hpp"
+#include "Components/Collider2D.hpp"
+
 namespace Astera {
-    class CollisionDetection {};
+    /// @brief Axis-aligned bounding box in world space
+    struct AABB {
+        Vec2 min {0.0f};
+        Vec2 max {0.0f};
+
+        ASTERA_KEEP bool Overlaps(const AABB& other) const {
+            return min.x <= other.max.x && max.x >= other.min.x && min.y <= other.max.y && max.y >= other.min.y;
+        }
+
+        ASTERA_KEEP bool Contains(const AABB& other) const {
+            return min.x <= other.min.x && min.y <= other.min.y && max.x >= other.max.x && max.y >= other.max.y;
+        }
+
+        ASTERA_KEEP AABB Expanded(f32 margin) const {
+            return {min - Vec2(margin), max + Vec2(margin)};
+        }
+
+        ASTERA_KEEP f32 Perimeter() const {
+            return 2.0f * ((max.x - min.x) + (max.y - min.y));
+        }
+
+        /// @brief Tests the segment from `origin` to `origin + translation` against the box
+        ASTERA_KEEP bool IntersectsSegment(const Vec2& origin, const Vec2& translation) const {
+            f32 enter = 0.0f;
+            f32 exit  = 1.0f;
+            for (i32 axis = 0; axis < 2; ++axis) {
+                if (translation[axis] == 0.0f) {
+                    if (origin[axis] < min[axis] || origin[axis] > max[axis]) return false;
+                    continue;
+                }
+
+                const f32 inverse = 1.0f / translation[axis];
+                f32 t0            = (min[axis] - origin[axis]) * inverse;
+                f32 t1            = (max[axis] - origin[axis]) * inverse;
+                if (t0 > t1) { std::swap(t0, t1); }
+
+                enter = std::max(enter, t0);
+                exit  = std::min(exit, t1);
+                if (enter > exit) return false;
+            }
+
+            return true;
+        }
+
+        static AABB Union(const AABB& a, const AABB& b) {
+            return {glm::min(a.min, b.min), glm::max(a.max, b.max)};
+        }
+    };
+
+    /// @brief Collider resolved into world space for a single simulation step
+    struct CollisionShape {
+        ColliderShape type {ColliderShape::AABB};
+        Vec2 center {0.0f};
+        Vec2 halfExtents {0.0f};  ///< Box shapes only
+        f32 radius {0.0f};        ///< Circle shapes only
+        f32 rotation {0.0f};      ///< Radians, always zero for AABB shapes
+    };
+
+    /// @brief Result of a narrowphase test between two shapes
+    struct ContactManifold {
+        Vec2 normal {0.0f};  ///< Points from shape A towards shape B
+        Vec2 points[2] {};   ///< World-space contact points
+        f32 depths[2] {};    ///< Penetration depth at each contact point
+        u32 pointCount {0};
+    };
+
+    /// @brief Narrowphase collision tests for AABB, circle and oriented box shapes
+    class CollisionDetection {
+    public:
+        /// @brief Builds a world-space shape from a collider and the owning transform
+        /// @param collider Collider component
+        /// @param position Transform position
+        /// @param rotation Transform rotation in radians
+        /// @param scale Transform scale
+        static CollisionShape
+        MakeShape(const Collider2D& collider, const Vec2& position, f32 rotation, const Vec2& scale);
+
+        /// @brief Computes the world-space bounds of a shape
+        static AABB ComputeBounds(const CollisionShape& shape);
+
+        /// @brief Tests two shapes for overlap and generates contact points
+        /// @param a First shape
+        /// @param b Second shape
+        /// @param outManifold Contact data, only valid when the shapes overlap
+        /// @return True if the shapes overlap
+        static bool Collide(const CollisionShape& a, const CollisionShape& b, ContactManifold& outManifold);
+
+        /// @brief Intersects the segment from `origin` to `origin + translation` with a shape
+        /// @param shape Shape to test
+        /// @param origin Start of the segment
+        /// @param translation Direction and length of the segment
+        /// @param outFraction Fraction of the translation at which the segment enters the shape
+        /// @param outNormal Surface normal at the entry point
+        /// @return True if the segment enters the shape, segments starting inside never hit
+        static bool Raycast(const CollisionShape& shape,
+                            const Vec2& origin,
+                            const Vec2& translation,
+                            f32& outFraction,
+                            Vec2& outNormal);
+
+        /// @brief Radius of the largest circle centered on the shape that fits inside it
+        static f32 InnerRadius(const CollisionShape& shape);
+
+        /// @brief Sweeps a shape along a translation and finds the first time it touches a stationary target
+        ///
+        /// The sweep is sampled at intervals of the moving shape's inner radius, which is close enough that no
+        /// target can fit between two samples, then the first overlap is refined by bisection. Rotation is held
+        /// fixed over the sweep.
+        /// @param shape Moving shape at the start of the sweep
+        /// @param translation Distance moved over the sweep
+        /// @param target Stationary shape
+        /// @param tolerance Allowed penetration at the returned time, in world units
+        /// @param outFraction Fraction of the translation at which the shapes first overlap
+        /// @return True if the shapes touch during the sweep but not at its start
+        static bool TimeOfImpact(const CollisionShape& shape,
+                                 const Vec2& translation,
+                                 const CollisionShape& target,
+                                 f32 tolerance,
+                                 f32& outFraction);
+
+    private:
+        static bool CircleVsCircle(const CollisionShape& a, const CollisionShape& b, ContactManifold& outManifold);
+        static bool BoxVsCircle(const CollisionShape& box, const CollisionShape& circle, ContactManifold& outManifold);
+        static bool AABBVsAABB(const CollisionShape& a, const CollisionShape& b, ContactManifold& outManifold);
+        static bool BoxVsBox(const CollisionShape& a, const CollisionShape& b, ContactManifold& outManifold);
+    };
 }  // namespace Astera
@@ -27,6 +27,1051 @@
  */
 
 #include "PhysicsEngine.hpp"
+#include "JobSystem.hpp"
+
+#include <algorithm>
+#include <chrono>
 
 namespace Astera {
-} // Astera
\ No newline at end of file
+    /// @brief 2D cross product of two vectors
+    static f32 Cross(const Vec2& a, const Vec2& b) {
+        return a.x * b.y - a.y * b.x;
+    }
+
+    /// @brief 2D cross product of a scalar (angular velocity) and a vector
+    static Vec2 Cross(f32 w, const Vec2& r) {
+        return {-w * r.y, w * r.x};
+    }
+
+    void PhysicsEngine::BodyBuffers::Clear() {
+        entity.clear();
+        flags.clear();
+        type.clear();
+        position.clear();
+        rotation.clear();
+        scale.clear();
+        velocity.clear();
+        angularVelocity.clear();
+        force.clear();
+        acceleration.clear();
+        torque.clear();
+        angularAcceleration.clear();
+        inverseMass.clear();
+        inverseInertia.clear();
+        restitution.clear();
+        friction.clear();
+        linearDamping.clear();
+        angularDamping.clear();
+        gravityScale.clear();
+        restingSteps.clear();
+        collider.clear();
+        shape.clear();
+        bounds.clear();
+        transform.clear();
+    }
+
+    void PhysicsEngine::BodyBuffers::Reserve(size_t count) {
+        entity.reserve(count);
+        flags.reserve(count);
+        type.reserve(count);
+        position.reserve(count);
+        rotation.reserve(count);
+        scale.reserve(count);
+        velocity.reserve(count);
+        angularVelocity.reserve(count);
+        force.reserve(count);
+        acceleration.reserve(count);
+        torque.reserve(count);
+        angularAcceleration.reserve(count);
+        inverseMass.reserve(count);
+        inverseInertia.reserve(count);
+        restitution.reserve(count);
+        friction.reserve(count);
+        linearDamping.reserve(count);
+        angularDamping.reserve(count);
+        gravityScale.reserve(count);
+        restingSteps.reserve(count);
+        collider.reserve(count);
+        shape.reserve(count);
+        bounds.reserve(count);
+        transform.reserve(count);
+    }
+
+    void PhysicsEngine::BodyBuffers::Resize(size_t count) {
+        entity.resize(count);
+        flags.resize(count);
+        type.resize(count);
+        position.resize(count);
+        rotation.resize(count);
+        scale.resize(count);
+        velocity.resize(count);
+        angularVelocity.resize(count);
+        force.resize(count);
+        acceleration.resize(count);
+        torque.resize(count);
+        angularAcceleration.resize(count);
+        inverseMass.resize(count);
+        inverseInertia.resize(count);
+        restitution.resize(count);
+        friction.resize(count);
+        linearDamping.resize(count);
+        angularDamping.resize(count);
+        gravityScale.resize(count);
+        restingSteps.resize(count);
+        collider.resize(count);
+        shape.resize(count);
+        bounds.resize(count);
+        transform.resize(count);
+    }
+
+    /// @brief Visits every body of a scene in the order GatherBodies lays them out, stops when `func` returns false
+    /// @returns False if `func` stopped the walk
+    template<typename Func>
+    static bool ForEachSceneBody(SceneState& state, Func&& func) {
+        for (auto [entity, transform, rigidbody] : state.View<Transform, Rigidbody2D>().each()) {
+            if (!func(entity, transform, &rigidbody, state.TryGetComponent<Collider2D>(entity))) return false;
+        }
+
+        for (auto [entity, transform, collider] : state.View<Transform, Collider2D>().each()) {
+            if (state.HasComponent<Rigidbody2D>(entity)) continue;
+
+            // Static colliders can ride on a parent, they collide where the cached world transform puts them
+            if (state.GetParent(entity) != entt::null) {
+                const auto& world = state.GetWorldTransform(entity);
+                const Transform worldTransform {world.position, {world.rotation, 0.0f}, world.scale};
+                if (!func(entity, worldTransform, nullptr, &collider)) return false;
+                continue;
+            }
+
+            if (!func(entity, transform, nullptr, &collider)) return false;
+        }
+
+        return true;
+    }
+
+    void PhysicsEngine::Update(SceneState& state, f32 deltaTime) {
+        mAccumulator += deltaTime;
+        mContactEvents.clear();
+
+        u32 steps = 0;
+        while (mAccumulator >= mSettings.fixedTimeStep && steps < mSettings.maxStepsPerUpdate) {
+            mAccumulator -= mSettings.fixedTimeStep;
+            ++steps;
+        }
+
+        // Only time the step limit left behind is dropped, an update that just caught up keeps its remainder
+        if (mAccumulator >= mSettings.fixedTimeStep) { mAccumulator = 0.0f; }
+
+        mStats.steps         = steps;
+        mStats.contactEvents = 0;
+        if (steps == 0) return;
+
+        const auto start = std::chrono::steady_clock::now();
+
+        if (!RefreshBodies(state)) { GatherBodies(state); }
+        for (u32 i = 0; i < steps; ++i) {
+            Simulate(mSettings.fixedTimeStep);
+        }
+        WriteBack(state);
+
+        const auto end       = std::chrono::steady_clock::now();
+        mStats.updateTime    = std::chrono::duration<f32, std::milli>(end - start).count();
+        mStats.contactEvents = CAST<u32>(mContactEvents.size());
+    }
+
+    void PhysicsEngine::Step(SceneState& state, f32 timeStep) {
+        const auto start = std::chrono::steady_clock::now();
+
+        mContactEvents.clear();
+        if (!RefreshBodies(state)) { GatherBodies(state); }
+        Simulate(timeStep);
+        WriteBack(state);
+
+        const auto end       = std::chrono::steady_clock::now();
+        mStats.steps         = 1;
+        mStats.updateTime    = std::chrono::duration<f32, std::milli>(end - start).count();
+        mStats.contactEvents = CAST<u32>(mContactEvents.size());
+    }
+
+    void PhysicsEngine::Reset() {
+        mAccumulator = 0.0f;
+        mBodies.Clear();
+        mContacts.clear();
+        mPairs.clear();
+        mActiveBodies.clear();
+        mKinematicBodies.clear();
+        mFellAsleep.clear();
+        mWoken.clear();
+        mBullets.clear();
+        mIslands.clear();
+        mTouching.clear();
+        mContactEvents.clear();
+        mBodyOfEntity.clear();
+        if (mBroadphase) { mBroadphase->Clear(); }
+        mColliderCount = 0;
+        mStats         = {};
+    }
+
+    void PhysicsEngine::GatherBodies(SceneState& state) {
+        mBodies.Clear();
+        mBodies.Reserve(state.View<Rigidbody2D>().size_hint() + state.View<Collider2D>().size_hint());
+        mActiveBodies.clear();
+        mKinematicBodies.clear();
+        mFellAsleep.clear();
+        mWoken.clear();
+        mBullets.clear();
+
+        const auto addBody = [this](Entity entity,
+                                    const Transform& transform,
+                                    const Rigidbody2D* rigidbody,
+                                    const Collider2D* collider) {
+            const u32 index = CAST<u32>(mBodies.Size());
+            mBodies.Resize(index + 1);
+            ReadBody(index, entity, transform, rigidbody, collider);
+
+            const BodyType type = mBodies.type[index];
+            if ((mBodies.flags[index] & kFlagAwake) || type == BodyType::Kinematic) { mActiveBodies.push_back(index); }
+            if (type == BodyType::Kinematic) { mKinematicBodies.push_back(index); }
+            if (mBodies.flags[index] & kFlagBullet) { mBullets.push_back(index); }
+            return true;
+        };
+
+        ForEachSceneBody(state, addBody);
+
+        mIslandParents.resize(mBodies.Size());
+        mIslandOfRoot.assign(mBodies.Size(), -1);
+
+        std::ranges::fill(mBodyOfEntity, std::numeric_limits<u32>::max());
+        for (u32 i = 0; i < mBodies.Size(); ++i) {
+            const auto slot = entt::to_entity(mBodies.entity[i]);
+            if (slot >= mBodyOfEntity.size()) { mBodyOfEntity.resize(slot + 1, std::numeric_limits<u32>::max()); }
+            mBodyOfEntity[slot] = i;
+        }
+        mBulletStarts.resize(mBullets.size());
+
+        // Body indices change with every gather, so every proxy is resubmitted once here
+        EnsureBroadphase();
+        mProxies.clear();
+        for (u32 i = 0; i < mBodies.Size(); ++i) {
+            if (mBodies.flags[i] & kFlagCollider) { mProxies.push_back(MakeProxy(i)); }
+        }
+        mBroadphase->Synchronize(mProxies);
+        mColliderCount = CAST<u32>(mProxies.size());
+
+        mStats.bodies = CAST<u32>(mBodies.Size());
+    }
+
+    bool PhysicsEngine::RefreshBodies(SceneState& state) {
+        if (!mBroadphase || mBroadphaseType != mSettings.broadphase) return false;
+
+        // Proxies of bodies moved from outside, awake bodies are resubmitted by every step anyway
+        mProxies.clear();
+
+        u32 index              = 0;
+        const auto refreshBody = [this, &index](Entity entity,
+                                                const Transform& transform,
+                                                const Rigidbody2D* rigidbody,
+                                                const Collider2D* collider) {
+            // The scene walks bodies in the order they were gathered, so any difference means bodies were added,
+            // removed or reordered
+            if (index >= mBodies.Size() || mBodies.entity[index] != entity) return false;
+
+            const u16 flags = mBodies.flags[index];
+            if (CAST<bool>(flags & kFlagRigidbody) != (rigidbody != nullptr) ||
+                CAST<bool>(flags & kFlagCollider) != (collider != nullptr)) {
+                return false;
+            }
+
+            // The kinematic, bullet and active lists depend on these
+            const BodyType type = rigidbody ? rigidbody->type : BodyType::Static;
+            const bool bullet   = type == BodyType::Dynamic && collider && rigidbody->bullet;
+            if (type != mBodies.type[index] || bullet != CAST<bool>(flags & kFlagBullet)) return false;
+
+            const bool moved =
+              transform != mBodies.transform[index] || (collider && *collider != mBodies.collider[index]);
+            if (moved) {
+                ReadBody(index, entity, transform, rigidbody, collider);
+            } else if (type != BodyType::Static) {
+                ReadRigidbody(index, transform.scale, rigidbody, collider);
+            }
+
+            // Scripts may wake a body, putting one to sleep would also have to take its proxy out of the pairs
+            const bool wasAwake = flags & kFlagAwake;
+            const bool awake    = mBodies.flags[index] & kFlagAwake;
+            if (wasAwake && !awake) return false;
+            if (awake && !wasAwake) { mActiveBodies.push_back(index); }
+
+            if (moved && collider) { mProxies.push_back(MakeProxy(index)); }
+
+            ++index;
+            return true;
+        };
+
+        const bool same = ForEachSceneBody(state, refreshBody);
+        if (!same || index != mBodies.Size()) return false;
+
+        if (!mProxies.empty()) { mBroadphase->Update(mProxies); }
+        return true;
+    }
+
+    void PhysicsEngine::ReadBody(u32 body,
+                                 Entity entity,
+                                 const Transform& transform,
+                                 const Rigidbody2D* rigidbody,
+                                 const Collider2D* collider) {
+        mBodies.entity[body]    = entity;
+        mBodies.transform[body] = transform;
+        mBodies.position[body]  = transform.position;
+        mBodies.rotation[body]  = glm::radians(transform.rotation.x);
+        mBodies.scale[body]     = transform.scale;
+        mBodies.collider[body]  = collider ? *collider : Collider2D {};
+
+        ReadRigidbody(body, transform.scale, rigidbody, collider);
+
+        // Sleeping and static bodies don't move on their own, so their shapes are only built when read
+        CollisionShape shape {};
+        AABB bounds {};
+        if (collider) {
+            shape  = CollisionDetection::MakeShape(
+              *collider, transform.position, glm::radians(transform.rotation.x), transform.scale);
+            bounds = CollisionDetection::ComputeBounds(shape);
+        }
+        mBodies.shape[body]  = shape;
+        mBodies.bounds[body] = bounds;
+    }
+
+    void PhysicsEngine::ReadRigidbody(u32 body,
+                                      const Vec2& scale,
+                                      const Rigidbody2D* rigidbody,
+                                      const Collider2D* collider) {
+        const BodyType type = rigidbody ? rigidbody->type : BodyType::Static;
+        const bool dynamic  = type == BodyType::Dynamic;
+
+        // Scripts may set velocity directly on a sleeping body, treat that as a wake-up
+        const bool awake = dynamic && (rigidbody->awake || !rigidbody->allowSleep || !mSettings.enableSleeping ||
+                                       rigidbody->velocity != Vec2(0.0f) || rigidbody->angularVelocity != 0.0f);
+
+        // The broadphase state is only changed by MakeProxy
+        u16 flags = mBodies.flags[body] & kFlagMovable;
+        if (collider) flags |= kFlagCollider;
+        if (collider && collider->isTrigger) flags |= kFlagTrigger;
+        if (rigidbody) flags |= kFlagRigidbody;
+        if (rigidbody && rigidbody->lockRotation) flags |= kFlagLockRotation;
+        if (rigidbody && rigidbody->allowSleep) flags |= kFlagAllowSleep;
+        if (awake) flags |= kFlagAwake;
+        if (dynamic && collider && rigidbody->bullet) flags |= kFlagBullet;
+
+        mBodies.flags[body]               = flags;
+        mBodies.type[body]                = type;
+        mBodies.velocity[body]            = rigidbody ? rigidbody->velocity : Vec2(0.0f);
+        mBodies.angularVelocity[body]     = rigidbody ? rigidbody->angularVelocity : 0.0f;
+        mBodies.force[body]               = rigidbody ? rigidbody->force : Vec2(0.0f);
+        mBodies.acceleration[body]        = rigidbody ? rigidbody->acceleration : Vec2(0.0f);
+        mBodies.torque[body]              = rigidbody ? rigidbody->torque : 0.0f;
+        mBodies.angularAcceleration[body] = rigidbody ? rigidbody->angularAcceleration : 0.0f;
+        mBodies.restitution[body]         = rigidbody ? rigidbody->restitution : 0.0f;
+        mBodies.friction[body]            = rigidbody ? rigidbody->friction : 0.5f;
+        mBodies.linearDamping[body]       = rigidbody ? rigidbody->linearDamping : 0.0f;
+        mBodies.angularDamping[body]      = rigidbody ? rigidbody->angularDamping : 0.0f;
+        mBodies.gravityScale[body]        = rigidbody ? rigidbody->gravityScale : 0.0f;
+        mBodies.restingSteps[body]        = rigidbody && rigidbody->awake ? rigidbody->restingSteps : 0;
+
+        // Only dynamic bodies respond to impulses, inertia is derived from the collider when there is one
+        const f32 inverseMass = dynamic ? rigidbody->inverseMass : 0.0f;
+        f32 inverseInertia    = dynamic ? rigidbody->inverseInertia : 0.0f;
+
+        if (dynamic && collider && rigidbody->mass > 0.0f) {
+            const Vec2 absScale = glm::abs(scale);
+            f32 inertia;
+            if (collider->shape == ColliderShape::Circle) {
+                const f32 radius = collider->radius * std::max(absScale.x, absScale.y);
+                inertia          = 0.5f * rigidbody->mass * radius * radius;
+            } else {
+                const Vec2 size = collider->size * absScale;
+                inertia         = rigidbody->mass * (size.x * size.x + size.y * size.y) / 12.0f;
+            }
+            inverseInertia = inertia > 0.0f ? 1.0f / inertia : 0.0f;
+        }
+
+        // AABB shapes ignore rotation, letting those bodies spin would only make them drift sideways
+        if ((flags & kFlagLockRotation) || (collider && collider->shape == ColliderShape::AABB)) {
+            inverseInertia = 0.0f;
+        }
+
+        mBodies.inverseMass[body]    = inverseMass;
+        mBodies.inverseInertia[body] = inverseInertia;
+    }
+
+    void PhysicsEngine::WriteBack(SceneState& state) {
+        for (size_t i = 0; i < mBodies.Size(); ++i) {
+            if (!(mBodies.flags[i] & kFlagRigidbody)) continue;
+
+            auto& rigidbody = state.GetComponent<Rigidbody2D>(mBodies.entity[i]);
+            rigidbody.ClearForces();
+
+            if (mBodies.type[i] == BodyType::Static) continue;
+
+            rigidbody.velocity        = mBodies.velocity[i];
+            rigidbody.angularVelocity = mBodies.angularVelocity[i];
+
+            if (mBodies.type[i] == BodyType::Dynamic) {
+                rigidbody.awake        = mBodies.flags[i] & kFlagAwake;
+                rigidbody.restingSteps = mBodies.restingSteps[i];
+            }
+
+            auto& transform      = state.GetTransform(mBodies.entity[i]);
+            transform.position   = mBodies.position[i];
+            transform.rotation.x = glm::degrees(mBodies.rotation[i]);
+            mBodies.transform[i] = transform;
+        }
+    }
+
+    void PhysicsEngine::Simulate(f32 timeStep) {
+        for (size_t i = 0; i < mBullets.size(); ++i) {
+            mBulletStarts[i] = mBodies.position[mBullets[i]];
+        }
+
+        IntegrateVelocities(timeStep);
+        UpdateShapes();
+        UpdateBroadphase();
+        DetectCollisions();
+        WakeTouchedBodies();
+        BuildIslands();
+
+        ParallelFor(0, mIslands.size(), [this, timeStep](size_t i) { SolveIsland(mIslands[i], timeStep); });
+
+        IntegratePositions(mKinematicBodies, timeStep);
+        UpdateActiveBodies();
+        SolveContinuous(timeStep);
+        UpdateContactEvents();
+    }
+
+    void PhysicsEngine::IntegrateVelocities(f32 timeStep) {
+        for (const u32 i : mActiveBodies) {
+            if (mBodies.type[i] != BodyType::Dynamic) continue;
+
+            const Vec2 linearAcceleration = mSettings.gravity * mBodies.gravityScale[i] +
+                                            mBodies.force[i] * mBodies.inverseMass[i] + mBodies.acceleration[i];
+            const f32 angularAcceleration =
+              mBodies.torque[i] * mBodies.inverseInertia[i] + mBodies.angularAcceleration[i];
+
+            mBodies.velocity[i] += linearAcceleration * timeStep;
+            mBodies.angularVelocity[i] += angularAcceleration * timeStep;
+
+            // Pade approximation of exponential decay, stable for large damping values
+            mBodies.velocity[i] *= 1.0f / (1.0f + timeStep * mBodies.linearDamping[i]);
+            mBodies.angularVelocity[i] *= 1.0f / (1.0f + timeStep * mBodies.angularDamping[i]);
+
+            if (mBodies.flags[i] & kFlagLockRotation) { mBodies.angularVelocity[i] = 0.0f; }
+        }
+    }
+
+    void PhysicsEngine::UpdateShapes() {
+        for (const u32 i : mActiveBodies) {
+            if (!(mBodies.flags[i] & kFlagCollider)) continue;
+
+            mBodies.shape[i] = CollisionDetection::MakeShape(
+              mBodies.collider[i], mBodies.position[i], mBodies.rotation[i], mBodies.scale[i]);
+            mBodies.bounds[i] = CollisionDetection::ComputeBounds(mBodies.shape[i]);
+        }
+    }
+
+    void PhysicsEngine::EnsureBroadphase() {
+        if (mBroadphase && mBroadphaseType == mSettings.broadphase) return;
+
+        mBroadphaseType = mSettings.broadphase;
+        if (mBroadphaseType == BroadphaseType::SweepAndPrune) {
+            mBroadphase = make_unique<SweepAndPrune>();
+        } else {
+            mBroadphase = make_unique<DynamicAABBTree>(mSettings.broadphaseMargin);
+        }
+    }
+
+    BroadphaseProxy PhysicsEngine::MakeProxy(u32 body) {
+        u16& flags = mBodies.flags[body];
+
+        // Only proxies that can start a contact search for pairs, the rest are found by them. Pairs where
+        // neither side moves only matter for triggers.
+        bool movable = flags & kFlagTrigger;
+        if (mBodies.type[body] == BodyType::Dynamic) {
+            movable |= CAST<bool>(flags & kFlagAwake);
+        } else if (mBodies.type[body] == BodyType::Kinematic) {
+            movable |= mBodies.velocity[body] != Vec2(0.0f) || mBodies.angularVelocity[body] != 0.0f;
+        }
+
+        if (movable) {
+            flags |= kFlagMovable;
+        } else {
+            flags &= ~kFlagMovable;
+        }
+
+        return {entt::to_integral(mBodies.entity[body]), body, mBodies.bounds[body], !movable};
+    }
+
+    void PhysicsEngine::UpdateBroadphase() {
+        mProxies.clear();
+        for (const u32 i : mActiveBodies) {
+            if (mBodies.flags[i] & kFlagCollider) { mProxies.push_back(MakeProxy(i)); }
+        }
+        for (const u32 i : mFellAsleep) {
+            mProxies.push_back(MakeProxy(i));
+        }
+        mFellAsleep.clear();
+
+        mBroadphase->Update(mProxies);
+        mBroadphase->FindPairs(mPairs);
+
+        const BroadphaseStats stats = mBroadphase->GetStats();
+        mStats.candidatePairs       = stats.candidatePairs;
+        mStats.broadphaseMemory     = stats.memoryBytes;
+    }
+
+    void PhysicsEngine::DetectCollisions() {
+        mContacts.clear();
+        mStats.pairsTested = 0;
+
+        for (const auto& [a, b] : mPairs) {
+            const bool trigger = (mBodies.flags[a] | mBodies.flags[b]) & kFlagTrigger;
+            if (!trigger && mBodies.type[a] != BodyType::Dynamic && mBodies.type[b] != BodyType::Dynamic) continue;
+            if (!ShouldCollide(a, b) || !mBodies.bounds[a].Overlaps(mBodies.bounds[b])) continue;
+
+            ++mStats.pairsTested;
+
+            ContactManifold manifold;
+            if (!CollisionDetection::Collide(mBodies.shape[a], mBodies.shape[b], manifold)) continue;
+
+            AddContact(a, b, manifold);
+        }
+
+        mStats.contacts = CAST<u32>(mContacts.size());
+    }
+
+    void PhysicsEngine::AddContact(u32 a, u32 b, const ContactManifold& manifold) {
+        Contact contact {};
+        contact.a           = a;
+        contact.b           = b;
+        contact.normal      = manifold.normal;
+        contact.pointCount  = manifold.pointCount;
+        contact.friction    = std::sqrt(mBodies.friction[a] * mBodies.friction[b]);
+        contact.restitution = std::max(mBodies.restitution[a], mBodies.restitution[b]);
+        contact.trigger     = (mBodies.flags[a] | mBodies.flags[b]) & kFlagTrigger;
+
+        for (u32 p = 0; p < manifold.pointCount; ++p) {
+            contact.points[p].rA    = manifold.points[p] - mBodies.position[a];
+            contact.points[p].rB    = manifold.points[p] - mBodies.position[b];
+            contact.points[p].depth = manifold.depths[p];
+        }
+
+        mContacts.push_back(contact);
+        if (contact.trigger) return;
+
+        for (const u32 body : {a, b}) {
+            if (mBodies.type[body] != BodyType::Dynamic || (mBodies.flags[body] & kFlagAwake)) continue;
+
+            mBodies.flags[body] |= kFlagAwake;
+            mBodies.restingSteps[body] = 0;
+            mWoken.push_back(body);
+        }
+    }
+
+    void PhysicsEngine::WakeTouchedBodies() {
+        // A woken body was static in the broadphase this step, so its contacts with other static or sleeping
+        // proxies are missing. Find them now so it doesn't sink into whatever it was resting on, waking the rest
+        // of a stack in the same step.
+        for (size_t w = 0; w < mWoken.size(); ++w) {
+            const u32 body = mWoken[w];
+            mBodies.flags[body] |= kFlagVisited;
+
+            mQueryResults.clear();
+            mBroadphase->Query(mBodies.bounds[body], mQueryResults);
+
+            for (const u32 other : mQueryResults) {
+                // Movable proxies found their own pairs, visited bodies already tested against this one
+                if (other == body || (mBodies.flags[other] & (kFlagMovable | kFlagVisited))) continue;
+                if (!ShouldCollide(body, other) || !mBodies.bounds[body].Overlaps(mBodies.bounds[other])) continue;
+
+                ++mStats.pairsTested;
+
+                const u32 a = std::min(body, other);
+                const u32 b = std::max(body, other);
+
+                ContactManifold manifold;
+                if (!CollisionDetection::Collide(mBodies.shape[a], mBodies.shape[b], manifold)) continue;
+
+                AddContact(a, b, manifold);
+            }
+        }
+
+        for (const u32 body : mWoken) {
+            mBodies.flags[body] &= ~kFlagVisited;
+        }
+
+        mStats.contacts = CAST<u32>(mContacts.size());
+    }
+
+    bool PhysicsEngine::ShouldCollide(u32 a, u32 b) const {
+        const auto& colliderA = mBodies.collider[a];
+        const auto& colliderB = mBodies.collider[b];
+        return (colliderA.layer & colliderB.collisionMask) && (colliderB.layer & colliderA.collisionMask);
+    }
+
+    bool PhysicsEngine::IsResting(Entity entity) const {
+        const auto slot = entt::to_entity(entity);
+        if (slot >= mBodyOfEntity.size() || mBodyOfEntity[slot] >= mBodies.Size()) return false;
+
+        const u32 body = mBodyOfEntity[slot];
+        if (mBodies.entity[body] != entity || !(mBodies.flags[body] & kFlagCollider)) return false;
+
+        return !(mBodies.flags[body] & kFlagMovable);
+    }
+
+    u32 PhysicsEngine::FindIslandRoot(u32 body) {
+        while (mIslandParents[body] != body) {
+            mIslandParents[body] = mIslandParents[mIslandParents[body]];
+            body                 = mIslandParents[body];
+        }
+
+        return body;
+    }
+
+    void PhysicsEngine::BuildIslands() {
+        mIslands.clear();
+
+        const auto forEachAwakeBody = [this](auto&& func) {
+            for (const u32 body : mActiveBodies) {
+                if (mBodies.type[body] == BodyType::Dynamic) { func(body); }
+            }
+            for (const u32 body : mWoken) {
+                func(body);
+            }
+        };
+
+        forEachAwakeBody([this](u32 body) { mIslandParents[body] = body; });
+
+        // Static and kinematic bodies don't carry impulses between bodies, so they never join islands
+        for (const auto& contact : mContacts) {
+            if (contact.trigger) continue;
+            if (mBodies.type[contact.a] != BodyType::Dynamic || mBodies.type[contact.b] != BodyType::Dynamic) continue;
+
+            const u32 rootA = FindIslandRoot(contact.a);
+            const u32 rootB = FindIslandRoot(contact.b);
+            if (rootA != rootB) { mIslandParents[std::max(rootA, rootB)] = std::min(rootA, rootB); }
+        }
+
+        // Count island sizes, then lay bodies and contacts out contiguously per island
+        forEachAwakeBody([this](u32 body) {
+            const u32 root = FindIslandRoot(body);
+            if (mIslandOfRoot[root] < 0) {
+                mIslandOfRoot[root] = CAST<i32>(mIslands.size());
+                mIslands.push_back({});
+            }
+            ++mIslands[mIslandOfRoot[root]].bodyCount;
+        });
+
+        const auto islandOfContact = [this](const Contact& contact) {
+            const u32 body = mBodies.type[contact.a] == BodyType::Dynamic ? contact.a : contact.b;
+            return mIslandOfRoot[FindIslandRoot(body)];
+        };
+
+        for (const auto& contact : mContacts) {
+            if (!contact.trigger) { ++mIslands[islandOfContact(contact)].contactCount; }
+        }
+
+        u32 bodyOffset = 0, contactOffset = 0;
+        for (auto& island : mIslands) {
+            island.bodyStart    = bodyOffset;
+            island.contactStart = contactOffset;
+
+            bodyOffset += island.bodyCount;
+            contactOffset += island.contactCount;
+
+            // Counts are rebuilt as the ranges are filled
+            island.bodyCount    = 0;
+            island.contactCount = 0;
+        }
+
+        mIslandBodies.resize(bodyOffset);
+        mIslandContacts.resize(contactOffset);
+
+        forEachAwakeBody([this](u32 body) {
+            Island& island                                       = mIslands[mIslandOfRoot[FindIslandRoot(body)]];
+            mIslandBodies[island.bodyStart + island.bodyCount++] = body;
+        });
+
+        for (u32 i = 0; i < mContacts.size(); ++i) {
+            if (mContacts[i].trigger) continue;
+
+            Island& island                                               = mIslands[islandOfContact(mContacts[i])];
+            mIslandContacts[island.contactStart + island.contactCount++] = i;
+        }
+
+        forEachAwakeBody([this](u32 body) { mIslandOfRoot[FindIslandRoot(body)] = -1; });
+
+        mStats.islands = CAST<u32>(mIslands.size());
+    }
+
+    void PhysicsEngine::SolveIsland(Island& island, f32 timeStep) {
+        const std::span<const u32> bodies {mIslandBodies.data() + island.bodyStart, island.bodyCount};
+        const std::span<const u32> contacts {mIslandContacts.data() + island.contactStart, island.contactCount};
+
+        PrepareContacts(contacts);
+        SolveVelocities(contacts);
+        IntegratePositions(bodies, timeStep);
+        CorrectPositions(contacts);
+
+        island.asleep = UpdateSleep(bodies);
+    }
+
+    void PhysicsEngine::UpdateActiveBodies() {
+        mActiveBodies.clear();
+
+        for (const auto& island : mIslands) {
+            const std::span<const u32> bodies {mIslandBodies.data() + island.bodyStart, island.bodyCount};
+            if (!island.asleep) {
+                mActiveBodies.insert(mActiveBodies.end(), bodies.begin(), bodies.end());
+                continue;
+            }
+
+            for (const u32 body : bodies) {
+                if (mBodies.flags[body] & kFlagCollider) { mFellAsleep.push_back(body); }
+            }
+        }
+
+        mStats.awakeBodies = CAST<u32>(mActiveBodies.size());
+        mActiveBodies.insert(mActiveBodies.end(), mKinematicBodies.begin(), mKinematicBodies.end());
+        mWoken.clear();
+    }
+
+    void PhysicsEngine::SolveContinuous(f32 timeStep) {
+        mStats.bulletHits = 0;
+        if (!mSettings.enableContinuous) return;
+
+        // Bullets are rare, sweeping them one after another lets an impact push the body that was hit without
+        // racing other bullets
+        for (size_t i = 0; i < mBullets.size(); ++i) {
+            if (mBodies.flags[mBullets[i]] & kFlagAwake) { SweepBullet(mBullets[i], mBulletStarts[i], timeStep); }
+        }
+
+        // Bodies woken by an impact missed this step's islands, they are simulated from the next step on
+        mActiveBodies.insert(mActiveBodies.end(), mWoken.begin(), mWoken.end());
+        mStats.awakeBodies += CAST<u32>(mWoken.size());
+        mWoken.clear();
+
+        mStats.contacts = CAST<u32>(mContacts.size());
+    }
+
+    void PhysicsEngine::SweepBullet(u32 body, Vec2 start, f32 timeStep) {
+        const bool trigger = mBodies.flags[body] & kFlagTrigger;
+        const f32 rotation = mBodies.rotation[body];
+
+        const auto moveTo = [this, body, rotation](const Vec2& position) {
+            mBodies.position[body] = position;
+            mBodies.shape[body] =
+              CollisionDetection::MakeShape(mBodies.collider[body], position, rotation, mBodies.scale[body]);
+            mBodies.bounds[body] = CollisionDetection::ComputeBounds(mBodies.shape[body]);
+        };
+
+        // Contacts keep the lower body index first, the same as pairs from the broadphase
+        const auto addContact = [this, body](u32 other) {
+            const u32 a = std::min(body, other);
+            const u32 b = std::max(body, other);
+
+            ContactManifold manifold;
+            if (!CollisionDetection::Collide(mBodies.shape[a], mBodies.shape[b], manifold)) return false;
+
+            AddContact(a, b, manifold);
+            return true;
+        };
+
+        Vec2 end     = mBodies.position[body];
+        f32 timeLeft = timeStep;
+
+        for (u32 subStep = 0; subStep < mSettings.maxBulletSubSteps; ++subStep) {
+            moveTo(start);
+
+            // Short moves overlap the previous position, the discrete test can't miss anything along them
+            const Vec2 translation = end - start;
+            const f32 innerRadius  = CollisionDetection::InnerRadius(mBodies.shape[body]);
+            if (glm::dot(translation, translation) < innerRadius * innerRadius) break;
+
+            const AABB& bounds = mBodies.bounds[body];
+            mQueryResults.clear();
+            mBroadphase->Query(AABB::Union(bounds, {bounds.min + translation, bounds.max + translation}),
+                               mQueryResults);
+
+            f32 impact = 1.0f;
+            u32 target = body;
+            mSweptTriggers.clear();
+
+            for (const u32 other : mQueryResults) {
+                if (other == body || (mBodies.flags[other] & kFlagBullet) || !ShouldCollide(body, other)) continue;
+
+                f32 fraction;
+                if (!CollisionDetection::TimeOfImpact(
+                      mBodies.shape[body], translation, mBodies.shape[other], mSettings.penetrationSlop, fraction)) {
+                    continue;
+                }
+
+                // Triggers report the overlap but never stop the bullet
+                if (trigger || (mBodies.flags[other] & kFlagTrigger)) {
+                    mSweptTriggers.emplace_back(fraction, other);
+                } else if (fraction < impact) {
+                    impact = fraction;
+                    target = other;
+                }
+            }
+
+            for (const auto& [fraction, other] : mSweptTriggers) {
+                if (fraction > impact) continue;
+
+                moveTo(start + translation * fraction);
+                addContact(other);
+            }
+
+            if (target == body) break;
+
+            // Resolve the impact with the regular contact solver, then spend the remaining time at the new velocity
+            start = start + translation * impact;
+            moveTo(start);
+            if (addContact(target)) {
+                const u32 contact = CAST<u32>(mContacts.size() - 1);
+                PrepareContacts({&contact, 1});
+                SolveVelocities({&contact, 1});
+                ++mStats.bulletHits;
+            }
+
+            timeLeft *= 1.0f - impact;
+            end = start + mBodies.velocity[body] * timeLeft;
+
+            // Out of sub-steps, stop at the last impact rather than risk tunnelling with the rest of the motion
+            if (subStep + 1 == mSettings.maxBulletSubSteps) { end = start; }
+        }
+
+        moveTo(end);
+    }
+
+    void PhysicsEngine::UpdateContactEvents() {
+        const auto makeKey = [](Entity a, Entity b) {
+            return (CAST<u64>(entt::to_integral(a)) << 32) | entt::to_integral(b);
+        };
+        const auto firstOf  = [](u64 key) { return CAST<Entity>(CAST<u32>(key >> 32)); };
+        const auto secondOf = [](u64 key) { return CAST<Entity>(CAST<u32>(key)); };
+        const auto byKey = [](const TouchingPair& lhs, const TouchingPair& rhs) { return lhs.key < rhs.key; };
+
+        // Manifolds, swept impacts and multiple steps can all report the same pair, keep one entry per pair
+        mTouchingNext.clear();
+        for (const auto& contact : mContacts) {
+            u32 a = contact.a;
+            u32 b = contact.b;
+            if (entt::to_integral(mBodies.entity[b]) < entt::to_integral(mBodies.entity[a])) { std::swap(a, b); }
+
+            mTouchingNext.push_back({makeKey(mBodies.entity[a], mBodies.entity[b]),
+                                     mBodies.collider[a].layer,
+                                     mBodies.collider[b].layer,
+                                     contact.trigger});
+        }
+
+        std::ranges::sort(mTouchingNext, byKey);
+        const auto duplicates = std::ranges::unique(mTouchingNext, {}, &TouchingPair::key);
+        mTouchingNext.erase(duplicates.begin(), duplicates.end());
+
+        const auto pushEvent = [&](const TouchingPair& pair, ContactEventType type) {
+            mContactEvents.push_back(
+              {firstOf(pair.key), secondOf(pair.key), pair.layerA, pair.layerB, type, pair.trigger});
+        };
+
+        // Both lists are sorted, so a single merge walk finds the pairs that appeared and disappeared
+        const size_t touchingCount = mTouchingNext.size();
+        size_t previous = 0, current = 0;
+        while (previous < mTouching.size() || current < touchingCount) {
+            if (current == touchingCount ||
+                (previous < mTouching.size() && mTouching[previous].key < mTouchingNext[current].key)) {
+                // Pairs where neither side moved were never tested this step, they are still touching
+                const auto& pair = mTouching[previous++];
+                if (IsResting(firstOf(pair.key)) && IsResting(secondOf(pair.key))) {
+                    mTouchingNext.push_back(pair);
+                } else {
+                    pushEvent(pair, ContactEventType::End);
+                }
+            } else if (previous == mTouching.size() || mTouchingNext[current].key < mTouching[previous].key) {
+                pushEvent(mTouchingNext[current++], ContactEventType::Begin);
+            } else {
+                ++previous;
+                ++current;
+            }
+        }
+
+        std::inplace_merge(mTouchingNext.begin(),
+                           mTouchingNext.begin() + CAST<std::ptrdiff_t>(touchingCount),
+                           mTouchingNext.end(),
+                           byKey);
+        std::swap(mTouching, mTouchingNext);
+    }
+
+    void PhysicsEngine::PrepareContacts(std::span<const u32> contacts) {
+        for (const u32 index : contacts) {
+            auto& contact = mContacts[index];
+
+            const u32 a        = contact.a;
+            const u32 b        = contact.b;
+            const f32 mA       = mBodies.inverseMass[a];
+            const f32 mB       = mBodies.inverseMass[b];
+            const f32 iA       = mBodies.inverseInertia[a];
+            const f32 iB       = mBodies.inverseInertia[b];
+            const Vec2 normal  = contact.normal;
+            const Vec2 tangent = {normal.y, -normal.x};
+
+            for (u32 p = 0; p < contact.pointCount; ++p) {
+                auto& point = contact.points[p];
+
+                const f32 rnA        = Cross(point.rA, normal);
+                const f32 rnB        = Cross(point.rB, normal);
+                const f32 normalMass = mA + mB + iA * rnA * rnA + iB * rnB * rnB;
+                point.normalMass     = normalMass > 0.0f ? 1.0f / normalMass : 0.0f;
+
+                const f32 rtA         = Cross(point.rA, tangent);
+                const f32 rtB         = Cross(point.rB, tangent);
+                const f32 tangentMass = mA + mB + iA * rtA * rtA + iB * rtB * rtB;
+                point.tangentMass     = tangentMass > 0.0f ? 1.0f / tangentMass : 0.0f;
+
+                const Vec2 relativeVelocity = mBodies.velocity[b] + Cross(mBodies.angularVelocity[b], point.rB) -
+                                              mBodies.velocity[a] - Cross(mBodies.angularVelocity[a], point.rA);
+                const f32 closingSpeed = glm::dot(relativeVelocity, normal);
+
+                // Only bounce when closing fast enough, otherwise resting contacts jitter
+                point.velocityBias =
+                  closingSpeed < -mSettings.restitutionThreshold ? -contact.restitution * closingSpeed : 0.0f;
+                point.normalImpulse  = 0.0f;
+                point.tangentImpulse = 0.0f;
+            }
+        }
+    }
+
+    void PhysicsEngine::SolveVelocities(std::span<const u32> contacts) {
+        for (u32 iteration = 0; iteration < mSettings.velocityIterations; ++iteration) {
+            for (const u32 index : contacts) {
+                auto& contact = mContacts[index];
+
+                const u32 a        = contact.a;
+                const u32 b        = contact.b;
+                const f32 mA       = mBodies.inverseMass[a];
+                const f32 mB       = mBodies.inverseMass[b];
+                const f32 iA       = mBodies.inverseInertia[a];
+                const f32 iB       = mBodies.inverseInertia[b];
+                const Vec2 normal  = contact.normal;
+                const Vec2 tangent = {normal.y, -normal.x};
+
+                Vec2 vA = mBodies.velocity[a];
+                Vec2 vB = mBodies.velocity[b];
+                f32 wA  = mBodies.angularVelocity[a];
+                f32 wB  = mBodies.angularVelocity[b];
+
+                for (u32 p = 0; p < contact.pointCount; ++p) {
+                    auto& point = contact.points[p];
+
+                    // Friction, bounded by the normal impulse of the previous iteration
+                    Vec2 dv = vB + Cross(wB, point.rB) - vA - Cross(wA, point.rA);
+
+                    const f32 maxFriction = contact.friction * point.normalImpulse;
+                    f32 lambda            = -point.tangentMass * glm::dot(dv, tangent);
+                    const f32 newTangent  = glm::clamp(point.tangentImpulse + lambda, -maxFriction, maxFriction);
+                    lambda                = newTangent - point.tangentImpulse;
+                    point.tangentImpulse  = newTangent;
+
+                    Vec2 impulse = tangent * lambda;
+                    vA -= impulse * mA;
+                    wA -= iA * Cross(point.rA, impulse);
+                    vB += impulse * mB;
+                    wB += iB * Cross(point.rB, impulse);
+
+                    // Non-penetration
+                    dv = vB + Cross(wB, point.rB) - vA - Cross(wA, point.rA);
+
+                    lambda              = -point.normalMass * (glm::dot(dv, normal) - point.velocityBias);
+                    const f32 newNormal = std::max(point.normalImpulse + lambda, 0.0f);
+                    lambda              = newNormal - point.normalImpulse;
+                    point.normalImpulse = newNormal;
+
+                    impulse = normal * lambda;
+                    vA -= impulse * mA;
+                    wA -= iA * Cross(point.rA, impulse);
+                    vB += impulse * mB;
+                    wB += iB * Cross(point.rB, impulse);
+                }
+
+                // Static and kinematic bodies are shared between islands solved in parallel, never write them
+                if (mBodies.type[a] == BodyType::Dynamic) {
+                    mBodies.velocity[a]        = vA;
+                    mBodies.angularVelocity[a] = wA;
+                }
+                if (mBodies.type[b] == BodyType::Dynamic) {
+                    mBodies.velocity[b]        = vB;
+                    mBodies.angularVelocity[b] = wB;
+                }
+            }
+        }
+    }
+
+    void PhysicsEngine::IntegratePositions(std::span<const u32> bodies, f32 timeStep) {
+        for (const u32 i : bodies) {
+            mBodies.position[i] += mBodies.velocity[i] * timeStep;
+            mBodies.rotation[i] += mBodies.angularVelocity[i] * timeStep;
+        }
+    }
+
+    void PhysicsEngine::CorrectPositions(std::span<const u32> contacts) {
+        for (const u32 index : contacts) {
+            const auto& contact = mContacts[index];
+
+            const u32 a                = contact.a;
+            const u32 b                = contact.b;
+            const f32 totalInverseMass = mBodies.inverseMass[a] + mBodies.inverseMass[b];
+            if (totalInverseMass <= 0.0f) continue;
+
+            f32 depth = 0.0f;
+            for (u32 p = 0; p < contact.pointCount; ++p) {
+                depth = std::max(depth, contact.points[p].depth);
+            }
+
+            const f32 magnitude =
+              std::max(depth - mSettings.penetrationSlop, 0.0f) / totalInverseMass * mSettings.positionCorrection;
+            const Vec2 correction = contact.normal * magnitude;
+
+            if (mBodies.type[a] == BodyType::Dynamic) { mBodies.position[a] -= correction * mBodies.inverseMass[a]; }
+            if (mBodies.type[b] == BodyType::Dynamic) { mBodies.position[b] += correction * mBodies.inverseMass[b]; }
+        }
+    }
+
+    bool PhysicsEngine::UpdateSleep(std::span<const u32> bodies) {
+        if (!mSettings.enableSleeping) return false;
+
+        const f32 linearTolerance  = mSettings.sleepLinearVelocity * mSettings.sleepLinearVelocity;
+        const f32 angularTolerance = mSettings.sleepAngularVelocity * mSettings.sleepAngularVelocity;
+
+        u32 minRestingSteps = std::numeric_limits<u32>::max();
+        for (const u32 i : bodies) {
+            const Vec2& velocity = mBodies.velocity[i];
+            const f32 spin       = mBodies.angularVelocity[i];
+
+            if (!(mBodies.flags[i] & kFlagAllowSleep) || glm::dot(velocity, velocity) > linearTolerance ||
+                spin * spin > angularTolerance) {
+                mBodies.restingSteps[i] = 0;
+            } else {
+                mBodies.restingSteps[i] = std::min(mBodies.restingSteps[i] + 1, mSettings.stepsToSleep);
+            }
+
+            minRestingSteps = std::min(minRestingSteps, mBodies.restingSteps[i]);
+        }
+
+        // The island sleeps as a whole, a single moving body keeps everything it touches awake
+        if (minRestingSteps < mSettings.stepsToSleep) return false;
+
+        for (const u32 i : bodies) {
+            mBodies.flags[i] &= ~kFlagAwake;
+            mBodies.velocity[i]        = Vec2(0.0f);
+            mBodies.angularVelocity[i] = 0.0f;
+        }
+
+        return true;
+    }
+}  // namespace Astera
@@ -28,10 +28,411 @@
 
 #pragma once
 
+#include "EngineCommon.hpp"
+#include "SceneState.hpp"
+#include "Physics/Broadphase.hpp"
+#include "Physics/CollisionDetection.hpp"
+
+#include <span>
+
+namespace sol {
+    class state;
+}
+
 namespace Astera {
+    enum class BroadphaseType : u8 {
+        DynamicTree,
+        SweepAndPrune,
+    };
+
+    /// @brief Global simulation parameters
+    struct PhysicsSettings {
+        /// @brief Gravity acceleration in world units per second squared
+        Vec2 gravity {0.0f, -981.0f};
+
+        /// @brief Duration of a single simulation step in seconds, used by Update
+        ///
+        /// Game calls Step from its own fixed update instead, see WindowConfig::fixedUpdateRate.
+        f32 fixedTimeStep {1.0f / 60.0f};
+
+        /// @brief Upper bound on steps taken in one Update, excess time is dropped to avoid a spiral of death
+        u32 maxStepsPerUpdate {8};
+
+        /// @brief Sequential impulse iterations per step
+        u32 velocityIterations {8};
+
+        /// @brief Fraction of penetration removed per step by positional correction, range [0, 1]
+        f32 positionCorrection {0.8f};
+
+        /// @brief Penetration allowed before positional correction kicks in, in world units
+        f32 penetrationSlop {0.5f};
+
+        /// @brief Closing speeds below this value don't bounce, in world units per second
+        f32 restitutionThreshold {60.0f};
+
+        /// @brief Structure used to cull collider pairs, the dynamic tree suits scenes with mostly static geometry
+        BroadphaseType broadphase {BroadphaseType::DynamicTree};
+
+        /// @brief Margin added around dynamic tree leaves so small movements don't require reinsertion
+        f32 broadphaseMargin {4.0f};
+
+        /// @brief Puts resting islands to sleep so they cost nothing until something touches them
+        bool enableSleeping {true};
+
+        /// @brief Bodies slower than this are considered resting, in world units per second
+        f32 sleepLinearVelocity {5.0f};
+
+        /// @brief Bodies rotating slower than this are considered resting, in radians per second
+        f32 sleepAngularVelocity {0.05f};
+
+        /// @brief Steps every body in an island must stay resting before the island goes to sleep
+        u32 stepsToSleep {30};
+
+        /// @brief Sweeps bodies flagged as bullets between steps so they can't tunnel through thin colliders
+        bool enableContinuous {true};
+
+        /// @brief Impacts a single bullet may resolve in one step before the rest of its motion is dropped
+        u32 maxBulletSubSteps {4};
+    };
+
+    /// @brief Counters from the most recent update
+    struct PhysicsStats {
+        u32 bodies {0};
+        u32 awakeBodies {0};
+        u32 islands {0};
+        u32 contacts {0};
+        u32 candidatePairs {0};  ///< Pairs reported by the broadphase
+        u32 pairsTested {0};     ///< Candidate pairs whose tight bounds overlap
+        u32 bulletHits {0};      ///< Impacts resolved by the bullet sweep
+        u32 contactEvents {0};   ///< Begin and end events raised by the last update
+        u32 steps {0};
+        f32 updateTime {0.0f};  ///< Milliseconds spent in the last update
+        size_t broadphaseMemory {0};
+    };
+
+    /// @brief Filters applied by every spatial query
+    struct QueryFilter {
+        Entity ignore {entt::null};  ///< Left out of the results, usually the entity asking
+        bool includeTriggers {true};
+        u32 layers {0xFFFFFFFF};  ///< Only colliders on one of these layers are reported
+    };
+
+    struct RaycastQuery {
+        Vec2 origin {0.0f};
+        Vec2 direction {1.0f, 0.0f};  ///< Normalized by the query
+        f32 maxDistance {0.0f};
+    };
+
+    /// @brief Closest collider crossed by a ray, `entity` is null when nothing was hit
+    struct RaycastHit {
+        Entity entity {entt::null};
+        Vec2 point {0.0f};
+        Vec2 normal {0.0f};
+        f32 distance {0.0f};
+    };
+
+    struct CircleQuery {
+        Vec2 center {0.0f};
+        f32 radius {0.0f};
+    };
+
+    enum class ContactEventType : u8 {
+        Begin,
+        End,
+    };
+
+    /// @brief Two colliders that started or stopped touching, `a` is always the lower entity id
+    struct ContactEvent {
+        Entity a;
+        Entity b;
+        u32 layerA;  ///< Copied so events can still be filtered after an entity is destroyed
+        u32 layerB;
+        ContactEventType type;
+        bool trigger;
+    };
+
+    /// @brief Native rigid body simulation for Rigidbody2D and Collider2D components
+    ///
+    /// Bodies are gathered from the scene into structure-of-arrays buffers that are kept between updates. Each update
+    /// refreshes them from the components, advances them with as many fixed steps as the accumulated frame time
+    /// allows and then writes the results back to Transform and Rigidbody2D. The buffers and broadphase proxies are
+    /// only rebuilt when bodies are added or removed, change type, or are put to sleep from outside the simulation,
+    /// and a body moved from outside only rebuilds its own shape and proxy. Entities with a Collider2D but no
+    /// Rigidbody2D are treated as static geometry.
+    ///
+    /// Dynamic bodies connected by contacts form islands that are solved in parallel. An island whose bodies have
+    /// all been resting for PhysicsSettings::stepsToSleep steps goes to sleep and is skipped until an awake body
+    /// touches it, so the cost of a step follows the number of awake bodies.
+    ///
+    /// Bodies flagged as bullets are swept from their start-of-step position once the islands are solved. Each
+    /// impact found along the sweep is resolved as a contact and the bullet continues with the remaining time, so
+    /// fast projectiles hit thin colliders without shrinking the step for everything else.
+    ///
+    /// Touching collider pairs are diffed against the previous step to produce contact begin and end events. A pair
+    /// is reported once per change no matter how many points or steps it spans, and pairs that stop being tested
+    /// because both sides are asleep or static stay touching until one of them moves again.
+    ///
+    /// Spatial queries run against the colliders as they were at the end of the last update and only read
+    /// simulation state, so the batched forms spread queries over the job system. Queries must not overlap an
+    /// update.
+    class PhysicsEngine {
+    public:
+        PhysicsEngine() = default;
+        explicit PhysicsEngine(const PhysicsSettings& settings) : mSettings(settings) {}
+
+        ASTERA_CLASS_PREVENT_MOVES_COPIES(PhysicsEngine)
+
+        /// @brief Accumulates frame time and runs the fixed steps that are due
+        /// @param state Scene to simulate
+        /// @param deltaTime Frame time in seconds
+        void Update(SceneState& state, f32 deltaTime);
+
+        /// @brief Runs exactly one step of the given length, ignoring the accumulator
+        /// @param state Scene to simulate
+        /// @param timeStep Step length in seconds
+        void Step(SceneState& state, f32 timeStep);
+
+        /// @brief Discards accumulated time, call when switching scenes
+        void Reset();
+
+        ASTERA_KEEP PhysicsSettings& GetSettings() {
+            return mSettings;
+        }
+
+        ASTERA_KEEP const PhysicsStats& GetStats() const {
+            return mStats;
+        }
+
+        /// @brief Contacts that began or ended during the most recent update or step, in step order
+        ASTERA_KEEP std::span<const ContactEvent> GetContactEvents() const {
+            return mContactEvents;
+        }
+
+        /// @brief Finds the closest collider crossed by a ray
+        /// @return True if something was hit
+        bool Raycast(const RaycastQuery& query, RaycastHit& outHit, const QueryFilter& filter = {}) const;
+
+        /// @brief Finds the colliders overlapping a box
+        /// @param bounds World-space box
+        /// @param outEntities Receives up to `outEntities.size()` entities, extra overlaps are dropped
+        /// @param filter Entities to leave out
+        /// @return Number of entities written
+        u32 OverlapAABB(const AABB& bounds, std::span<Entity> outEntities, const QueryFilter& filter = {}) const;
+
+        /// @brief Finds the colliders overlapping a circle
+        /// @param query World-space circle
+        /// @param outEntities Receives up to `outEntities.size()` entities, extra overlaps are dropped
+        /// @param filter Entities to leave out
+        /// @return Number of entities written
+        u32
+        OverlapCircle(const CircleQuery& query, std::span<Entity> outEntities, const QueryFilter& filter = {}) const;
+
+        /// @brief Finds the colliders whose centers are closest to a point, nearest first
+        /// @param point World-space point
+        /// @param outEntities Receives the `outEntities.size()` nearest entities
+        /// @param maxDistance Colliders further away are ignored
+        /// @param filter Entities to leave out
+        /// @return Number of entities written
+        u32 QueryNearest(const Vec2& point,
+                         std::span<Entity> outEntities,
+                         f32 maxDistance = std::numeric_limits<f32>::max(),
+                         const QueryFilter& filter = {}) const;
+
+        /// @brief Answers one raycast per query in parallel, `outHits` must be as long as `queries`
+        void RaycastBatch(std::span<const RaycastQuery> queries,
+                          std::span<RaycastHit> outHits,
+                          const QueryFilter& filter = {}) const;
+
+        /// @brief Answers many box overlaps in parallel
+        ///
+        /// `outEntities` is split into one equally sized slice per query, and `outCounts[i]` receives the number of
+        /// entities written to the slice of query `i`. The same layout is used by every batched query below.
+        void OverlapAABBBatch(std::span<const AABB> queries,
+                              std::span<Entity> outEntities,
+                              std::span<u32> outCounts,
+                              const QueryFilter& filter = {}) const;
+
+        /// @brief Answers many circle overlaps in parallel, see OverlapAABBBatch for the output layout
+        void OverlapCircleBatch(std::span<const CircleQuery> queries,
+                                std::span<Entity> outEntities,
+                                std::span<u32> outCounts,
+                                const QueryFilter& filter = {}) const;
+
+        /// @brief Answers many nearest queries in parallel, see OverlapAABBBatch for the output layout
+        void QueryNearestBatch(std::span<const Vec2> points,
+                               std::span<Entity> outEntities,
+                               std::span<u32> outCounts,
+                               f32 maxDistance = std::numeric_limits<f32>::max(),
+                               const QueryFilter& filter = {}) const;
+
+        /// @brief Registers the `Physics` global and the RaycastHit type
+        void RegisterLuaGlobals(sol::state& lua);
+
+    private:
+        static constexpr u16 kFlagCollider     = 1 << 0;
+        static constexpr u16 kFlagRigidbody    = 1 << 1;
+        static constexpr u16 kFlagTrigger      = 1 << 2;
+        static constexpr u16 kFlagLockRotation = 1 << 3;
+        static constexpr u16 kFlagAwake        = 1 << 4;
+        static constexpr u16 kFlagAllowSleep   = 1 << 5;
+        static constexpr u16 kFlagMovable      = 1 << 6;  ///< Proxy queries the broadphase for its own pairs
+        static constexpr u16 kFlagVisited      = 1 << 7;  ///< Scratch bit used while waking touched bodies
+        static constexpr u16 kFlagBullet       = 1 << 8;
+
+        /// @brief Per-body simulation data laid out as parallel arrays
+        struct BodyBuffers {
+            vector<Entity> entity;
+            vector<u16> flags;
+            vector<BodyType> type;
+
+            vector<Vec2> position;
+            vector<f32> rotation;  ///< Radians
+            vector<Vec2> scale;
+            vector<Vec2> velocity;
+            vector<f32> angularVelocity;
+
+            vector<Vec2> force;
+            vector<Vec2> acceleration;
+            vector<f32> torque;
+            vector<f32> angularAcceleration;
+
+            vector<f32> inverseMass;
+            vector<f32> inverseInertia;
+            vector<f32> restitution;
+            vector<f32> friction;
+            vector<f32> linearDamping;
+            vector<f32> angularDamping;
+            vector<f32> gravityScale;
+            vector<u32> restingSteps;
+
+            vector<Collider2D> collider;
+            vector<CollisionShape> shape;
+            vector<AABB> bounds;
+
+            /// @brief Transform the body was last read from or written to, the scene holding another one means the
+            /// body was moved from outside the simulation
+            vector<Transform> transform;
+
+            ASTERA_KEEP size_t Size() const {
+                return entity.size();
+            }
+
+            void Clear();
+            void Reserve(size_t count);
+            void Resize(size_t count);
+        };
+
+        struct ContactPoint {
+            Vec2 rA;
+            Vec2 rB;
+            f32 depth;
+            f32 normalMass;
+            f32 tangentMass;
+            f32 velocityBias;
+            f32 normalImpulse;
+            f32 tangentImpulse;
+        };
+
+        /// @brief Ranges into mIslandBodies and mIslandContacts
+        struct Island {
+            u32 bodyStart;
+            u32 bodyCount;
+            u32 contactStart;
+            u32 contactCount;
+            bool asleep;
+        };
+
+        struct Contact {
+            u32 a;
+            u32 b;
+            Vec2 normal;
+            ContactPoint points[2];
+            u32 pointCount;
+            f32 friction;
+            f32 restitution;
+            bool trigger;
+        };
+
+        /// @brief Collider pair touching at the end of a step
+        struct TouchingPair {
+            u64 key;  ///< Both entities, lower id in the high bits
+            u32 layerA;
+            u32 layerB;
+            bool trigger;
+        };
+
+        PhysicsSettings mSettings;
+        PhysicsStats mStats;
+        f32 mAccumulator {0.0f};
+
+        BodyBuffers mBodies;
+        vector<Contact> mContacts;
+
+        unique_ptr<IBroadphase> mBroadphase;
+        BroadphaseType mBroadphaseType {};
+        vector<BroadphaseProxy> mProxies;
+        vector<BroadphasePair> mPairs;
+        vector<u32> mQueryResults;
+        u32 mColliderCount {0};
+
+        vector<u32> mActiveBodies;     ///< Awake dynamic and kinematic bodies
+        vector<u32> mKinematicBodies;  ///< Kinematic bodies, positions are integrated outside of islands
+        vector<u32> mFellAsleep;       ///< Colliders that went to sleep last step and need a static proxy
+        vector<u32> mWoken;            ///< Sleeping bodies woken by a contact during this step
+
+        vector<u32> mBullets;
+        vector<Vec2> mBulletStarts;  ///< Position of each bullet at the start of the current step
+        vector<std::pair<f32, u32>> mSweptTriggers;
+
+        vector<TouchingPair> mTouching;      ///< Sorted by key
+        vector<TouchingPair> mTouchingNext;  ///< Scratch buffer for the next step's pairs
+        vector<ContactEvent> mContactEvents;
+        vector<u32> mBodyOfEntity;  ///< Body index per entity slot, resolves the entities of last step's pairs
+
+        vector<u32> mIslandParents;  ///< Union-find forest over body indices
+        vector<i32> mIslandOfRoot;   ///< Island index per union-find root, -1 when unassigned
+        vector<Island> mIslands;
+        vector<u32> mIslandBodies;
+        vector<u32> mIslandContacts;
+
+        void GatherBodies(SceneState& state);
+        bool RefreshBodies(SceneState& state);
+        void ReadBody(u32 body,
+                      Entity entity,
+                      const Transform& transform,
+                      const Rigidbody2D* rigidbody,
+                      const Collider2D* collider);
+        void ReadRigidbody(u32 body, const Vec2& scale, const Rigidbody2D* rigidbody, const Collider2D* collider);
+        void WriteBack(SceneState& state);
+        void Simulate(f32 timeStep);
+
+        void IntegrateVelocities(f32 timeStep);
+        void UpdateShapes();
+        void UpdateBroadphase();
+        void DetectCollisions();
+        void AddContact(u32 a, u32 b, const ContactManifold& manifold);
+        void WakeTouchedBodies();
+        void BuildIslands();
+        void SolveIsland(Island& island, f32 timeStep);
+        void UpdateActiveBodies();
+        void SolveContinuous(f32 timeStep);
+        void SweepBullet(u32 body, Vec2 start, f32 timeStep);
+        void UpdateContactEvents();
 
-class PhysicsEngine {
+        void EnsureBroadphase();
+        BroadphaseProxy MakeProxy(u32 body);
+        u32 FindIslandRoot(u32 body);
+        bool ShouldCollide(u32 a, u32 b) const;
+        bool IsResting(Entity entity) const;
 
-};
+        bool PassesFilter(u32 body, const QueryFilter& filter) const;
+        u32
+        CollectOverlaps(const CollisionShape& shape, std::span<Entity> outEntities, const QueryFilter& filter) const;
 
-} // Astera
+        void PrepareContacts(std::span<const u32> contacts);
+        void SolveVelocities(std::span<const u32> contacts);
+        void IntegratePositions(std::span<const u32> bodies, f32 timeStep);
+        void CorrectPositions(std::span<const u32> contacts);
+        bool UpdateSleep(std::span<const u32> bodies);
+    };
+}  // namespace Astera
@@ -0,0 +1,425 @@
+/*
+ *  Filename: PhysicsQueries.cpp
+ *  This code is part of the Astera core library
+ *  Copyright 2025 Jake Rieger
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "PhysicsEngine.hpp"
+#include "JobSystem.hpp"
+
+#include <sol/sol.hpp>
+
+namespace Astera {
+    /// @brief Queries per job in the batched forms, a single query is too cheap to be worth its own job
+    static constexpr size_t kQueryChunkSize = 32;
+
+    /// @brief Starting half-size of the box searched by nearest queries, doubled until enough colliders are found
+    static constexpr f32 kNearestSearchExtent = 64.0f;
+
+    /// @brief Broadphase results for the calling thread, queries may run on any worker
+    static vector<u32>& CandidateScratch() {
+        static thread_local vector<u32> scratch;
+        scratch.clear();
+        return scratch;
+    }
+
+    /// @brief Splits `outEntities` into one slice per query and runs `query(index, slice)` for each in parallel
+    template<typename Func>
+    static void RunBatch(size_t queryCount, std::span<Entity> outEntities, std::span<u32> outCounts, Func&& query) {
+        ASTERA_ASSERT_MSG(outCounts.size() >= queryCount, "Batched query needs one count per query");
+        if (queryCount == 0) return;
+
+        const size_t stride = outEntities.size() / queryCount;
+        ParallelFor(
+          0,
+          queryCount,
+          [&](size_t i) { outCounts[i] = query(i, outEntities.subspan(i * stride, stride)); },
+          kQueryChunkSize);
+    }
+
+    bool PhysicsEngine::PassesFilter(u32 body, const QueryFilter& filter) const {
+        if (mBodies.entity[body] == filter.ignore || !(mBodies.collider[body].layer & filter.layers)) return false;
+        return filter.includeTriggers || !(mBodies.flags[body] & kFlagTrigger);
+    }
+
+    u32 PhysicsEngine::CollectOverlaps(const CollisionShape& shape,
+                                       std::span<Entity> outEntities,
+                                       const QueryFilter& filter) const {
+        if (!mBroadphase || outEntities.empty()) return 0;
+
+        auto& candidates = CandidateScratch();
+        mBroadphase->Query(CollisionDetection::ComputeBounds(shape), candidates);
+
+        u32 count = 0;
+        for (const u32 body : candidates) {
+            if (!PassesFilter(body, filter)) continue;
+
+            ContactManifold manifold;
+            if (!CollisionDetection::Collide(shape, mBodies.shape[body], manifold)) continue;
+
+            outEntities[count++] = mBodies.entity[body];
+            if (count == outEntities.size()) break;
+        }
+
+        return count;
+    }
+
+    bool PhysicsEngine::Raycast(const RaycastQuery& query, RaycastHit& outHit, const QueryFilter& filter) const {
+        outHit = {};
+        if (!mBroadphase || query.maxDistance <= 0.0f || query.direction == Vec2(0.0f)) return false;
+
+        const Vec2 direction   = glm::normalize(query.direction);
+        const Vec2 translation = direction * query.maxDistance;
+
+        auto& candidates = CandidateScratch();
+        mBroadphase->QuerySegment(query.origin, translation, candidates);
+
+        f32 closest = std::numeric_limits<f32>::max();
+        for (const u32 body : candidates) {
+            if (!PassesFilter(body, filter)) continue;
+
+            const CollisionShape& shape = mBodies.shape[body];
+
+            f32 fraction;
+            Vec2 normal;
+            if (!CollisionDetection::Raycast(shape, query.origin, translation, fraction, normal)) continue;
+            if (fraction >= closest) continue;
+
+            closest         = fraction;
+            outHit.entity   = mBodies.entity[body];
+            outHit.point    = query.origin + translation * fraction;
+            outHit.normal   = normal;
+            outHit.distance = query.maxDistance * fraction;
+        }
+
+        return outHit.entity != entt::null;
+    }
+
+    u32 PhysicsEngine::OverlapAABB(const AABB& bounds, std::span<Entity> outEntities, const QueryFilter& filter) const {
+        CollisionShape shape {};
+        shape.type        = ColliderShape::AABB;
+        shape.center      = (bounds.min + bounds.max) * 0.5f;
+        shape.halfExtents = (bounds.max - bounds.min) * 0.5f;
+
+        return CollectOverlaps(shape, outEntities, filter);
+    }
+
+    u32 PhysicsEngine::OverlapCircle(const CircleQuery& query,
+                                     std::span<Entity> outEntities,
+                                     const QueryFilter& filter) const {
+        CollisionShape shape {};
+        shape.type   = ColliderShape::Circle;
+        shape.center = query.center;
+        shape.radius = query.radius;
+
+        return CollectOverlaps(shape, outEntities, filter);
+    }
+
+    u32 PhysicsEngine::QueryNearest(const Vec2& point,
+                                    std::span<Entity> outEntities,
+                                    f32 maxDistance,
+                                    const QueryFilter& filter) const {
+        if (!mBroadphase || outEntities.empty() || mColliderCount == 0) return 0;
+
+        static thread_local vector<std::pair<f32, u32>> nearest;
+        const f32 maxDistanceSqr = maxDistance * maxDistance;
+
+        // Every center within `extent` of the point lies inside the searched box, so once the box holds enough of
+        // them no collider outside it can be closer. The box stops growing once it reaches the distance limit or
+        // already holds every collider.
+        f32 extent = std::min(kNearestSearchExtent, maxDistance);
+        while (true) {
+            auto& candidates = CandidateScratch();
+            mBroadphase->Query({point - Vec2(extent), point + Vec2(extent)}, candidates);
+
+            nearest.clear();
+            size_t withinExtent = 0;
+            for (const u32 body : candidates) {
+                if (!PassesFilter(body, filter)) continue;
+
+                const Vec2 offset     = mBodies.shape[body].center - point;
+                const f32 distanceSqr = glm::dot(offset, offset);
+                if (distanceSqr > maxDistanceSqr) continue;
+
+                nearest.emplace_back(distanceSqr, body);
+                if (distanceSqr <= extent * extent) { ++withinExtent; }
+            }
+
+            if (withinExtent >= outEntities.size() || extent >= maxDistance || candidates.size() >= mColliderCount) {
+                break;
+            }
+
+            extent = std::min(extent * 2.0f, maxDistance);
+        }
+
+        // Ties are broken by body index so results don't depend on broadphase order
+        const size_t count = std::min(nearest.size(), outEntities.size());
+        std::partial_sort(nearest.begin(), nearest.begin() + CAST<ptrdiff_t>(count), nearest.end());
+
+        for (size_t i = 0; i < count; ++i) {
+            outEntities[i] = mBodies.entity[nearest[i].second];
+        }
+
+        return CAST<u32>(count);
+    }
+
+    void PhysicsEngine::RaycastBatch(std::span<const RaycastQuery> queries,
+                                     std::span<RaycastHit> outHits,
+                                     const QueryFilter& filter) const {
+        ASTERA_ASSERT_MSG(outHits.size() >= queries.size(), "RaycastBatch needs one hit per query");
+
+        ParallelFor(
+          0, queries.size(), [&](size_t i) { Raycast(queries[i], outHits[i], filter); }, kQueryChunkSize);
+    }
+
+    void PhysicsEngine::OverlapAABBBatch(std::span<const AABB> queries,
+                                         std::span<Entity> outEntities,
+                                         std::span<u32> outCounts,
+                                         const QueryFilter& filter) const {
+        RunBatch(queries.size(), outEntities, outCounts, [&](size_t i, std::span<Entity> slice) {
+            return OverlapAABB(queries[i], slice, filter);
+        });
+    }
+
+    void PhysicsEngine::OverlapCircleBatch(std::span<const CircleQuery> queries,
+                                           std::span<Entity> outEntities,
+                                           std::span<u32> outCounts,
+                                           const QueryFilter& filter) const {
+        RunBatch(queries.size(), outEntities, outCounts, [&](size_t i, std::span<Entity> slice) {
+            return OverlapCircle(queries[i], slice, filter);
+        });
+    }
+
+    void PhysicsEngine::QueryNearestBatch(std::span<const Vec2> points,
+                                          std::span<Entity> outEntities,
+                                          std::span<u32> outCounts,
+                                          f32 maxDistance,
+                                          const QueryFilter& filter) const {
+        RunBatch(points.size(), outEntities, outCounts, [&](size_t i, std::span<Entity> slice) {
+            return QueryNearest(points[i], slice, maxDistance, filter);
+        });
+    }
+
+    static QueryFilter MakeFilter(const sol::optional<Entity>& ignore) {
+        QueryFilter filter;
+        if (ignore) { filter.ignore = *ignore; }
+        return filter;
+    }
+
+    /// @brief Copies a Lua array of Vec2 into a reusable buffer
+    static vector<Vec2>& ReadPoints(const sol::table& table) {
+        static thread_local vector<Vec2> points;
+        points.resize(table.size());
+        for (size_t i = 0; i < points.size(); ++i) {
+            points[i] = table.get<Vec2>(i + 1);
+        }
+        return points;
+    }
+
+    /// @brief Writes `entities` to results[1..n] and ends the sequence there, so the caller can reuse one table
+    static void WriteResults(sol::table& results, std::span<const Entity> entities) {
+        for (size_t i = 0; i < entities.size(); ++i) {
+            results[i + 1] = entities[i];
+        }
+        results[entities.size() + 1] = sol::lua_nil;
+    }
+
+    /// @brief Writes batched results to a flat array, the entities of query `i` start at i * stride + 1
+    static void WriteBatchResults(sol::table& results,
+                                  sol::table& counts,
+                                  std::span<const Entity> entities,
+                                  std::span<const u32> entityCounts,
+                                  size_t stride) {
+        for (size_t i = 0; i < entityCounts.size(); ++i) {
+            counts[i + 1] = entityCounts[i];
+            for (u32 j = 0; j < entityCounts[i]; ++j) {
+                results[i * stride + j + 1] = entities[i * stride + j];
+            }
+        }
+    }
+
+    void PhysicsEngine::RegisterLuaGlobals(sol::state& lua) {
+        // Results are written into tables and hits owned by the script, so a query allocates nothing once they
+        // have grown to size
+        static thread_local vector<Entity> entities;
+        static thread_local vector<u32> entityCounts;
+
+        const auto entityBuffer = [](size_t size) -> std::span<Entity> {
+            if (entities.size() < size) { entities.resize(size); }
+            return {entities.data(), size};
+        };
+
+        const auto countBuffer = [](size_t size) -> std::span<u32> {
+            entityCounts.resize(size);
+            return entityCounts;
+        };
+
+        auto hit                   = lua.new_usertype<RaycastHit>("RaycastHit");
+        hit[sol::call_constructor] = sol::constructors<RaycastHit()>();
+        hit["entity"]              = &RaycastHit::entity;
+        hit["point"]               = &RaycastHit::point;
+        hit["normal"]              = &RaycastHit::normal;
+        hit["distance"]            = &RaycastHit::distance;
+
+        auto physics = lua.new_usertype<PhysicsEngine>("PhysicsEngine");
+
+        physics["Raycast"] = [](const PhysicsEngine& self,
+                                const Vec2& origin,
+                                const Vec2& direction,
+                                f32 maxDistance,
+                                RaycastHit& outHit,
+                                sol::optional<Entity> ignore) -> bool {
+            return self.Raycast({origin, direction, maxDistance}, outHit, MakeFilter(ignore));
+        };
+
+        physics["OverlapAABB"] = [entityBuffer](const PhysicsEngine& self,
+                                                const Vec2& min,
+                                                const Vec2& max,
+                                                sol::table results,
+                                                sol::optional<Entity> ignore) -> u32 {
+            const auto buffer = entityBuffer(self.mColliderCount);
+            const u32 count   = self.OverlapAABB({min, max}, buffer, MakeFilter(ignore));
+            WriteResults(results, buffer.first(count));
+            return count;
+        };
+
+        physics["OverlapCircle"] = [entityBuffer](const PhysicsEngine& self,
+                                                  const Vec2& center,
+                                                  f32 radius,
+                                                  sol::table results,
+                                                  sol::optional<Entity> ignore) -> u32 {
+            const auto buffer = entityBuffer(self.mColliderCount);
+            const u32 count   = self.OverlapCircle({center, radius}, buffer, MakeFilter(ignore));
+            WriteResults(results, buffer.first(count));
+            return count;
+        };
+
+        physics["QueryNearest"] = [entityBuffer](const PhysicsEngine& self,
+                                                 const Vec2& point,
+                                                 u32 count,
+                                                 sol::table results,
+                                                 sol::optional<f32> maxDistance,
+                                                 sol::optional<Entity> ignore) -> u32 {
+            const auto buffer = entityBuffer(count);
+            const u32 found   = self.QueryNearest(
+              point, buffer, maxDistance.value_or(std::numeric_limits<f32>::max()), MakeFilter(ignore));
+            WriteResults(results, buffer.first(found));
+            return found;
+        };
+
+        physics["RaycastBatch"] = [](const PhysicsEngine& self,
+                                     const sol::table& origins,
+                                     const sol::table& directions,
+                                     f32 maxDistance,
+                                     sol::table hits,
+                                     sol::optional<Entity> ignore) -> u32 {
+            static thread_local vector<RaycastQuery> queries;
+            static thread_local vector<RaycastHit> results;
+
+            queries.resize(std::min(origins.size(), directions.size()));
+            for (size_t i = 0; i < queries.size(); ++i) {
+                queries[i] = {origins.get<Vec2>(i + 1), directions.get<Vec2>(i + 1), maxDistance};
+            }
+
+            results.resize(queries.size());
+            self.RaycastBatch(queries, results, MakeFilter(ignore));
+
+            // Hit objects already in the table are overwritten in place, missing ones are created once
+            u32 hitCount = 0;
+            for (size_t i = 0; i < results.size(); ++i) {
+                if (results[i].entity != entt::null) { ++hitCount; }
+
+                if (auto slot = hits.get<sol::optional<RaycastHit&>>(i + 1)) {
+                    *slot = results[i];
+                } else {
+                    hits[i + 1] = results[i];
+                }
+            }
+
+            return hitCount;
+        };
+
+        physics["OverlapAABBBatch"] = [entityBuffer, countBuffer](const PhysicsEngine& self,
+                                                                  const sol::table& mins,
+                                                                  const sol::table& maxs,
+                                                                  u32 maxResults,
+                                                                  sol::table results,
+                                                                  sol::table counts,
+                                                                  sol::optional<Entity> ignore) {
+            static thread_local vector<AABB> queries;
+
+            queries.resize(std::min(mins.size(), maxs.size()));
+            for (size_t i = 0; i < queries.size(); ++i) {
+                queries[i] = {mins.get<Vec2>(i + 1), maxs.get<Vec2>(i + 1)};
+            }
+
+            const auto buffer      = entityBuffer(queries.size() * maxResults);
+            const auto countsSlice = countBuffer(queries.size());
+            self.OverlapAABBBatch(queries, buffer, countsSlice, MakeFilter(ignore));
+            WriteBatchResults(results, counts, buffer, countsSlice, maxResults);
+        };
+
+        physics["OverlapCircleBatch"] = [entityBuffer, countBuffer](const PhysicsEngine& self,
+                                                                    const sol::table& centers,
+                                                                    f32 radius,
+                                                                    u32 maxResults,
+                                                                    sol::table results,
+                                                                    sol::table counts,
+                                                                    sol::optional<Entity> ignore) {
+            static thread_local vector<CircleQuery> queries;
+
+            const auto& points = ReadPoints(centers);
+            queries.resize(points.size());
+            for (size_t i = 0; i < queries.size(); ++i) {
+                queries[i] = {points[i], radius};
+            }
+
+            const auto buffer      = entityBuffer(queries.size() * maxResults);
+            const auto countsSlice = countBuffer(queries.size());
+            self.OverlapCircleBatch(queries, buffer, countsSlice, MakeFilter(ignore));
+            WriteBatchResults(results, counts, buffer, countsSlice, maxResults);
+        };
+
+        physics["QueryNearestBatch"] = [entityBuffer, countBuffer](const PhysicsEngine& self,
+                                                                   const sol::table& points,
+                                                                   u32 count,
+                                                                   sol::table results,
+                                                                   sol::table counts,
+                                                                   sol::optional<f32> maxDistance,
+                                                                   sol::optional<Entity> ignore) {
+            const auto& queries    = ReadPoints(points);
+            const auto buffer      = entityBuffer(queries.size() * count);
+            const auto countsSlice = countBuffer(queries.size());
+            self.QueryNearestBatch(queries,
+                                   buffer,
+                                   countsSlice,
+                                   maxDistance.value_or(std::numeric_limits<f32>::max()),
+                                   MakeFilter(ignore));
+            WriteBatchResults(results, counts, buffer, countsSlice, count);
+        };
+
+        lua["Physics"] = this;
+    }
+}  // namespace Astera
@@ -0,0 +1,57 @@
+/*
+ *  Filename: Prefab.hpp
+ *  This code is part of the Astera core library
+ *  Copyright 2025 Jake Rieger
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include "EngineCommon.hpp"
+#include "NameID.hpp"
+
+#pragma region Components
+#include "Components/Transform.hpp"
+#include "Components/SpriteRenderer.hpp"
+#include "Components/Behavior.hpp"
+#include "Components/Rigidbody2D.hpp"
+#include "Components/Collider2D.hpp"
+#include "Components/SoundSource.hpp"
+#pragma endregion
+
+namespace Astera {
+    /// @brief Entity template with its resources already loaded, ready to be copied into the scene in bulk
+    ///
+    /// Built once from an EntityDescriptor by SceneParser::DescriptorToPrefab. Every instance shares the prototype's
+    /// texture, sound and quad geometry. Tilemaps own GPU buffers per entity, so prefabs don't carry them.
+    struct Prefab {
+        NameID name;
+        Transform transform {};
+        optional<SpriteRenderer> spriteRenderer {};
+        optional<Behavior> behavior {};
+        optional<Rigidbody2D> rigidbody2D {};
+        optional<Collider2D> collider2D {};
+        optional<SoundSource> soundSource {};
+    };
+}  // namespace Astera
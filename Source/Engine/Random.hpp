@@ -0,0 +1,174 @@
+/*
+ *  Filename: Random.hpp
+ *  This code is part of the Astera core library
+ *  Copyright 2025 Jake Rieger
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include "EngineCommon.hpp"
+
+#include <span>
+
+namespace Astera {
+    /// @brief Fast, seedable random number generator (xoshiro256**)
+    ///
+    /// A stream is not thread-safe, give each thread or system its own. Streams built from the same seed and stream
+    /// id always produce the same sequence, which is what makes replays and benchmarks reproducible. See
+    /// Math::GetThreadStream and Math::CreateStream for streams derived from the global seed.
+    class RandomStream {
+    public:
+        RandomStream() {
+            Seed(0);
+        }
+
+        explicit RandomStream(u64 seed) {
+            Seed(seed);
+        }
+
+        /// @brief Creates one of many independent streams sharing a seed
+        /// @param seed Shared seed
+        /// @param streamId Identifies the stream, e.g. a worker index or a hash of the owning system's name
+        RandomStream(u64 seed, u64 streamId) {
+            Seed(seed ^ SplitMix64(streamId));
+        }
+
+        /// @brief Restarts the stream from a new seed
+        void Seed(u64 seed) {
+            // splitmix64 spreads the seed over the whole state, so similar seeds still give unrelated sequences
+            for (u64& word : mState) {
+                word = SplitMix64(seed);
+            }
+        }
+
+        /// @brief Uniform 64-bit value
+        u64 NextU64() {
+            const u64 result  = Rotl(mState[1] * 5, 7) * 9;
+            const u64 shifted = mState[1] << 17;
+
+            mState[2] ^= mState[0];
+            mState[3] ^= mState[1];
+            mState[1] ^= mState[2];
+            mState[0] ^= mState[3];
+            mState[2] ^= shifted;
+            mState[3] = Rotl(mState[3], 45);
+
+            return result;
+        }
+
+        /// @brief Uniform 32-bit value
+        u32 NextU32() {
+            return CAST<u32>(NextU64() >> 32);
+        }
+
+        /// @brief Uniform float in [0, 1)
+        f32 NextFloat() {
+            return ToUnitFloat(CAST<u32>(NextU64() >> 40));
+        }
+
+        /// @brief Uniform float in [min, max)
+        f32 NextRange(f32 min, f32 max) {
+            return min + (max - min) * NextFloat();
+        }
+
+        /// @brief Uniform integer in [min, max], both ends included
+        i32 NextInt(i32 min, i32 max) {
+            if (max <= min) return min;
+
+            // Multiply-shift with rejection of the few values that would bias the result (Lemire)
+            const u64 range = CAST<u64>(CAST<i64>(max) - CAST<i64>(min)) + 1;
+            u64 product     = CAST<u64>(NextU32()) * range;
+            if (CAST<u32>(product) < range) {
+                const u64 threshold = ((1ull << 32) - range) % range;
+                while (CAST<u32>(product) < threshold) {
+                    product = CAST<u64>(NextU32()) * range;
+                }
+            }
+
+            return CAST<i32>(CAST<i64>(min) + CAST<i64>(product >> 32));
+        }
+
+        /// @brief Fills a buffer with uniform floats in [0, 1), two floats per generator step
+        void Fill(std::span<f32> out) {
+            size_t i = 0;
+            for (; i + 1 < out.size(); i += 2) {
+                const u64 bits = NextU64();
+                out[i]         = ToUnitFloat(CAST<u32>(bits >> 40));
+                out[i + 1]     = ToUnitFloat(CAST<u32>(bits >> 8) & 0xFFFFFF);
+            }
+            if (i < out.size()) { out[i] = NextFloat(); }
+        }
+
+        /// @brief Fills a buffer with uniform floats in [min, max)
+        void Fill(std::span<f32> out, f32 min, f32 max) {
+            Fill(out);
+            const f32 scale = max - min;
+            for (f32& value : out) {
+                value = min + scale * value;
+            }
+        }
+
+        /// @brief Advances the stream by 2^128 steps, each jump starts a sub-sequence that never overlaps the others
+        void Jump() {
+            static constexpr u64 kJump[] = {
+              0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull, 0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull};
+
+            u64 state[4] {};
+            for (const u64 word : kJump) {
+                for (u32 bit = 0; bit < 64; ++bit) {
+                    if (word & (1ull << bit)) {
+                        for (u32 i = 0; i < 4; ++i) {
+                            state[i] ^= mState[i];
+                        }
+                    }
+                    NextU64();
+                }
+            }
+
+            for (u32 i = 0; i < 4; ++i) {
+                mState[i] = state[i];
+            }
+        }
+
+    private:
+        u64 mState[4];
+
+        static u64 Rotl(u64 value, u32 shift) {
+            return (value << shift) | (value >> (64 - shift));
+        }
+
+        static u64 SplitMix64(u64& state) {
+            u64 z = (state += 0x9E3779B97F4A7C15ull);
+            z     = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z     = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            return z ^ (z >> 31);
+        }
+
+        /// @brief Maps 24 random bits to [0, 1), exact in single precision
+        static f32 ToUnitFloat(u32 bits) {
+            return CAST<f32>(bits) * (1.0f / 16777216.0f);
+        }
+    };
+}  // namespace Astera
@@ -34,6 +34,16 @@
 #include <variant>
 
 namespace Astera {
+    /// @brief Builds a key used to order batched draws. Draws are sorted by layer first, then by texture so that
+    /// consecutive draws can share state.
+    /// @param layer Draw layer, lower layers are drawn first
+    /// @param textureId GL texture bound by the draw
+    /// @return Packed sort key
+    inline constexpr u64 MakeSortKey(i16 layer, u32 textureId) {
+        // Flip the sign bit so negative layers order before positive ones as unsigned values
+        return (CAST<u64>(CAST<u16>(layer) ^ 0x8000u) << 32) | textureId;
+    }
+
     /// @brief Command to clear the framebuffer
     struct ClearCommand {
         Vec4 color {0.0f, 0.0f, 0.0f, 1.0f};
@@ -44,9 +54,19 @@ namespace Astera {
     /// @brief Command to draw a sprite/quad
     struct DrawSpriteCommand {
         const struct SpriteRenderer* spriteRenderer;
-        const struct Transform* transform;
+        Mat4 model;  ///< World matrix, normally the entity's cached WorldTransform
         Vec2 screenDimensions;
         Vec4 tintColor {1.0f, 1.0f, 1.0f, 1.0f};
+        u64 sortKey {0};
+    };
+
+    /// @brief Command to draw one pre-built chunk of a tilemap
+    struct DrawTilemapChunkCommand {
+        shared_ptr<VertexArray> vao;
+        u32 indexCount;
+        u32 textureId;
+        Mat4 mvp;
+        u64 sortKey {0};
     };
 
     /// @brief Command to set the viewport
@@ -138,6 +158,7 @@ namespace Astera {
     /// @brief A batch of sprites sharing the same texture
     struct SpriteBatch {
         u32 textureId;
+        u64 sortKey;
         vector<SpriteInstanceData> instances;
         shared_ptr<VertexArray> quadVAO;  ///< Shared quad geometry
 
@@ -153,6 +174,7 @@ namespace Astera {
     /// @brief Variant type that can hold any command
     using RenderCommand = std::variant<ClearCommand,
                                        DrawSpriteCommand,
+                                       DrawTilemapChunkCommand,
                                        SetViewportCommand,
                                        BindShaderCommand,
                                        SetUniformCommand,
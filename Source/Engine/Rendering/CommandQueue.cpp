@@ -57,20 +57,44 @@ namespace Astera {
 
         CommandExecutor executor;
 
-        // Execute non-sprite commands first
+        // Execute non-draw commands first
         for (const auto& command : mCommands) {
-            if (!std::holds_alternative<DrawSpriteCommand>(command)) {
+            if (!std::holds_alternative<DrawSpriteCommand>(command) &&
+                !std::holds_alternative<DrawTilemapChunkCommand>(command)) {
                 std::visit(executor, command);
             }
         }
 
-        // Batch and render sprites
+        // Batch sprites, then interleave sprite batches and tilemap chunks by sort key
         BatchSpriteCommands();
 
+        vector<size_t> chunkIndices;
+        for (size_t i = 0; i < mCommands.size(); ++i) {
+            if (std::holds_alternative<DrawTilemapChunkCommand>(mCommands[i])) {
+                chunkIndices.push_back(i);
+            }
+        }
+
+        std::ranges::stable_sort(chunkIndices, [this](size_t a, size_t b) {
+            return std::get<DrawTilemapChunkCommand>(mCommands[a]).sortKey <
+                   std::get<DrawTilemapChunkCommand>(mCommands[b]).sortKey;
+        });
+
+        size_t nextChunk = 0;
         for (const auto& batch : mBatches) {
+            // Tilemap chunks win ties so tiles end up underneath sprites on the same layer
+            while (nextChunk < chunkIndices.size() &&
+                   std::get<DrawTilemapChunkCommand>(mCommands[chunkIndices[nextChunk]]).sortKey <= batch.sortKey) {
+                executor(std::get<DrawTilemapChunkCommand>(mCommands[chunkIndices[nextChunk++]]));
+            }
+
             RenderBatch(batch);
         }
 
+        while (nextChunk < chunkIndices.size()) {
+            executor(std::get<DrawTilemapChunkCommand>(mCommands[chunkIndices[nextChunk++]]));
+        }
+
         Clear();
     }
 
@@ -97,41 +121,45 @@ namespace Astera {
         if (spriteIndices.empty())
             return;
 
-        // Stable sort to maintain draw order for same texture
+        // Stable sort to maintain draw order for same layer and texture
         std::ranges::stable_sort(spriteIndices, [this](size_t a, size_t b) {
             const auto& cmdA = std::get<DrawSpriteCommand>(mCommands[a]);
             const auto& cmdB = std::get<DrawSpriteCommand>(mCommands[b]);
-            return cmdA.spriteRenderer->sprite->GetID() < cmdB.spriteRenderer->sprite->GetID();
+            return cmdA.sortKey < cmdB.sortKey;
         });
 
         // Build batches
         SpriteBatch currentBatch;
         currentBatch.quadVAO = mBatchVAO;
-        u32 currentTexture   = static_cast<u32>(-1);
+        u64 currentKey       = static_cast<u64>(-1);
+
+        // Every sprite in a frame normally shares the screen size, only rebuild the projection when it changes
+        Vec2 projectionSize {-1.0f};
+        Mat4 projection {1.0f};
 
         for (const size_t idx : spriteIndices) {
             const auto& cmd = std::get<DrawSpriteCommand>(mCommands[idx]);
 
-            // Start new batch if texture changes or batch is full
-            if (cmd.spriteRenderer->sprite->GetID() != currentTexture ||
-                currentBatch.SpriteCount() >= kMaxSpritesPerBatch) {
+            // Start new batch if layer or texture changes or batch is full
+            if (cmd.sortKey != currentKey || currentBatch.SpriteCount() >= kMaxSpritesPerBatch) {
                 if (!currentBatch.instances.empty()) {
                     mBatches.push_back(std::move(currentBatch));
                     currentBatch         = SpriteBatch();
                     currentBatch.quadVAO = mBatchVAO;
                 }
 
-                currentTexture         = cmd.spriteRenderer->sprite->GetID();
-                currentBatch.textureId = currentTexture;
+                currentKey             = cmd.sortKey;
+                currentBatch.textureId = cmd.spriteRenderer->sprite->GetID();
+                currentBatch.sortKey   = currentKey;
             }
 
-            // Calculate MVP transform for this sprite
-            const Mat4 model      = cmd.transform->GetMatrix();
-            const Mat4 projection = Coordinates::CreateScreenProjection(cmd.screenDimensions.x, cmd.screenDimensions.y);
-            const Mat4 mvp        = projection * model;
+            if (cmd.screenDimensions != projectionSize) {
+                projectionSize = cmd.screenDimensions;
+                projection     = Coordinates::CreateScreenProjection(projectionSize.x, projectionSize.y);
+            }
 
             // Add instance data
-            currentBatch.instances.emplace_back(mvp, cmd.tintColor);
+            currentBatch.instances.emplace_back(projection * cmd.model, cmd.tintColor);
         }
 
         // Add final batch
@@ -298,9 +326,8 @@ namespace Astera {
         cmd.spriteRenderer->sprite->Bind(0);
         spriteShader->SetUniform("uSprite", 0);
 
-        const Mat4 model      = cmd.transform->GetMatrix();
         const Mat4 projection = Coordinates::CreateScreenProjection(cmd.screenDimensions.x, cmd.screenDimensions.y);
-        const Mat4 mvp        = projection * model;
+        const Mat4 mvp        = projection * cmd.model;
         spriteShader->SetUniform("uMVP", mvp);
 
         const auto drawCmd = DrawIndexedCommand {
@@ -312,6 +339,19 @@ namespace Astera {
         (*this)(drawCmd);
     }
 
+    void CommandExecutor::operator()(const DrawTilemapChunkCommand& cmd) const {
+        const auto spriteShader = ShaderManager::GetShader(Shaders::Sprite);
+        ASTERA_ASSERT(spriteShader);
+        spriteShader->Bind();
+
+        GLCall(glActiveTexture, GL_TEXTURE0);
+        GLCall(glBindTexture, GL_TEXTURE_2D, cmd.textureId);
+        spriteShader->SetUniform("uSprite", 0);
+        spriteShader->SetUniform("uMVP", cmd.mvp);
+
+        (*this)(DrawIndexedCommand {.vao = cmd.vao, .indexCount = cmd.indexCount});
+    }
+
     void CommandExecutor::operator()(const SetViewportCommand& cmd) const {
         GLCall(glViewport, cmd.x, cmd.y, CAST<GLsizei>(cmd.width), CAST<GLsizei>(cmd.height));
     }
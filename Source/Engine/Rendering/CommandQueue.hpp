@@ -51,7 +51,8 @@ namespace Astera {
         /// @brief Execute all queued commands and clear the queue
         void ExecuteQueue();
 
-        /// @brief Execute all queued commands with sprite batching
+        /// @brief Execute all queued commands with sprite batching. Sprite batches and tilemap chunks are drawn in
+        /// sort key order.
         void ExecuteQueueBatched();
 
         /// @brief Clear all queued commands without executing them
@@ -108,6 +109,7 @@ namespace Astera {
     public:
         void operator()(const ClearCommand& cmd) const;
         void operator()(const DrawSpriteCommand& cmd) const;
+        void operator()(const DrawTilemapChunkCommand& cmd) const;
         void operator()(const SetViewportCommand& cmd) const;
         void operator()(const BindShaderCommand& cmd) const;
         void operator()(const SetUniformCommand& cmd) const;
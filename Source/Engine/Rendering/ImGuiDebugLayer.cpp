@@ -36,6 +36,8 @@
 #include <backends/imgui_impl_opengl3.h>
 #include <backends/imgui_impl_glfw.h>
 
+#include <tuple>
+
 namespace Astera {
     ImGuiDebugLayer::ImGuiDebugLayer(GLFWwindow* window) {
         InitImGui(window);
@@ -57,6 +59,9 @@ namespace Astera {
         if (!mCustomText.empty())
             DrawCustomText();
 
+        if (mScriptProfiler)
+            DrawScriptProfiler();
+
         ImGui::Render();
         ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
     }
@@ -123,6 +128,7 @@ namespace Astera {
                            "Frame Rate     %u FPS",
                            (u32)Math::Round(mFrameStats.frameRate));
         ImGui::TextColored(Colors::Green.To<ImVec4>(), "Frame Time     %.2f ms", mFrameStats.frameTime);
+        ImGui::TextColored(Colors::Green.To<ImVec4>(), "Frame p99      %.2f ms", GetFrameTimePercentile(0.99f));
         ImGui::TextColored(Colors::Magenta.To<ImVec4>(), "Main Thread    %.2f ms", mFrameStats.mainThreadTime);
         ImGui::TextColored(Colors::Magenta.To<ImVec4>(), "Render Thread  %.2f ms", mFrameStats.renderThreadTime);
         ImGui::TextColored(Colors::Cyan.To<ImVec4>(), "Draw Calls     %u", mFrameStats.drawCalls);
@@ -151,11 +157,225 @@ namespace Astera {
                            usedOOM,
                            usedSuffix.c_str());
 
+        ImGui::Dummy({0, 20.f});
+        ImGui::Text("Physics Stats");
+        ImGui::Separator();
+        ImGui::TextColored(Colors::Cyan.To<ImVec4>(), "Bodies         %u", mPhysicsStats.bodies);
+        ImGui::TextColored(Colors::Cyan.To<ImVec4>(), "Awake Bodies   %u", mPhysicsStats.awakeBodies);
+        ImGui::TextColored(Colors::Cyan.To<ImVec4>(), "Islands        %u", mPhysicsStats.islands);
+        ImGui::TextColored(Colors::Cyan.To<ImVec4>(), "Contacts       %u", mPhysicsStats.contacts);
+        ImGui::TextColored(Colors::Cyan.To<ImVec4>(), "Steps          %u", mPhysicsStats.steps);
+        ImGui::TextColored(Colors::Cyan.To<ImVec4>(), "Pairs          %u", mPhysicsStats.candidatePairs);
+
+        string broadphaseSuffix;
+        const f32 broadphaseOOM = CalcBytesOOM(mPhysicsStats.broadphaseMemory, broadphaseSuffix);
+        ImGui::TextColored(Colors::Yellow.To<ImVec4>(),
+                           "Broadphase     %.1f %s",
+                           broadphaseOOM,
+                           broadphaseSuffix.c_str());
+        ImGui::TextColored(Colors::Magenta.To<ImVec4>(), "Update Time    %.2f ms", mPhysicsStats.updateTime);
+
+        if (!mSystemTimings.empty()) {
+            ImGui::Dummy({0, 20.f});
+            ImGui::Text("System Timings");
+            ImGui::Separator();
+            for (const auto& timing : mSystemTimings) {
+                ImGui::TextColored(Colors::Magenta.To<ImVec4>(),
+                                   "[%u] %-18s %.2f ms",
+                                   timing.stage,
+                                   timing.name.c_str(),
+                                   timing.time);
+            }
+        }
+
+        if (!mPoolStats.empty()) {
+            ImGui::Dummy({0, 20.f});
+            ImGui::Text("Entity Pools");
+            ImGui::Separator();
+            for (const auto& pool : mPoolStats) {
+                ImGui::TextColored(pool.misses > 0 ? Colors::Yellow.To<ImVec4>() : Colors::Cyan.To<ImVec4>(),
+                                   "%-14s %u/%u (peak %u, misses %u)",
+                                   pool.prefab.ToString().c_str(),
+                                   pool.active,
+                                   pool.capacity,
+                                   pool.peakActive,
+                                   pool.misses);
+            }
+        }
+
+        ImGui::Dummy({0, 20.f});
+        ImGui::Text("Script Stats");
+        ImGui::Separator();
+        ImGui::TextColored(Colors::Magenta.To<ImVec4>(),
+                           "GC Time        %.2f ms (%u steps)",
+                           mScriptGCStats.frameTime,
+                           mScriptGCStats.frameSteps);
+
+        string memorySuffix, thresholdSuffix;
+        const f32 memoryOOM    = CalcBytesOOM(mScriptGCStats.memoryBytes, memorySuffix);
+        const f32 thresholdOOM = CalcBytesOOM(mScriptGCStats.thresholdBytes, thresholdSuffix);
+        ImGui::TextColored(Colors::Yellow.To<ImVec4>(),
+                           "Lua Memory     %.1f %s (next GC at %.1f %s)",
+                           memoryOOM,
+                           memorySuffix.c_str(),
+                           thresholdOOM,
+                           thresholdSuffix.c_str());
+        ImGui::TextColored(mScriptGCStats.overdueFrames > 0 ? Colors::Yellow.To<ImVec4>() : Colors::Cyan.To<ImVec4>(),
+                           "GC Cycles      %u (%u over budget)",
+                           mScriptGCStats.completedCycles,
+                           mScriptGCStats.overdueFrames);
+
+        if (mScriptMemory.pooledBytes > 0) {
+            string pooledSuffix;
+            const f32 pooledOOM = CalcBytesOOM(mScriptMemory.pooledBytes, pooledSuffix);
+            ImGui::TextColored(Colors::Yellow.To<ImVec4>(), "Lua Pools      %.1f %s", pooledOOM, pooledSuffix.c_str());
+
+            for (const auto& script : mScriptMemoryByScript) {
+                string frameSuffix;
+                const f32 frameOOM = CalcBytesOOM(script.frameAllocatedBytes, frameSuffix);
+                ImGui::TextColored(Colors::Cyan.To<ImVec4>(),
+                                   "%016llx %.1f %s/frame",
+                                   CAST<unsigned long long>(script.script),
+                                   frameOOM,
+                                   frameSuffix.c_str());
+            }
+        }
+
         mStatsSize = ImGui::GetWindowSize();
 
         ImGui::End();
     }
 
+    f32 ImGuiDebugLayer::GetFrameTimePercentile(f32 percentile) {
+        if (mFrameTimeCount == 0) return 0.f;
+
+        mSortedFrameTimes.assign(mFrameTimes.begin(), mFrameTimes.begin() + mFrameTimeCount);
+        const auto rank = mSortedFrameTimes.begin() + CAST<size_t>(percentile * CAST<f32>(mFrameTimeCount - 1));
+        std::ranges::nth_element(mSortedFrameTimes, rank);
+        return *rank;
+    }
+
+    void ImGuiDebugLayer::DrawScriptProfiler() {
+        ImGui::SetNextWindowCollapsed(true, ImGuiCond_FirstUseEver);
+        ImGui::SetNextWindowSize({640.f, 360.f}, ImGuiCond_FirstUseEver);
+        if (!ImGui::Begin("Script Profiler")) {
+            ImGui::End();
+            return;
+        }
+
+        auto& profiler = *mScriptProfiler;
+        bool enabled   = profiler.IsEnabled();
+        if (ImGui::Checkbox("Enabled", &enabled)) { profiler.SetEnabled(enabled); }
+
+        ImGui::SameLine();
+        bool sampling = profiler.IsSampling();
+        if (ImGui::Checkbox("Sample", &sampling)) {
+            if (sampling) {
+                profiler.StartSampling(kSampleInstructions);
+            } else {
+                profiler.StopSampling();
+            }
+        }
+
+        ImGui::SameLine();
+        if (ImGui::Button("Reset")) { profiler.Reset(); }
+
+        ImGui::SameLine();
+        if (!profiler.IsCapturing()) {
+            if (ImGui::Button("Capture")) { profiler.StartCapture(); }
+        } else if (ImGui::Button("Stop Capture")) {
+            profiler.StopCapture();
+        }
+
+        ImGui::SameLine();
+        ImGui::BeginDisabled(profiler.GetCapturedEventCount() == 0);
+        if (ImGui::Button("Save Trace")) { profiler.WriteTrace(fs::current_path() / "Cache" / "ScriptTrace.json"); }
+        ImGui::EndDisabled();
+
+        const u64 frames = std::max<u64>(profiler.GetFrameCount(), 1);
+        ImGui::Text("%llu frames, %zu events captured",
+                    CAST<unsigned long long>(profiler.GetFrameCount()),
+                    profiler.GetCapturedEventCount());
+
+        constexpr ImGuiTableFlags flags = ImGuiTableFlags_Sortable | ImGuiTableFlags_SortTristate |
+                                          ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders |
+                                          ImGuiTableFlags_ScrollY | ImGuiTableFlags_Resizable;
+        if (ImGui::BeginTable("ScriptProfilerEntries", 6, flags, {0.f, ImGui::GetContentRegionAvail().y * 0.6f})) {
+            ImGui::TableSetupScrollFreeze(0, 1);
+            ImGui::TableSetupColumn("Script", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("Callback");
+            ImGui::TableSetupColumn("Calls/frame");
+            ImGui::TableSetupColumn("Total ms/frame",
+                                    ImGuiTableColumnFlags_DefaultSort | ImGuiTableColumnFlags_PreferSortDescending);
+            ImGui::TableSetupColumn("Self ms/frame", ImGuiTableColumnFlags_PreferSortDescending);
+            ImGui::TableSetupColumn("Alloc KB/frame", ImGuiTableColumnFlags_PreferSortDescending);
+            ImGui::TableHeadersRow();
+
+            // Sorted every frame, the entries change under the table while the profiler runs
+            const auto entries = profiler.GetEntries();
+            mProfilerEntries.assign(entries.begin(), entries.end());
+            if (const ImGuiTableSortSpecs* specs = ImGui::TableGetSortSpecs(); specs && specs->SpecsCount > 0) {
+                const ImGuiTableColumnSortSpecs& spec = specs->Specs[0];
+                const auto key = [&](const ScriptProfiler::Entry& entry) -> std::tuple<std::string_view, u64> {
+                    switch (spec.ColumnIndex) {
+                        case 0:
+                            return {profiler.GetScriptName(entry.script), 0};
+                        case 1:
+                            return {ToString(entry.callback), 0};
+                        case 2:
+                            return {std::string_view {}, entry.calls};
+                        case 4:
+                            return {std::string_view {}, entry.selfNs};
+                        case 5:
+                            return {std::string_view {}, entry.allocatedBytes};
+                        default:
+                            return {std::string_view {}, entry.totalNs};
+                    }
+                };
+                const bool ascending = spec.SortDirection == ImGuiSortDirection_Ascending;
+                std::ranges::stable_sort(mProfilerEntries, [&](const auto& a, const auto& b) {
+                    return ascending ? key(a) < key(b) : key(b) < key(a);
+                });
+            }
+
+            for (const auto& entry : mProfilerEntries) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(profiler.GetScriptName(entry.script).c_str());
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(ToString(entry.callback));
+                ImGui::TableNextColumn();
+                ImGui::Text("%.1f", CAST<f64>(entry.calls) / CAST<f64>(frames));
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", CAST<f64>(entry.totalNs) / 1e6 / CAST<f64>(frames));
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", CAST<f64>(entry.selfNs) / 1e6 / CAST<f64>(frames));
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f", CAST<f64>(entry.allocatedBytes) / 1024.0 / CAST<f64>(frames));
+            }
+            ImGui::EndTable();
+        }
+
+        const auto samples = profiler.GetSamples();
+        if (!samples.empty()) {
+            u64 total = 0;
+            for (const auto& sample : samples) {
+                total += sample.count;
+            }
+
+            ImGui::Text("Samples (%llu)", CAST<unsigned long long>(total));
+            ImGui::Separator();
+            for (size_t i = 0; i < std::min<size_t>(samples.size(), kShownSamples); ++i) {
+                ImGui::Text("%5.1f%%  %s  %s",
+                            100.0 * CAST<f64>(samples[i].count) / CAST<f64>(total),
+                            samples[i].script != 0 ? profiler.GetScriptName(samples[i].script).c_str() : "-",
+                            samples[i].location.c_str());
+            }
+        }
+
+        ImGui::End();
+    }
+
     void ImGuiDebugLayer::DrawCustomText() const {
         ImGui::SetNextWindowPos({0, mStatsSize.y + 40});
         ImGui::Begin(mCustomTextHeader.c_str(),
@@ -30,6 +30,9 @@
 
 #include "EngineCommon.hpp"
 #include "DebugInterface.hpp"
+#include "SystemScheduler.hpp"
+#include "EntityPool.hpp"
+#include "ScriptEngine.hpp"
 
 #include <imgui.h>
 
@@ -55,6 +58,13 @@ namespace Astera {
             mFrameStats.frameTime = time;
         }
 
+        /// @brief Adds the real duration of a frame to the history the p99 frame time is taken from
+        void RecordFrameTime(f32 time) {
+            mFrameTimes[mFrameTimeCursor] = time;
+            mFrameTimeCursor              = (mFrameTimeCursor + 1) % kFrameHistory;
+            mFrameTimeCount               = std::min(mFrameTimeCount + 1, kFrameHistory);
+        }
+
         void UpdateMainThreadTime(f32 time) {
             mFrameStats.mainThreadTime = time;
         }
@@ -79,6 +89,43 @@ namespace Astera {
             mSceneStats.resourcePoolUsedBytes = usedBytes;
         }
 
+        void UpdatePhysicsStats(u32 bodies, u32 awakeBodies, u32 islands, u32 contacts, u32 steps, f32 updateTime) {
+            mPhysicsStats.bodies      = bodies;
+            mPhysicsStats.awakeBodies = awakeBodies;
+            mPhysicsStats.islands     = islands;
+            mPhysicsStats.contacts    = contacts;
+            mPhysicsStats.steps       = steps;
+            mPhysicsStats.updateTime  = updateTime;
+        }
+
+        void UpdateBroadphaseStats(u32 candidatePairs, u64 memoryBytes) {
+            mPhysicsStats.candidatePairs   = candidatePairs;
+            mPhysicsStats.broadphaseMemory = memoryBytes;
+        }
+
+        void UpdateSystemTimings(std::span<const SystemTiming> timings) {
+            mSystemTimings.assign(timings.begin(), timings.end());
+        }
+
+        void UpdatePoolStats(std::span<const EntityPoolStats> pools) {
+            mPoolStats.assign(pools.begin(), pools.end());
+        }
+
+        /// @param allocator Lua allocator, or nullptr when Lua runs on its own
+        void UpdateScriptStats(const ScriptGCStats& gc, const ScriptAllocator* allocator) {
+            mScriptGCStats = gc;
+            mScriptMemory  = allocator ? allocator->GetStats() : ScriptAllocator::Stats {};
+            if (allocator) {
+                const auto scripts = allocator->GetScriptStats();
+                mScriptMemoryByScript.assign(scripts.begin(), scripts.end());
+            }
+        }
+
+        /// @brief Shows the profiler's table and controls in a window of their own, nullptr hides it
+        void SetScriptProfiler(ScriptProfiler* profiler) {
+            mScriptProfiler = profiler;
+        }
+
         void SetCustomText(const string& header, const vector<string>& lines) {
             mCustomText       = lines;
             mCustomTextHeader = header;
@@ -98,16 +145,48 @@ namespace Astera {
             u32 drawCalls {0};
         } mFrameStats;
 
+        static constexpr u32 kFrameHistory = 600;
+        std::array<f32, kFrameHistory> mFrameTimes {};
+        vector<f32> mSortedFrameTimes;
+        u32 mFrameTimeCursor {0};
+        u32 mFrameTimeCount {0};
+
+        f32 GetFrameTimePercentile(f32 percentile);
+
         void DrawStats();
 
         void DrawCustomText() const;
 
+        void DrawScriptProfiler();
+
         struct SceneStats {
             u32 entities {0};
             u64 resourcePoolAllocatedBytes {0};
             u64 resourcePoolUsedBytes {0};
         } mSceneStats;
 
+        struct PhysicsStats {
+            u32 bodies {0};
+            u32 awakeBodies {0};
+            u32 islands {0};
+            u32 contacts {0};
+            u32 steps {0};
+            f32 updateTime {0.f};
+            u32 candidatePairs {0};
+            u64 broadphaseMemory {0};
+        } mPhysicsStats;
+
+        vector<SystemTiming> mSystemTimings;
+        vector<EntityPoolStats> mPoolStats;
+        ScriptGCStats mScriptGCStats;
+        ScriptAllocator::Stats mScriptMemory;
+        vector<ScriptAllocator::ScriptStats> mScriptMemoryByScript;
+
+        static constexpr i32 kSampleInstructions = 1000;
+        static constexpr u32 kShownSamples       = 20;
+        ScriptProfiler* mScriptProfiler {nullptr};
+        vector<ScriptProfiler::Entry> mProfilerEntries;
+
         ImVec2 mStatsSize;
 
         vector<string> mCustomText;
@@ -99,10 +99,9 @@ namespace Astera {
     }
 
     void VertexArray::Destroy() {
-        for (const auto& vbo : mVertexBuffers) {
-            vbo->Destroy();
-        }
-        mIndexBuffer->Destroy();
+        // Buffers can be shared between vertex arrays, each one is deleted along with its last owner
+        mVertexBuffers.clear();
+        mIndexBuffer.reset();
 
         if (mArrayID != 0) {
             GLCall(glDeleteVertexArrays, 1, &mArrayID);
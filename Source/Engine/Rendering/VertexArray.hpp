@@ -181,6 +181,7 @@ namespace Astera {
             return mArrayID;
         }
 
+        /// @brief Deletes the VAO and releases its buffers, buffers still referenced elsewhere stay alive
         void Destroy();
 
     private:
@@ -29,7 +29,12 @@
 #include "Scene.hpp"
 #include "SceneParser.hpp"
 #include "ScriptTypeRegistry.hpp"
+#include "Coordinates.inl"
 #include "Log.hpp"
+#include "Physics/PhysicsEngine.hpp"
+
+#include <algorithm>
+#include <cmath>
 
 namespace Astera {
     Scene::~Scene() {
@@ -37,44 +42,303 @@ namespace Astera {
     }
 
     void Scene::Awake(ScriptEngine& engine) {
+        SyncScriptInstances(engine);
+
         const auto iter = mState.View<Transform, Behavior>().each();
         for (auto [entity, transform, behavior] : iter) {
-            BehaviorEntity behaviorEntity((u32)entity, mState.GetEntityName(entity), &transform);
+            BehaviorEntity behaviorEntity((u32)entity, mState.GetEntityNameID(entity), &transform, behavior.instance);
             engine.CallAwakeBehavior(behavior.script, behaviorEntity);
         }
+
+        StartRoutines(engine);
+    }
+
+    void Scene::GatherBehaviors(ScriptEngine& engine) {
+        SyncScriptInstances(engine);
+        StartRoutines(engine);
+
+        for (auto& [script, batch] : mBehaviorBatches) {
+            batch.Clear();
+        }
+
+        // Neighbouring entities tend to share a script, so the map is only searched when the script changes
+        BehaviorBatch* batch = nullptr;
+        ScriptEngine::ScriptID batchScript {};
+        for (auto [entity, transform, behavior] : mState.View<Transform, Behavior>().each()) {
+            if (!batch || behavior.script != batchScript) {
+                batch       = &mBehaviorBatches[behavior.script];
+                batchScript = behavior.script;
+            }
+            batch->Add((u32)entity, mState.GetEntityNameID(entity), &transform, behavior.instance);
+        }
+    }
+
+    void Scene::SyncScriptInstances(ScriptEngine& engine) {
+        // Tables of destroyed entities go back first so this frame's spawns can reuse them
+        if (const auto retired = mState.GetRetiredBehaviors(); !retired.empty()) {
+            engine.ReleaseInstances(retired);
+            mState.ClearRetiredBehaviors();
+        }
+
+        mPendingInstances.clear();
+        for (auto [entity, behavior] : mState.View<Behavior>().each()) {
+            if (behavior.instance == Behavior::kNoInstance) { mPendingInstances.push_back({entity, &behavior}); }
+        }
+        if (mPendingInstances.empty()) return;
+
+        // Spawned entities usually come in runs of one prefab, sorting only moves the few that are interleaved
+        std::ranges::stable_sort(mPendingInstances, {}, [](const PendingInstance& pending) {
+            return pending.behavior->script;
+        });
+        mNewInstances.resize(mPendingInstances.size());
+
+        for (size_t first = 0; first < mPendingInstances.size();) {
+            const auto script = mPendingInstances[first].behavior->script;
+            size_t last       = first + 1;
+            while (last < mPendingInstances.size() && mPendingInstances[last].behavior->script == script) {
+                ++last;
+            }
+
+            engine.CreateInstances(script, std::span(mNewInstances).subspan(first, last - first));
+            for (size_t i = first; i < last; ++i) {
+                mPendingInstances[i].behavior->instance = mNewInstances[i];
+            }
+
+            if (engine.HasRoutine(script)) {
+                auto& routines = mRoutineBatches[script];
+                for (size_t i = first; i < last; ++i) {
+                    const Entity entity = mPendingInstances[i].entity;
+                    routines.Add(
+                      (u32)entity, mState.GetEntityNameID(entity), &mState.GetTransform(entity), mNewInstances[i]);
+                }
+            }
+            first = last;
+        }
+    }
+
+    void Scene::StartRoutines(ScriptEngine& engine) {
+        for (auto& [script, batch] : mRoutineBatches) {
+            if (batch.Size() == 0) continue;
+            engine.StartRoutines(script, batch);
+            batch.Clear();
+        }
     }
 
     void Scene::Update(const Clock& clock, ScriptEngine& engine) {
-        const auto iter = mState.View<Transform, Behavior>().each();
-        for (auto [entity, transform, behavior] : iter) {
-            BehaviorEntity behaviorEntity((u32)entity, mState.GetEntityName(entity), &transform);
-            engine.CallUpdateBehavior(behavior.script, behaviorEntity, clock);
+        GatherBehaviors(engine);
+        for (const auto& [script, batch] : mBehaviorBatches) {
+            if (batch.Size() > 0) { engine.CallUpdateBehaviors(script, batch, clock); }
+        }
+
+        // Routines end once their entity is gone, switched off, or has been given another script or instance
+        engine.ResumeRoutines(clock, [this](u32 id, ScriptEngine::ScriptID script, i32 instance) -> Transform* {
+            const auto entity = CAST<Entity>(id);
+            if (!mState.IsValid(entity) || !mState.IsActive(entity)) return nullptr;
+
+            const auto* behavior = mState.TryGetComponent<Behavior>(entity);
+            if (!behavior || behavior->script != script || behavior->instance != instance) return nullptr;
+            return &mState.GetTransform(entity);
+        });
+
+        mSystems.Run(mState, clock.GetDeltaTime());
+        mCommands.Playback(mState);
+    }
+
+    void Scene::FixedUpdate(f32 timeStep, ScriptEngine& engine) {
+        ++mFixedStep;
+        for (auto [entity, transform, rigidbody] : mState.View<Transform, Rigidbody2D>().each()) {
+            if (rigidbody.type == BodyType::Static) continue;
+
+            const auto slot = entt::to_entity(entity);
+            if (slot >= mPreviousTransforms.size()) { mPreviousTransforms.resize(slot + 1); }
+            mPreviousTransforms[slot] = {entity, mFixedStep, transform.position, transform.rotation.x};
+        }
+
+        GatherBehaviors(engine);
+        for (const auto& [script, batch] : mBehaviorBatches) {
+            if (batch.Size() > 0) { engine.CallFixedUpdateBehaviors(script, batch, timeStep); }
         }
+
+        mCommands.Playback(mState);
+
+        // Parented static colliders are placed from the world transforms, bring them up to date for the physics step
+        mState.UpdateWorldTransforms();
     }
 
     void Scene::LateUpdate(ScriptEngine& engine) {
-        const auto iter = mState.View<Transform, Behavior>().each();
-        for (auto [entity, transform, behavior] : iter) {
-            BehaviorEntity behaviorEntity((u32)entity, mState.GetEntityName(entity), &transform);
-            engine.CallLateUpdateBehavior(behavior.script, behaviorEntity);
+        GatherBehaviors(engine);
+        for (const auto& [script, batch] : mBehaviorBatches) {
+            if (batch.Size() > 0) { engine.CallLateUpdateBehaviors(script, batch); }
         }
+
+        mCommands.Playback(mState);
     }
 
     void Scene::Destroyed(ScriptEngine& engine) {
         const auto iter = mState.View<Transform, Behavior>().each();
         for (auto [entity, transform, behavior] : iter) {
-            BehaviorEntity behaviorEntity((u32)entity, mState.GetEntityName(entity), &transform);
+            BehaviorEntity behaviorEntity((u32)entity, mState.GetEntityNameID(entity), &transform, behavior.instance);
             engine.CallDestroyedBehavior(behavior.script, behaviorEntity);
         }
+
+        engine.StopRoutines();
+    }
+
+    void Scene::DispatchCollisionEvents(std::span<const ContactEvent> events, ScriptEngine& engine) {
+        if (events.empty()) return;
+
+        const auto addEvent = [&](const ContactEvent& event, Entity self, Entity other, u32 otherLayer) {
+            // Either side may have been destroyed between the physics step and now
+            if (!mState.IsValid(self)) return;
+
+            const auto* behavior = mState.TryGetComponent<Behavior>(self);
+            if (!behavior || !engine.HasCollisionCallbacks(behavior->script)) return;
+
+            const auto* collider = mState.TryGetComponent<Collider2D>(self);
+            if (collider && !(collider->eventMask & otherLayer)) return;
+
+            auto& batches = event.type == ContactEventType::Begin ? mCollisionEnterBatches : mCollisionExitBatches;
+            batches[behavior->script].Add((u32)self, (u32)other, event.trigger, behavior->instance);
+        };
+
+        for (const auto& event : events) {
+            addEvent(event, event.a, event.b, event.layerB);
+            addEvent(event, event.b, event.a, event.layerA);
+        }
+
+        for (auto& [script, batch] : mCollisionEnterBatches) {
+            if (batch.Size() == 0) continue;
+            engine.CallCollisionEnterBehavior(script, batch);
+            batch.Clear();
+        }
+
+        for (auto& [script, batch] : mCollisionExitBatches) {
+            if (batch.Size() == 0) continue;
+            engine.CallCollisionExitBehavior(script, batch);
+            batch.Clear();
+        }
+    }
+
+    void Scene::DispatchEvents(const EventBus& events, ScriptEngine& engine) {
+        if (events.GetEventCount() == 0) return;
+
+        events.ForEach([&](const ScriptEvent& event) {
+            if (!engine.HasEventSubscribers(event.type)) return;
+
+            NameID targetName;
+            const Behavior* behavior = nullptr;
+            if (event.target != EventBus::kNoEntity) {
+                const auto target = CAST<Entity>(event.target);
+                if (!mState.IsValid(target)) return;
+
+                targetName = mState.GetEntityNameID(target);
+                behavior   = mState.TryGetComponent<Behavior>(target);
+            }
+            engine.QueueEvent(event, targetName, behavior);
+        });
+
+        engine.DeliverEvents();
+    }
+
+    bool Scene::Instantiate(NameID prefab, u32 count, std::span<const Vec2> positions) {
+        ASTERA_ASSERT(positions.empty() || positions.size() == count);
+
+        const Prefab* found = mState.FindPrefab(prefab);
+        if (!found) {
+            Log::Warn("Scene", "No prefab named '{}'", prefab.ToString());
+            return false;
+        }
+
+        if (positions.empty()) {
+            mCommands.Instantiate(*found, count);
+            return true;
+        }
+
+        mInstanceTransforms.assign(count, found->transform);
+        for (u32 i = 0; i < count; ++i) {
+            mInstanceTransforms[i].position = positions[i];
+        }
+        mCommands.Instantiate(*found, count, mInstanceTransforms);
+        return true;
+    }
+
+    EntityPool* Scene::CreatePool(NameID prefab, u32 capacity) {
+        const Prefab* found = mState.FindPrefab(prefab);
+        if (!found) {
+            Log::Warn("Scene", "No prefab named '{}'", prefab.ToString());
+            return nullptr;
+        }
+
+        auto& pool = mPools[prefab];
+        pool       = make_unique<EntityPool>(mState, *found, capacity);
+        return pool.get();
+    }
+
+    std::span<const EntityPoolStats> Scene::GetPoolStats() {
+        mPoolStats.clear();
+        for (const auto& [prefab, pool] : mPools) {
+            mPoolStats.push_back(pool->GetStats());
+        }
+        return mPoolStats;
     }
 
-    void Scene::Render(RenderContext& context) {
+    void Scene::Render(RenderContext& context, f32 interpolationAlpha) {
         u32 screenWidth = 0, screenHeight = 0;
         context.GetViewportDimensions(screenWidth, screenHeight);
 
-        const auto iter = mState.View<Transform, SpriteRenderer>().each();
-        for (auto [entity, transform, sprite] : iter) {
-            context.Submit(DrawSpriteCommand {&sprite, &transform, {screenWidth, screenHeight}, {1, 1, 1, 1}});
+        const auto screenSize = Vec2(screenWidth, screenHeight);
+        const Mat4 projection = Coordinates::CreateScreenProjection(screenSize.x, screenSize.y);
+
+        mState.UpdateWorldTransforms();
+
+        const auto tilemaps = mState.View<WorldTransform, Tilemap>().each();
+        for (auto [entity, world, tilemap] : tilemaps) {
+            if (!tilemap.tileset.IsValid()) continue;
+
+            tilemap.RebuildDirtyChunks();
+
+            const Mat4& model = world.matrix;
+            u32 minX, minY, maxX, maxY;
+            if (!tilemap.GetVisibleChunks(model, {0, 0}, screenSize, minX, minY, maxX, maxY)) continue;
+
+            const Mat4 mvp      = projection * model;
+            const u32 textureId = tilemap.tileset->GetID();
+            const u64 sortKey   = MakeSortKey(tilemap.layer, textureId);
+
+            for (u32 y = minY; y <= maxY; ++y) {
+                for (u32 x = minX; x <= maxX; ++x) {
+                    const auto& chunk = tilemap.GetChunk(x, y);
+                    if (chunk.indexCount == 0) continue;
+
+                    context.Submit(
+                      DrawTilemapChunkCommand {chunk.vertexArray, chunk.indexCount, textureId, mvp, sortKey});
+                }
+            }
+        }
+
+        const auto sprites = mState.View<Transform, WorldTransform, SpriteRenderer>().each();
+        for (auto [entity, transform, world, sprite] : sprites) {
+            Mat4 model = world.matrix;
+
+            // Bodies moved by the last fixed update are drawn part way between where it started and ended
+            const auto slot = entt::to_entity(entity);
+            if (slot < mPreviousTransforms.size()) {
+                const auto& previous = mPreviousTransforms[slot];
+                if (previous.entity == entity && previous.fixedStep == mFixedStep) {
+                    Transform blended  = transform;
+                    blended.position   = glm::mix(previous.position, transform.position, interpolationAlpha);
+                    // Rotation turns along the shorter arc, so crossing +-180 degrees doesn't spin the sprite around
+                    const f32 turn     = std::remainder(transform.rotation.x - previous.rotation, 360.0f);
+                    blended.rotation.x = previous.rotation + turn * interpolationAlpha;
+
+                    model               = blended.GetMatrix();
+                    const Entity parent = mState.GetParent(entity);
+                    if (parent != entt::null) { model = mState.GetWorldTransform(parent).matrix * model; }
+                }
+            }
+
+            context.Submit(
+              DrawSpriteCommand {&sprite, model, screenSize, {1, 1, 1, 1}, MakeSortKey(0, sprite.sprite->GetID())});
         }
     }
 
@@ -101,6 +365,7 @@ namespace Astera {
     }
 
     void Scene::LoadDescriptor(const SceneDescriptor& descriptor, ScriptEngine& engine) {
+        engine.StopRoutines();
         Reset();
 
         SceneParser::DescriptorToScene(descriptor, this, engine);
@@ -108,8 +373,25 @@ namespace Astera {
         Awake(engine);
     }
 
+    bool Scene::ReloadScript(const ScriptEngine::ScriptID script, const string& source, ScriptEngine& engine) {
+        // Inactive and pooled entities keep their instance tables, so they're refreshed too
+        mNewInstances.clear();
+        for (auto [entity, behavior] : mState.ViewAll<Behavior>().each()) {
+            if (behavior.script == script) { mNewInstances.push_back(behavior.instance); }
+        }
+
+        return engine.ReloadScript(source, script, mNewInstances);
+    }
+
     void Scene::Reset() {
+        mPools.clear();
         mState.Reset();
         mResourceManager.Clear();
+        mCollisionEnterBatches.clear();
+        mCollisionExitBatches.clear();
+        mBehaviorBatches.clear();
+        mRoutineBatches.clear();
+        mPreviousTransforms.clear();
+        mCommands.Clear();
     }
 }  // namespace Astera
\ No newline at end of file
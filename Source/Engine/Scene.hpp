@@ -32,13 +32,20 @@
 #include "EngineCommon.hpp"
 #include "SceneState.hpp"
 #include "ScriptEngine.hpp"
+#include "SystemScheduler.hpp"
+#include "EntityCommandBuffer.hpp"
+#include "EntityPool.hpp"
 #include "ResourceManager.hpp"
 #include "SceneDescriptor.hpp"
 #include "TextureLoader.hpp"
 #include "SoundLoader.hpp"
 #include "Rendering/RenderContext.hpp"
 
+#include <span>
+
 namespace Astera {
+    struct ContactEvent;
+
     /// @brief Represents a game scene with lifecycle management and rendering capabilities
     class Scene {
         friend class Game;
@@ -57,10 +64,20 @@ namespace Astera {
         void Awake(ScriptEngine& engine);
 
         /// @brief Called every frame to update scene logic
+        ///
+        /// Behaviors run grouped by script. A script that defines OnUpdateBatch is called once with all of its
+        /// entities, the same goes for the fixed and late phases.
         /// @param clock Reference to the game clock for timing information
         /// @param engine Script engine reference
         void Update(const Clock& clock, ScriptEngine& engine);
 
+        /// @brief Called at the fixed update rate, before the physics step
+        ///
+        /// Records the state of every moving rigid body so Render can blend between the last two fixed updates.
+        /// @param timeStep Fixed time step in seconds
+        /// @param engine Script engine reference
+        void FixedUpdate(f32 timeStep, ScriptEngine& engine);
+
         /// @brief Called after all Update calls have completed for the frame
         /// @param engine Script engine reference
         void LateUpdate(ScriptEngine& engine);
@@ -69,9 +86,26 @@ namespace Astera {
         /// @param engine Script engine reference
         void Destroyed(ScriptEngine& engine);
 
+        /// @brief Delivers contact events from the last physics update to behavior scripts
+        ///
+        /// Events are filtered by the receiving collider's event mask, then grouped per script so each script's
+        /// OnCollisionEnter and OnCollisionExit run at most once per call with the whole batch.
+        /// @param events Contact events from PhysicsEngine::GetContactEvents
+        /// @param engine Script engine reference
+        void DispatchCollisionEvents(std::span<const ContactEvent> events, ScriptEngine& engine);
+
+        /// @brief Delivers the events sent last frame to the scripts subscribed to them
+        ///
+        /// Each subscription is called once with every event that passed its filter. Events whose target has been
+        /// destroyed since they were sent are dropped.
+        /// @param events Bus whose readable events are delivered
+        /// @param engine Script engine reference
+        void DispatchEvents(const EventBus& events, ScriptEngine& engine);
+
         /// @brief Renders the scene to the screen
         /// @param context Render context reference
-        void Render(RenderContext& context);
+        /// @param interpolationAlpha Blend between the previous and current fixed update state of rigid bodies
+        void Render(RenderContext& context, f32 interpolationAlpha = 1.0f);
 
         /// @brief Loads a scene from a descriptor file
         /// @param filename Path to the scene file to load
@@ -88,6 +122,14 @@ namespace Astera {
         /// @param engine Script engine reference
         void LoadDescriptor(const SceneDescriptor& descriptor, ScriptEngine& engine);
 
+        /// @brief Swaps in a new version of a behavior script without reloading the scene, see
+        /// ScriptEngine::ReloadScript
+        /// @param script The script that changed
+        /// @param source Its new Lua source code
+        /// @param engine Script engine reference
+        /// @return True if the new version loaded
+        bool ReloadScript(ScriptEngine::ScriptID script, const string& source, ScriptEngine& engine);
+
         /// @brief Resets the scene. Clears the state and frees resource pool memory
         void Reset();
 
@@ -107,11 +149,97 @@ namespace Astera {
             return mResourceManager;
         }
 
+        /// @brief Gets the buffer for deferred structural changes. It is played back after the behaviors and systems in
+        /// FixedUpdate, Update and LateUpdate.
+        /// @return Reference to the scene's command buffer
+        ASTERA_KEEP EntityCommandBuffer& GetCommands() {
+            return mCommands;
+        }
+
+        /// @brief Spawns copies of a registered prefab at the next command buffer playback, so behaviors and systems
+        /// can call it while iterating the scene
+        /// @param prefab Name of the prefab
+        /// @param count Number of instances
+        /// @param positions Position of each instance, or empty to keep the prefab's
+        /// @returns False if no prefab is registered with that name
+        bool Instantiate(NameID prefab, u32 count, std::span<const Vec2> positions = {});
+
+        /// @brief Creates a pool of a registered prefab's instances, replacing any existing pool of it. Don't call
+        /// while the scene is being iterated.
+        /// @param prefab Name of the prefab
+        /// @param capacity Number of instances
+        /// @returns The pool, or nullptr if no prefab is registered with that name
+        EntityPool* CreatePool(NameID prefab, u32 capacity);
+
+        /// @brief Finds the pool of a prefab, pooled entities are named after their prefab
+        /// @returns The pool, or nullptr if the prefab isn't pooled
+        ASTERA_KEEP EntityPool* FindPool(NameID prefab) {
+            const auto it = mPools.find(prefab);
+            return it != mPools.end() ? it->second.get() : nullptr;
+        }
+
+        /// @brief Gets the occupancy of every pool
+        ASTERA_KEEP std::span<const EntityPoolStats> GetPoolStats();
+
+        /// @brief Gets the native systems run after behaviors each Update
+        /// @return Reference to the scene's system scheduler
+        ASTERA_KEEP SystemScheduler& GetSystems() {
+            return mSystems;
+        }
+
     private:
         /// @brief Internal state data for the scene
         SceneState mState;
 
         /// @brief Resource manager for managing memory on a per-scene basis
         ResourceManager mResourceManager;
+
+        /// @brief Native systems, registered from code and kept across scene loads
+        SystemScheduler mSystems;
+
+        /// @brief Structural changes recorded while iterating, see GetCommands
+        EntityCommandBuffer mCommands;
+        vector<Transform> mInstanceTransforms;  ///< Scratch for Instantiate
+
+        unordered_map<NameID, unique_ptr<EntityPool>> mPools;
+        vector<EntityPoolStats> mPoolStats;
+
+        /// @brief Transform of a rigid body before the most recent fixed update
+        struct PreviousTransform {
+            Entity entity {entt::null};
+            u32 fixedStep {0};  ///< Fixed update that recorded this entry, older entries are stale
+            Vec2 position {0.0f};
+            f32 rotation {0.0f};
+        };
+
+        /// @brief Indexed by entity slot
+        vector<PreviousTransform> mPreviousTransforms;
+        u32 mFixedStep {0};
+
+        /// @brief Entities grouped by behavior script for the current phase, kept between frames to reuse their storage
+        unordered_map<ScriptEngine::ScriptID, BehaviorBatch> mBehaviorBatches;
+
+        /// @brief Groups every active entity with a behavior into mBehaviorBatches
+        void GatherBehaviors(ScriptEngine& engine);
+
+        /// @brief Pools the instance tables of destroyed entities, then gives the entities that don't have one yet
+        /// theirs, in one call per script. Those entities' routines are queued for StartRoutines.
+        void SyncScriptInstances(ScriptEngine& engine);
+
+        struct PendingInstance {
+            Entity entity;
+            Behavior* behavior;
+        };
+
+        vector<PendingInstance> mPendingInstances;  ///< Scratch for SyncScriptInstances
+        vector<i32> mNewInstances;                  ///< Scratch for SyncScriptInstances and ReloadScript
+
+        /// @brief Starts the routines queued by SyncScriptInstances
+        void StartRoutines(ScriptEngine& engine);
+        unordered_map<ScriptEngine::ScriptID, BehaviorBatch> mRoutineBatches;
+
+        /// @brief Per-script collision batches, kept between frames to reuse their storage
+        unordered_map<ScriptEngine::ScriptID, CollisionEventBatch> mCollisionEnterBatches;
+        unordered_map<ScriptEngine::ScriptID, CollisionEventBatch> mCollisionExitBatches;
     };
 }  // namespace Astera
\ No newline at end of file
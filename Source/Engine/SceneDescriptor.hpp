@@ -40,26 +40,34 @@ namespace Astera {
 
     struct CameraDescriptor {};
 
-    struct Collider2DDescriptor {};
+    struct Collider2DDescriptor {
+        string shape {"AABB"};  // "AABB", "Circle", or "OBB"
+        Vec2 size {1.0f, 1.0f};
+        f32 radius {0.5f};
+        Vec2 offset {0.0f};
+        bool isTrigger {false};
+    };
 
     struct Rigidbody2DDescriptor {
-        string type;  // "Static", "Dynamic", or "Kinematic"
-        Vec2 velocity;
-        Vec2 acceleration;
-        Vec2 force;
-        f32 angularVelocity;
-        f32 angularAcceleration;
-        f32 torque;
-        f32 mass;
-        f32 inverseMass;
-        f32 inertia;
-        f32 inverseInertia;
-        f32 restitution;
-        f32 friction;
-        f32 linearDamping;
-        f32 angularDamping;
-        f32 gravityScale;
-        bool lockRotation;
+        string type {"Dynamic"};  // "Static", "Dynamic", or "Kinematic"
+        Vec2 velocity {0.0f};
+        Vec2 acceleration {0.0f};
+        Vec2 force {0.0f};
+        f32 angularVelocity {0.0f};
+        f32 angularAcceleration {0.0f};
+        f32 torque {0.0f};
+        f32 mass {1.0f};
+        f32 inverseMass {1.0f};
+        f32 inertia {1.0f};
+        f32 inverseInertia {1.0f};
+        f32 restitution {0.5f};
+        f32 friction {0.3f};
+        f32 linearDamping {0.01f};
+        f32 angularDamping {0.01f};
+        f32 gravityScale {1.0f};
+        bool lockRotation {false};
+        bool allowSleep {true};
+        bool bullet {false};
     };
 
     struct TransformDescriptor {
@@ -76,9 +84,20 @@ namespace Astera {
         AssetID script;
     };
 
+    struct TilemapDescriptor {
+        AssetID tileset;
+        u32 tilesetColumns {1};
+        u32 tilesetRows {1};
+        Vec2 tileSize {32.0f, 32.0f};
+        i16 layer {-1};
+        AssetID source {kInvalidAssetID};  // Tilemap asset containing CSV tile data
+        string data;                       // Inline CSV tile data, used when no source asset is given
+    };
+
     struct EntityDescriptor {
         u32 id {};
         string name {};
+        optional<u32> parent {};  // Descriptor id of the parent entity
         TransformDescriptor transform {};
         optional<SpriteRendererDescriptor> spriteRenderer {};
         optional<BehaviorDescriptor> behavior {};
@@ -86,11 +105,14 @@ namespace Astera {
         optional<Collider2DDescriptor> collider2D {};
         optional<CameraDescriptor> camera {};
         optional<SoundSourceDescriptor> soundSource {};
+        optional<TilemapDescriptor> tilemap {};
+        u32 poolSize {0};  // Prefabs only, number of pooled instances to create with the scene
     };
 
     struct SceneDescriptor {
         string name;
         bool entry {false};
         vector<EntityDescriptor> entities;
+        vector<EntityDescriptor> prefabs;  // Entity templates spawned at runtime, ids and parents are ignored
     };
 }  // namespace Astera
@@ -113,10 +113,40 @@ namespace Astera {
         if (const auto node = rigidbodyNode.child("LockRotation")) {
             rigidbody.lockRotation = ASTERA_STREQ(node.child_value(), "true") ? true : false;
         }
+        if (const auto node = rigidbodyNode.child("AllowSleep")) {
+            rigidbody.allowSleep = ASTERA_STREQ(node.child_value(), "true") ? true : false;
+        }
+        if (const auto node = rigidbodyNode.child("Bullet")) {
+            rigidbody.bullet = ASTERA_STREQ(node.child_value(), "true") ? true : false;
+        }
 
         return rigidbody;
     }
 
+    static Collider2DDescriptor ParseColliderComponentXML(const pugi::xml_node& colliderNode) {
+        Collider2DDescriptor collider {};
+
+        if (const auto node = colliderNode.child("Shape")) {
+            collider.shape = node.child_value();
+        }
+        if (const auto node = colliderNode.child("Size")) {
+            collider.size.x = node.attribute("x").as_float(1.0f);
+            collider.size.y = node.attribute("y").as_float(1.0f);
+        }
+        if (const auto node = colliderNode.child("Radius")) {
+            collider.radius = StringConvert::StringToF32Or(node.child_value(), 0.5f);
+        }
+        if (const auto node = colliderNode.child("Offset")) {
+            collider.offset.x = node.attribute("x").as_float();
+            collider.offset.y = node.attribute("y").as_float();
+        }
+        if (const auto node = colliderNode.child("IsTrigger")) {
+            collider.isTrigger = ASTERA_STREQ(node.child_value(), "true");
+        }
+
+        return collider;
+    }
+
     static TransformDescriptor ParseTransformComponentXML(const pugi::xml_node& transformNode) {
         TransformDescriptor transform {};
 
@@ -158,10 +188,39 @@ namespace Astera {
         return behavior;
     }
 
+    static TilemapDescriptor ParseTilemapComponentXML(const pugi::xml_node& tilemapNode) {
+        TilemapDescriptor tilemap {};
+
+        if (const auto node = tilemapNode.child("Tileset")) {
+            tilemap.tileset        = StringConvert::StringToU64Or(node.child_value(), kInvalidAssetID);
+            tilemap.tilesetColumns = node.attribute("columns").as_uint(1);
+            tilemap.tilesetRows    = node.attribute("rows").as_uint(1);
+        }
+        if (const auto node = tilemapNode.child("TileSize")) {
+            tilemap.tileSize.x = node.attribute("x").as_float();
+            tilemap.tileSize.y = node.attribute("y").as_float();
+        }
+        if (const auto node = tilemapNode.child("Layer")) {
+            tilemap.layer = CAST<i16>(StringConvert::StringToI32Or(node.child_value(), -1));
+        }
+        if (const auto node = tilemapNode.child("Source")) {
+            tilemap.source = StringConvert::StringToU64Or(node.child_value(), kInvalidAssetID);
+        }
+        if (const auto node = tilemapNode.child("Data")) {
+            tilemap.data = node.child_value();
+        }
+
+        return tilemap;
+    }
+
     static void ParseEntityXML(const pugi::xml_node& entityNode, EntityDescriptor& entity) {
         entity.id   = entityNode.attribute("id").as_int();
         entity.name = entityNode.attribute("name").as_string();
 
+        if (const auto parent = entityNode.attribute("parent")) {
+            entity.parent = parent.as_uint();
+        }
+
         const auto componentsNode = entityNode.child("Components");
         if (!componentsNode) {
             throw std::runtime_error("Entity is missing Transform component.");
@@ -186,7 +245,7 @@ namespace Astera {
         }
 
         if (const auto node = componentsNode.child("Collider2D")) {
-            entity.collider2D = {};  // TODO
+            entity.collider2D = ParseColliderComponentXML(node);
         }
 
         if (const auto node = componentsNode.child("Camera")) {
@@ -196,6 +255,10 @@ namespace Astera {
         if (const auto node = componentsNode.child("SoundSource")) {
             entity.soundSource = ParseSoundSourceComponentXML(node);
         }
+
+        if (const auto node = componentsNode.child("Tilemap")) {
+            entity.tilemap = ParseTilemapComponentXML(node);
+        }
     }
 
     void SceneParser::StateToDescriptor(const SceneState& state, SceneDescriptor& outDescriptor) {
@@ -203,6 +266,15 @@ namespace Astera {
     }
 
     void SceneParser::DescriptorToScene(const SceneDescriptor& descriptor, Scene* scene, ScriptEngine& scriptEngine) {
+        for (const auto& prefab : descriptor.prefabs) {
+            scene->GetState().AddPrefab(DescriptorToPrefab(prefab, scene, scriptEngine));
+            Log::Info("SceneParser", "Loaded prefab '{}'", prefab.name);
+
+            if (prefab.poolSize > 0) { scene->CreatePool(NameID(prefab.name), prefab.poolSize); }
+        }
+
+        unordered_map<u32, Entity> entitiesById;
+
         for (const auto& entity : descriptor.entities) {
             auto builder = EntityBuilder::Create(scene, entity.name);
             builder.SetTransform(entity.transform);
@@ -231,9 +303,65 @@ namespace Astera {
                 builder.AddSoundSource(*entity.soundSource);
             }
 
-            const auto newEntity = builder.Build();
+            if (entity.tilemap.has_value()) {
+                builder.AddTilemap(*entity.tilemap);
+            }
+
+            const auto newEntity    = builder.Build();
+            entitiesById[entity.id] = newEntity;
             Log::Info("SceneParser", "Loaded entity '{} (ID: {})' to scene state", entity.name, (u32)newEntity);
         }
+
+        // Parents may be declared after their children, so links are resolved once every entity exists
+        for (const auto& entity : descriptor.entities) {
+            if (!entity.parent.has_value()) continue;
+
+            const auto parent = entitiesById.find(*entity.parent);
+            if (parent == entitiesById.end()) {
+                Log::Warn("SceneParser", "Entity '{}' has unknown parent id {}", entity.name, *entity.parent);
+                continue;
+            }
+
+            scene->GetState().SetParent(entitiesById.at(entity.id), parent->second);
+        }
+    }
+
+    Prefab SceneParser::DescriptorToPrefab(const EntityDescriptor& descriptor,
+                                           Scene* scene,
+                                           ScriptEngine& scriptEngine) {
+        if (descriptor.name.empty()) {
+            throw std::runtime_error("Prefab is missing a name");
+        }
+
+        Prefab prefab;
+        prefab.name      = NameID(descriptor.name);
+        prefab.transform = EntityBuilder::MakeTransform(descriptor.transform);
+
+        if (descriptor.spriteRenderer.has_value()) {
+            prefab.spriteRenderer = EntityBuilder::MakeSpriteRenderer(scene, *descriptor.spriteRenderer);
+        }
+
+        if (descriptor.behavior.has_value()) {
+            prefab.behavior = EntityBuilder::MakeBehavior(*descriptor.behavior, scriptEngine);
+        }
+
+        if (descriptor.rigidbody2D.has_value()) {
+            prefab.rigidbody2D = EntityBuilder::MakeRigidbody2D(*descriptor.rigidbody2D);
+        }
+
+        if (descriptor.collider2D.has_value()) {
+            prefab.collider2D = EntityBuilder::MakeCollider2D(*descriptor.collider2D);
+        }
+
+        if (descriptor.soundSource.has_value()) {
+            prefab.soundSource = EntityBuilder::MakeSoundSource(scene, *descriptor.soundSource);
+        }
+
+        if (descriptor.tilemap.has_value()) {
+            Log::Warn("SceneParser", "Prefab '{}' has a Tilemap, which prefabs don't support", descriptor.name);
+        }
+
+        return prefab;
     }
 
     void SceneParser::SerializeDescriptorXML(const SceneDescriptor& descriptor, const Path& filename) {
@@ -335,6 +463,16 @@ namespace Astera {
                 outDescriptor.entities.push_back(entity);
             }
         }
+
+        // Parse prefabs, they use the same layout as entities
+        if (const auto prefabsNode = sceneNode.child("Prefabs")) {
+            for (auto prefabNode : prefabsNode.children("Prefab")) {
+                EntityDescriptor prefab {};
+                ParseEntityXML(prefabNode, prefab);
+                prefab.poolSize = prefabNode.attribute("pool").as_uint(0);
+                outDescriptor.prefabs.push_back(prefab);
+            }
+        }
     }
 
     void SceneParser::DeserializeDescriptorBytes(const vector<u8>& bytes, SceneDescriptor& outDescriptor) {
@@ -34,6 +34,7 @@
 
 namespace Astera {
     struct SceneDescriptor;
+    struct Prefab;
     class Scene;
     class SceneState;
     class ScriptEngine;
@@ -52,6 +53,13 @@ namespace Astera {
         /// @param scriptEngine Reference to the script engine for initializing scripts
         static void DescriptorToScene(const SceneDescriptor& descriptor, Scene* scene, ScriptEngine& scriptEngine);
 
+        /// @brief Resolves an entity descriptor into a prefab, loading its resources and script once for every instance
+        /// @param descriptor The entity template to convert from
+        /// @param scene The scene whose resource manager loads the prefab's resources
+        /// @param scriptEngine Reference to the script engine for initializing scripts
+        /// @returns Prefab named after the descriptor
+        static Prefab DescriptorToPrefab(const EntityDescriptor& descriptor, Scene* scene, ScriptEngine& scriptEngine);
+
         /// @brief Serializes a scene descriptor to XML
         /// @param descriptor The descriptor to serialize
         /// @param filename Output file to save to
@@ -28,13 +28,40 @@
 
 #include "SceneState.hpp"
 #include "Log.hpp"
+#include "JobSystem.hpp"
+
+#include <algorithm>
+#include <unordered_set>
 
 namespace Astera {
-    SceneState::SceneState() = default;
-    SceneState::SceneState(SceneState&& other) noexcept : mRegistry(std::exchange(other.mRegistry, {})) {}
+    SceneState::SceneState() {
+        // Every View reads this storage, creating it up front keeps systems on workers from creating it concurrently
+        mRegistry.storage<Inactive>();
+    }
+
+    SceneState::SceneState(SceneState&& other) noexcept
+        : mRegistry(std::exchange(other.mRegistry, {})), mEntityNames(std::exchange(other.mEntityNames, {})),
+          mEntitiesByName(std::exchange(other.mEntitiesByName, {})), mPrefabs(std::exchange(other.mPrefabs, {})),
+          mHierarchyDirty(true), mRetiredBehaviors(std::exchange(other.mRetiredBehaviors, {})) {
+        other.mRegistry.storage<Inactive>();
+    }
 
     SceneState& SceneState::operator=(SceneState&& other) noexcept {
-        if (this != &other) { mRegistry = std::exchange(other.mRegistry, {}); }
+        if (this != &other) {
+            for (const auto& behavior : mRegistry.storage<Behavior>()) {
+                RetireBehavior(behavior);
+            }
+
+            mRegistry       = std::exchange(other.mRegistry, {});
+            mEntityNames    = std::exchange(other.mEntityNames, {});
+            mEntitiesByName = std::exchange(other.mEntitiesByName, {});
+            mPrefabs        = std::exchange(other.mPrefabs, {});
+            mHierarchyDirty = true;
+            mRetiredBehaviors.insert(
+              mRetiredBehaviors.end(), other.mRetiredBehaviors.begin(), other.mRetiredBehaviors.end());
+            other.mRetiredBehaviors.clear();
+            other.mRegistry.storage<Inactive>();
+        }
         return *this;
     }
 
@@ -42,15 +69,148 @@ namespace Astera {
         ASTERA_ASSERT(!name.empty());
         const auto entity = mRegistry.create();
         mRegistry.emplace<Transform>(entity);
+        mRegistry.emplace<WorldTransform>(entity);
 
-        mEntityNames[entity] = name;
+        AddEntityName(entity, NameID(name));
 
         return entity;
     }
 
+    void SceneState::CreateEntities(std::span<const NameID> names, std::span<Entity> outEntities) {
+        ASTERA_ASSERT(names.size() == outEntities.size());
+        const size_t count = outEntities.size();
+
+        auto& transforms = mRegistry.storage<Transform>();
+        auto& worlds     = mRegistry.storage<WorldTransform>();
+        transforms.reserve(transforms.size() + count);
+        worlds.reserve(worlds.size() + count);
+
+        mRegistry.create(outEntities.begin(), outEntities.end());
+        mRegistry.insert<Transform>(outEntities.begin(), outEntities.end());
+        mRegistry.insert<WorldTransform>(outEntities.begin(), outEntities.end());
+
+        for (size_t i = 0; i < count; ++i) {
+            ASTERA_ASSERT(!names[i].IsNone());
+            AddEntityName(outEntities[i], names[i]);
+        }
+    }
+
+    void SceneState::Instantiate(const Prefab& prefab,
+                                 size_t count,
+                                 std::span<const Transform> transforms,
+                                 std::span<Entity> outEntities) {
+        ASTERA_ASSERT(!prefab.name.IsNone());
+        ASTERA_ASSERT(transforms.empty() || transforms.size() == count);
+        ASTERA_ASSERT(outEntities.empty() || outEntities.size() == count);
+        if (count == 0) return;
+
+        vector<Entity> created;
+        if (outEntities.empty()) {
+            created.resize(count);
+            outEntities = created;
+        }
+
+        const auto insertPrototype = [&]<typename Component>(const Component& prototype) {
+            auto& storage = mRegistry.storage<Component>();
+            storage.reserve(storage.size() + count);
+            mRegistry.insert<Component>(outEntities.begin(), outEntities.end(), prototype);
+        };
+
+        mRegistry.create(outEntities.begin(), outEntities.end());
+        if (transforms.empty()) {
+            insertPrototype(prefab.transform);
+        } else {
+            auto& storage = mRegistry.storage<Transform>();
+            storage.reserve(storage.size() + count);
+            mRegistry.insert<Transform>(outEntities.begin(), outEntities.end(), transforms.begin());
+        }
+        insertPrototype(WorldTransform {});
+
+        if (prefab.spriteRenderer) { insertPrototype(*prefab.spriteRenderer); }
+        if (prefab.behavior) { insertPrototype(*prefab.behavior); }
+        if (prefab.rigidbody2D) { insertPrototype(*prefab.rigidbody2D); }
+        if (prefab.collider2D) { insertPrototype(*prefab.collider2D); }
+        if (prefab.soundSource) { insertPrototype(*prefab.soundSource); }
+
+        for (const auto entity : outEntities) {
+            AddEntityName(entity, prefab.name);
+        }
+    }
+
+    void SceneState::AddPrefab(Prefab prefab) {
+        ASTERA_ASSERT(!prefab.name.IsNone());
+        const NameID name = prefab.name;
+        mPrefabs.insert_or_assign(name, std::move(prefab));
+    }
+
+    const Prefab* SceneState::FindPrefab(NameID name) const {
+        const auto it = mPrefabs.find(name);
+        return it != mPrefabs.end() ? &it->second : nullptr;
+    }
+
     void SceneState::DestroyEntity(Entity entity) {
-        mRegistry.destroy(entity);
-        mEntityNames.erase(entity);
+        DestroyEntities({&entity, 1});
+    }
+
+    void SceneState::DestroyEntities(std::span<const Entity> entities) {
+        // The same entity may be queued twice, or already be gone with an earlier destroyed parent
+        vector<Entity> destroyed;
+        destroyed.reserve(entities.size());
+        for (const auto entity : entities) {
+            if (mRegistry.valid(entity)) { destroyed.push_back(entity); }
+        }
+        std::ranges::sort(destroyed);
+        destroyed.erase(std::ranges::unique(destroyed).begin(), destroyed.end());
+
+        // Collect descendants one generation per pass over the child links
+        const auto& links = mRegistry.storage<Hierarchy>();
+        if (!links.empty()) {
+            std::unordered_set<Entity> parents(destroyed.begin(), destroyed.end());
+            const size_t requested = destroyed.size();
+            size_t generationStart = 0;
+            while (generationStart < destroyed.size()) {
+                const size_t generationEnd = destroyed.size();
+                for (auto [child, link] : mRegistry.view<Hierarchy>().each()) {
+                    if (parents.contains(link.parent) && !parents.contains(child)) { destroyed.push_back(child); }
+                }
+                for (size_t i = generationEnd; i < destroyed.size(); ++i) {
+                    parents.insert(destroyed[i]);
+                }
+                generationStart = generationEnd;
+            }
+
+            const bool hadLinks = std::ranges::any_of(destroyed, [&](Entity entity) { return links.contains(entity); });
+            mHierarchyDirty     = mHierarchyDirty || destroyed.size() > requested || hadLinks;
+        }
+
+        const auto& behaviors = mRegistry.storage<Behavior>();
+        for (const auto entity : destroyed) {
+            RemoveEntityName(entity);
+            if (behaviors.contains(entity)) { RetireBehavior(behaviors.get(entity)); }
+        }
+        mRegistry.destroy(destroyed.begin(), destroyed.end());
+    }
+
+    void SceneState::AddEntityName(Entity entity, NameID name) {
+        auto& sameName  = mEntitiesByName[name];
+        const auto slot = entt::to_entity(entity);
+        if (slot >= mEntityNames.size()) { mEntityNames.resize(slot + 1); }
+
+        mEntityNames[slot] = {name, CAST<u32>(sameName.size())};
+        sameName.push_back(entity);
+    }
+
+    void SceneState::RemoveEntityName(Entity entity) {
+        auto& entry        = mEntityNames[entt::to_entity(entity)];
+        auto& sameName     = mEntitiesByName[entry.name];
+        const Entity moved = sameName.back();
+
+        // Swap with the last entity of the same name, keeping removal O(1) however many share it
+        sameName[entry.index]                      = moved;
+        mEntityNames[entt::to_entity(moved)].index = entry.index;
+        sameName.pop_back();
+
+        entry = {};
     }
 
     size_t SceneState::GetEntityCount() const {
@@ -58,20 +218,188 @@ namespace Astera {
         return CAST<size_t>(Astera::Distance(iter));
     }
 
+    void SceneState::SetActive(Entity entity, bool active) {
+        ASTERA_ASSERT(mRegistry.valid(entity));
+        if (active) {
+            mRegistry.remove<Inactive>(entity);
+        } else if (!mRegistry.all_of<Inactive>(entity)) {
+            mRegistry.emplace<Inactive>(entity);
+        }
+    }
+
     Transform& SceneState::GetTransform(Entity entity) {
         return GetComponent<Transform>(entity);
     }
 
-    const string& SceneState::GetEntityName(Entity entity) const {
-        return mEntityNames.at(entity);
+    bool SceneState::SetParent(Entity child, Entity parent) {
+        ASTERA_ASSERT(mRegistry.valid(child));
+
+        if (parent == entt::null) {
+            if (mRegistry.remove<Hierarchy>(child) > 0) {
+                mRegistry.get<WorldTransform>(child).cached = false;
+                mHierarchyDirty                             = true;
+            }
+            return true;
+        }
+
+        ASTERA_ASSERT(mRegistry.valid(parent));
+        for (Entity ancestor = parent; ancestor != entt::null; ancestor = GetParent(ancestor)) {
+            if (ancestor == child) {
+                Log::Warn("SceneState",
+                          "Can't parent '{}' to its own descendant '{}'",
+                          GetEntityName(child),
+                          GetEntityName(parent));
+                return false;
+            }
+        }
+
+        mRegistry.emplace_or_replace<Hierarchy>(child, parent);
+        mRegistry.get<WorldTransform>(child).cached = false;
+        mHierarchyDirty                             = true;
+        return true;
+    }
+
+    Entity SceneState::GetParent(Entity entity) const {
+        const auto* link = mRegistry.try_get<Hierarchy>(entity);
+        return link ? link->parent : entt::null;
+    }
+
+    /// @brief Rebuilds one cached world transform if its local transform or its parent changed
+    static void UpdateWorldTransform(const Transform& local, WorldTransform& world, const WorldTransform* parent) {
+        world.changed = !world.cached || local != world.local || (parent && parent->changed);
+        if (!world.changed) return;
+
+        world.local  = local;
+        world.cached = true;
+
+        if (!parent) {
+            world.matrix   = local.GetMatrix();
+            world.position = local.position;
+            world.rotation = local.rotation.x;
+            world.scale    = local.scale;
+            return;
+        }
+
+        world.matrix   = parent->matrix * local.GetMatrix();
+        world.position = Vec2(world.matrix[3]);
+        world.rotation = parent->rotation + local.rotation.x;
+        world.scale    = parent->scale * local.scale;
+    }
+
+    /// @brief Runs func over [start, end) on the job system, inline when the range fits in one chunk
+    template<typename Func>
+    static void ForEachInRange(size_t start, size_t end, Func&& func) {
+        static constexpr size_t kChunkSize = 1024;
+
+        if (end - start <= kChunkSize) {
+            for (size_t i = start; i < end; ++i) {
+                func(i);
+            }
+            return;
+        }
+
+        ParallelFor(start, end, func, kChunkSize);
+    }
+
+    /// @brief Component at an index into the packed array, storage iterators count from the back of it
+    template<typename Storage>
+    static auto& ComponentAt(Storage& storage, size_t index) {
+        return storage.begin()[CAST<std::ptrdiff_t>(storage.size() - 1 - index)];
+    }
+
+    void SceneState::UpdateWorldTransforms() {
+        // Fetch the storages up front, looking them up from workers could create them concurrently
+        auto& transforms  = mRegistry.storage<Transform>();
+        auto& worlds      = mRegistry.storage<WorldTransform>();
+        const auto& links = mRegistry.storage<Hierarchy>();
+
+        // Both are added by CreateEntity and only removed by destroying the entity, so they stay in the same order
+        // until the hierarchy changes
+        const size_t count = worlds.size();
+        if (mHierarchyDirty || transforms.size() != count ||
+            !std::equal(worlds.data(), worlds.data() + count, transforms.data())) {
+            RebuildHierarchyOrder();
+        }
+
+        // Roots sit after every child in the packed arrays, new entities are appended there without breaking the order
+        ForEachInRange(links.size(), count, [&](size_t i) {
+            UpdateWorldTransform(ComponentAt(transforms, i), ComponentAt(worlds, i), nullptr);
+        });
+
+        // One depth at a time, so every parent is final before its children read it
+        for (const auto& [start, end] : mHierarchyLevels) {
+            ForEachInRange(start, end, [&](size_t i) {
+                const Entity parent = links.get(worlds.data()[i]).parent;
+                UpdateWorldTransform(ComponentAt(transforms, i), ComponentAt(worlds, i), &worlds.get(parent));
+            });
+        }
+    }
+
+    void SceneState::RebuildHierarchyOrder() {
+        auto& links = mRegistry.storage<Hierarchy>();
+        for (auto [entity, link] : links.each()) {
+            u32 depth = 1;
+            for (Entity parent = link.parent; links.contains(parent); parent = links.get(parent).parent) {
+                ++depth;
+            }
+            link.depth = depth;
+        }
+
+        // Sorting follows iteration order, which walks the packed array backwards. Ordering shallow before deep leaves
+        // the deepest children at the front of the packed arrays and the roots at the back.
+        const auto depthOf = [&links](Entity entity) { return links.contains(entity) ? links.get(entity).depth : 0u; };
+        mRegistry.sort<WorldTransform>([&](Entity lhs, Entity rhs) { return depthOf(lhs) < depthOf(rhs); });
+        mRegistry.sort<Transform, WorldTransform>();
+
+        // Levels in update order, shallowest first
+        mHierarchyLevels.clear();
+        const auto& worlds = mRegistry.storage<WorldTransform>();
+        size_t end         = links.size();
+        while (end > 0) {
+            const u32 depth = depthOf(worlds.data()[end - 1]);
+            size_t start    = end - 1;
+            while (start > 0 && depthOf(worlds.data()[start - 1]) == depth) {
+                --start;
+            }
+            mHierarchyLevels.emplace_back(start, end);
+            end = start;
+        }
+
+        mHierarchyDirty = false;
+    }
+
+    Entity SceneState::FindEntityByName(std::string_view name) const {
+        const auto it = mEntitiesByName.find(NameID::Find(name));
+        return it != mEntitiesByName.end() && !it->second.empty() ? it->second.front() : entt::null;
+    }
+
+    void SceneState::FindEntitiesByName(std::string_view name, vector<Entity>& outEntities) const {
+        outEntities.clear();
+
+        const auto it = mEntitiesByName.find(NameID::Find(name));
+        if (it != mEntitiesByName.end()) { outEntities.assign(it->second.begin(), it->second.end()); }
     }
 
     SceneState::~SceneState() {
         Reset();
     }
 
+    void SceneState::ResetScriptInstance(Entity entity) {
+        if (auto* behavior = mRegistry.try_get<Behavior>(entity)) {
+            RetireBehavior(*behavior);
+            behavior->instance = Behavior::kNoInstance;
+        }
+    }
+
     void SceneState::Reset() {
+        for (const auto& behavior : mRegistry.storage<Behavior>()) {
+            RetireBehavior(behavior);
+        }
         mRegistry.clear();
         mEntityNames.clear();
+        mEntitiesByName.clear();
+        mPrefabs.clear();
+        mHierarchyLevels.clear();
+        mHierarchyDirty = false;
     }
 }  // namespace Astera
\ No newline at end of file
@@ -29,6 +29,8 @@
 #pragma once
 
 #include "EngineCommon.hpp"
+#include "NameID.hpp"
+#include "Prefab.hpp"
 
 #pragma region Components
 #include "Components/Camera.hpp"
@@ -38,10 +40,15 @@
 #include "Components/Rigidbody2D.hpp"
 #include "Components/Collider2D.hpp"
 #include "Components/SoundSource.hpp"
+#include "Components/Tilemap.hpp"
+#include "Components/Hierarchy.hpp"
+#include "Components/Inactive.hpp"
 #pragma endregion
 
 #include "Vendor/entt/entt.hpp"
 
+#include <span>
+
 namespace Astera {
     /// @brief Type alias for entt::entity. Casts to integer types as id value.
     using Entity = entt::entity;
@@ -52,7 +59,7 @@ namespace Astera {
     concept ValidComponent =
       std::is_same_v<T, Transform> || std::is_same_v<T, SpriteRenderer> || std::is_same_v<T, Camera> ||
       std::is_same_v<T, Behavior> || std::is_same_v<T, Rigidbody2D> || std::is_same_v<T, Collider2D> ||
-      std::is_same_v<T, SoundSource>;
+      std::is_same_v<T, SoundSource> || std::is_same_v<T, Tilemap> || std::is_same_v<T, WorldTransform>;
 
     /// @brief Holds the current state of the scene such as entities, components, and scene-specific components like
     /// cameras and audio
@@ -69,27 +76,109 @@ namespace Astera {
         /// @brief Resets the scene to its initial state
         void Reset();
 
-        /// @brief Creates a new entity in the scene tree. All entities are required to have a Transform component
-        /// and this method automatically adds it when creating the new entity.
+        /// @brief Creates a new entity in the scene tree. All entities are required to have a Transform and
+        /// WorldTransform component and this method automatically adds them when creating the new entity.
         Entity CreateEntity(const string& name);
 
-        /// @brief Destroys the provided entity from the scene registry
+        /// @brief Creates many entities at once, reserving storage for all of them up front
+        /// @param names Name of each new entity
+        /// @param outEntities Receives the new entities, must be the same size as names
+        void CreateEntities(std::span<const NameID> names, std::span<Entity> outEntities);
+
+        /// @brief Spawns copies of a prefab. Storage for every component is reserved up front and each prototype is
+        /// copied to all instances in one pass.
+        /// @param prefab Prefab to copy
+        /// @param count Number of instances
+        /// @param transforms Transform of each instance, or empty to give every instance the prefab's
+        /// @param outEntities Receives the new entities, either empty or count long
+        void Instantiate(const Prefab& prefab,
+                         size_t count,
+                         std::span<const Transform> transforms = {},
+                         std::span<Entity> outEntities         = {});
+
+        /// @brief Registers a prefab under its name, replacing any prefab already registered with that name
+        void AddPrefab(Prefab prefab);
+
+        /// @brief Finds a registered prefab
+        /// @returns The prefab, or nullptr if none is registered with that name. Stays valid until Reset.
+        ASTERA_KEEP const Prefab* FindPrefab(NameID name) const;
+
+        /// @brief Destroys the provided entity, and all of its descendants, from the scene registry
         void DestroyEntity(Entity entity);
 
+        /// @brief Destroys many entities and their descendants at once. Invalid and repeated entities are skipped.
+        void DestroyEntities(std::span<const Entity> entities);
+
         /// @brief Get number of entities currently in scene
         /// @returns Number of entities
         ASTERA_KEEP size_t GetEntityCount() const;
 
+        /// @brief Checks whether an entity id still refers to a live entity
+        ASTERA_KEEP bool IsValid(Entity entity) const {
+            return mRegistry.valid(entity);
+        }
+
+        /// @brief Activates or deactivates an entity. Inactive entities keep their components but are left out of
+        /// every View, so behaviors, systems, physics and rendering skip them.
+        void SetActive(Entity entity, bool active);
+
+        /// @brief Checks whether an entity is active, see SetActive
+        ASTERA_KEEP bool IsActive(Entity entity) const {
+            return !mRegistry.all_of<Inactive>(entity);
+        }
+
         /// @brief Gets the transform component of the specified entity. All entities are created with a Transform
         /// component attached by default.
         /// @param entity Entity id
         /// @returns Transform component reference
         ASTERA_KEEP Transform& GetTransform(Entity entity);
 
+        /// @brief Parents an entity to another, its Transform is kept as is and becomes relative to the parent
+        /// @param child Entity to re-parent
+        /// @param parent New parent, or entt::null to make the child a root again
+        /// @returns False if the parent is the child itself or one of its descendants
+        bool SetParent(Entity child, Entity parent);
+
+        /// @brief Gets the parent of an entity
+        /// @returns Parent entity, or entt::null for root entities
+        ASTERA_KEEP Entity GetParent(Entity entity) const;
+
+        /// @brief Gets the cached world transform of an entity as of the last UpdateWorldTransforms
+        ASTERA_KEEP const WorldTransform& GetWorldTransform(Entity entity) const {
+            return mRegistry.get<WorldTransform>(entity);
+        }
+
+        /// @brief Rebuilds the WorldTransform of every entity whose Transform, or an ancestor's, changed since the last
+        /// call. Roots are updated first and then one depth at a time, each pass in parallel on the job system.
+        ///
+        /// Keeps the Transform and WorldTransform storages sorted by depth, re-sorting after the hierarchy changes.
+        void UpdateWorldTransforms();
+
         /// @brief Returns the name of the given entity if it exists
         /// @param entity Entity id
         /// @return Name of entity
-        ASTERA_KEEP const string& GetEntityName(Entity entity) const;
+        ASTERA_KEEP const string& GetEntityName(Entity entity) const {
+            return GetEntityNameID(entity).ToString();
+        }
+
+        /// @brief Returns the interned name of the given entity
+        /// @param entity Entity id
+        /// @return Name id of entity
+        ASTERA_KEEP NameID GetEntityNameID(Entity entity) const {
+            ASTERA_ASSERT(mRegistry.valid(entity));
+            return mEntityNames[entt::to_entity(entity)].name;
+        }
+
+        /// @brief Finds an entity by name without allocating
+        /// @param name Entity name
+        /// @returns An entity with that name, or entt::null if there is none. Which one is unspecified when several
+        /// entities share the name.
+        ASTERA_KEEP Entity FindEntityByName(std::string_view name) const;
+
+        /// @brief Finds every entity with the given name
+        /// @param name Entity name
+        /// @param outEntities Receives the matches, it is cleared first
+        void FindEntitiesByName(std::string_view name, vector<Entity>& outEntities) const;
 
         /// @brief Attaches specified component to specified entity
         /// @tparam Component Component type
@@ -104,6 +193,47 @@ namespace Astera {
             return mRegistry.get<Component>(entity);
         }
 
+        /// @brief Attaches a component to each entity, none of which may have it already
+        /// @tparam Component Component type
+        /// @param entities Entities to attach to
+        /// @param components Component for each entity
+        template<typename Component>
+            requires ValidComponent<Component>
+        void InsertComponents(std::span<const Entity> entities, std::span<const Component> components) {
+            ASTERA_ASSERT(entities.size() == components.size());
+            auto& storage = mRegistry.storage<Component>();
+            storage.reserve(storage.size() + entities.size());
+            mRegistry.insert<Component>(entities.begin(), entities.end(), components.begin());
+        }
+
+        /// @brief Detaches a component from an entity if it is attached. Transform and WorldTransform can't be removed.
+        /// @tparam Component Component type
+        /// @param entity Entity id
+        template<typename Component>
+            requires ValidComponent<Component> && (!std::is_same_v<Component, Transform>) &&
+                     (!std::is_same_v<Component, WorldTransform>)
+        void RemoveComponent(Entity entity) {
+            if constexpr (std::is_same_v<Component, Behavior>) {
+                if (const auto* behavior = mRegistry.try_get<Behavior>(entity)) { RetireBehavior(*behavior); }
+            }
+            mRegistry.remove<Component>(entity);
+        }
+
+        /// @brief Detaches a component from every entity in a range that has it
+        /// @tparam Component Component type
+        /// @param entities Entities to detach from
+        template<typename Component>
+            requires ValidComponent<Component> && (!std::is_same_v<Component, Transform>) &&
+                     (!std::is_same_v<Component, WorldTransform>)
+        void RemoveComponents(std::span<const Entity> entities) {
+            if constexpr (std::is_same_v<Component, Behavior>) {
+                for (const auto entity : entities) {
+                    if (const auto* behavior = mRegistry.try_get<Behavior>(entity)) { RetireBehavior(*behavior); }
+                }
+            }
+            mRegistry.remove<Component>(entities.begin(), entities.end());
+        }
+
         /// @brief Fetches the given component if it exists on the provided entity
         /// @tparam Component Component type
         /// @param entity Entity id
@@ -114,17 +244,60 @@ namespace Astera {
             return mRegistry.get<Component>(entity);
         }
 
-        /// @brief Returns a view of all entities with the provided components. `.each()` can be used to get an
+        /// @brief Checks whether the provided entity has the given component
+        /// @tparam Component Component type
+        /// @param entity Entity id
+        /// @returns True if the component is attached
+        template<typename Component>
+            requires ValidComponent<Component>
+        ASTERA_KEEP bool HasComponent(Entity entity) const {
+            return mRegistry.all_of<Component>(entity);
+        }
+
+        /// @brief Fetches the given component if it exists on the provided entity
+        /// @tparam Component Component type
+        /// @param entity Entity id
+        /// @returns Component pointer, or nullptr if the component is not attached
+        template<typename Component>
+            requires ValidComponent<Component>
+        Component* TryGetComponent(Entity entity) {
+            return mRegistry.try_get<Component>(entity);
+        }
+
+        /// @brief Drops an entity's script instance table so a fresh one is made from the prototype, for entities that
+        /// are reused rather than respawned
+        void ResetScriptInstance(Entity entity);
+
+        /// @brief Behaviors that were destroyed or removed while holding a script instance table. The tables stay
+        /// alive until the scene hands them back with ScriptEngine::ReleaseInstances.
+        ASTERA_KEEP std::span<const Behavior> GetRetiredBehaviors() const {
+            return mRetiredBehaviors;
+        }
+
+        void ClearRetiredBehaviors() {
+            mRetiredBehaviors.clear();
+        }
+
+        /// @brief Returns a view of all active entities with the provided components. `.each()` can be used to get an
         /// iterator.
         /// @tparam Components Component types to get
         /// @returns EnTT view
         template<typename... Components>
             requires(ValidComponent<Components> && ...)
         auto View() {
+            return mRegistry.view<Components...>(entt::exclude<Inactive>);
+        }
+
+        /// @brief Returns a view of all entities with the provided components, inactive ones included
+        /// @tparam Components Component types to get
+        /// @returns EnTT view
+        template<typename... Components>
+            requires(ValidComponent<Components> && ...)
+        auto ViewAll() {
             return mRegistry.view<Components...>();
         }
 
-        /// @brief Returns an array of all the entities that contain the provided component
+        /// @brief Returns an array of all the active entities that contain the provided component
         /// @tparam Component Component type
         /// @returns Vector of entity IDs
         template<typename Component>
@@ -132,7 +305,7 @@ namespace Astera {
         vector<Entity> GetAllEntitiesWithComponent() {
             vector<Entity> entities;
 
-            const auto iter = mRegistry.view<Component>().each();
+            const auto iter = View<Component>().each();
             for (const auto [entity, component] : iter) {
                 entities.push_back(entity);
             }
@@ -142,6 +315,28 @@ namespace Astera {
 
     private:
         entt::registry mRegistry {};
-        unordered_map<Entity, string> mEntityNames {};
+        struct EntityName {
+            NameID name;
+            u32 index {0};  ///< Position in the entity's mEntitiesByName list
+        };
+
+        /// @brief Indexed by entity slot
+        vector<EntityName> mEntityNames {};
+        unordered_map<NameID, vector<Entity>> mEntitiesByName {};
+        unordered_map<NameID, Prefab> mPrefabs {};
+
+        /// @brief Range of each child depth in the packed Transform and WorldTransform arrays, shallowest first. The
+        /// arrays hold the deepest children first and roots last, see RebuildHierarchyOrder.
+        vector<std::pair<size_t, size_t>> mHierarchyLevels {};
+        bool mHierarchyDirty {false};
+        vector<Behavior> mRetiredBehaviors {};
+
+        void RebuildHierarchyOrder();
+        void AddEntityName(Entity entity, NameID name);
+        void RemoveEntityName(Entity entity);
+
+        void RetireBehavior(const Behavior& behavior) {
+            if (behavior.instance >= 0) { mRetiredBehaviors.push_back(behavior); }
+        }
     };
 }  // namespace Astera
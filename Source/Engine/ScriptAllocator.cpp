@@ -0,0 +1,155 @@
+/*
+ *  Filename: ScriptAllocator.cpp
+ *  This code is part of the Astera core library
+ *  Copyright 2025 Jake Rieger
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ScriptAllocator.hpp"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace Astera {
+    ScriptAllocator::~ScriptAllocator() {
+        for (void* chunk : mChunks) {
+            std::free(chunk);
+        }
+    }
+
+    void* ScriptAllocator::Allocate(void* userData, void* ptr, size_t oldSize, size_t newSize) {
+        auto* allocator = CAST<ScriptAllocator*>(userData);
+        if (newSize == 0) {
+            if (ptr) { allocator->ReleaseBlock(ptr, oldSize); }
+            return nullptr;
+        }
+
+        if (!ptr) return allocator->AllocateBlock(newSize);
+
+        // Blocks that stay in their size class, or outside the pools altogether, are resized in place
+        const bool oldPooled = oldSize <= kMaxPooledSize;
+        const bool newPooled = newSize <= kMaxPooledSize;
+        if (oldPooled && newPooled && GetClass(oldSize) == GetClass(newSize)) {
+            allocator->mStats.liveBytes = allocator->mStats.liveBytes - oldSize + newSize;
+            return ptr;
+        }
+
+        if (!oldPooled && !newPooled) {
+            void* resized = std::realloc(ptr, newSize);
+            if (!resized) return nullptr;  // Lua keeps the old block
+            if (newSize > oldSize) { allocator->mStats.allocatedBytes += newSize - oldSize; }
+            allocator->mStats.liveBytes = allocator->mStats.liveBytes - oldSize + newSize;
+            allocator->mStats.peakBytes = std::max(allocator->mStats.peakBytes, allocator->mStats.liveBytes);
+            return resized;
+        }
+
+        void* moved = allocator->AllocateBlock(newSize);
+        if (!moved) return nullptr;
+        std::memcpy(moved, ptr, std::min(oldSize, newSize));
+        allocator->ReleaseBlock(ptr, oldSize);
+        return moved;
+    }
+
+    void ScriptAllocator::SetCurrentScript(u64 script) {
+        if (script == 0) {
+            mCurrentScript = UINT32_MAX;
+            return;
+        }
+
+        for (u32 i = 0; i < mScriptStats.size(); ++i) {
+            if (mScriptStats[i].script == script) {
+                mCurrentScript = i;
+                return;
+            }
+        }
+
+        mCurrentScript = CAST<u32>(mScriptStats.size());
+        mScriptStats.push_back({script, 0, 0});
+    }
+
+    void ScriptAllocator::NextFrame() {
+        for (auto& script : mScriptStats) {
+            script.frameAllocatedBytes = 0;
+        }
+    }
+
+    void* ScriptAllocator::AllocateBlock(size_t size) {
+        void* block = nullptr;
+        if (size <= kMaxPooledSize) {
+            const size_t sizeClass = GetClass(size);
+            if (!mFreeLists[sizeClass]) { RefillClass(sizeClass); }
+
+            FreeBlock* head = mFreeLists[sizeClass];
+            if (!head) return nullptr;
+            mFreeLists[sizeClass] = head->next;
+            block                 = head;
+        } else {
+            block = std::malloc(size);
+            if (!block) return nullptr;
+            ++mStats.poolMisses;
+        }
+
+        ++mStats.allocations;
+        mStats.allocatedBytes += size;
+        mStats.liveBytes += size;
+        mStats.peakBytes = std::max(mStats.peakBytes, mStats.liveBytes);
+        if (mCurrentScript != UINT32_MAX) {
+            mScriptStats[mCurrentScript].allocatedBytes += size;
+            mScriptStats[mCurrentScript].frameAllocatedBytes += size;
+        }
+        return block;
+    }
+
+    void ScriptAllocator::ReleaseBlock(void* ptr, size_t size) {
+        mStats.liveBytes -= size;
+        if (size > kMaxPooledSize) {
+            std::free(ptr);
+            return;
+        }
+
+        auto* block            = CAST<FreeBlock*>(ptr);
+        const size_t sizeClass = GetClass(size);
+        block->next            = mFreeLists[sizeClass];
+        mFreeLists[sizeClass]  = block;
+    }
+
+    void ScriptAllocator::RefillClass(size_t sizeClass) {
+        void* chunk = std::malloc(kChunkSize);
+        if (!chunk) return;
+        mChunks.push_back(chunk);
+        mStats.pooledBytes += kChunkSize;
+
+        // Thread the chunk onto the free list back to front so blocks are handed out in address order
+        const size_t blockSize = (sizeClass + 1) * kGranularity;
+        const size_t count     = kChunkSize / blockSize;
+        auto* bytes            = CAST<u8*>(chunk);
+        FreeBlock* head        = mFreeLists[sizeClass];
+        for (size_t i = count; i-- > 0;) {
+            auto* block = RCAST<FreeBlock*>(bytes + i * blockSize);
+            block->next = head;
+            head        = block;
+        }
+        mFreeLists[sizeClass] = head;
+    }
+}  // namespace Astera
@@ -0,0 +1,125 @@
+/*
+ *  Filename: ScriptAllocator.hpp
+ *  This code is part of the Astera core library
+ *  Copyright 2025 Jake Rieger
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include "EngineCommon.hpp"
+
+#include <span>
+
+namespace Astera {
+    /// @brief lua_Alloc backed by size-class pools
+    ///
+    /// Almost everything Lua allocates is a small table, string, closure or userdata. Requests up to kMaxPooledSize are
+    /// rounded up to a size class and served from a free list that is refilled a chunk at a time, so they never reach
+    /// the system allocator once the pools are warm. Larger requests go to malloc. Pooled memory is only returned to
+    /// the system when the allocator is destroyed.
+    ///
+    /// Allocations are also counted against the script that is running when they happen, see SetCurrentScript. Lua
+    /// doesn't say who owns a block when freeing it, so per-script numbers count bytes allocated, not bytes alive.
+    class ScriptAllocator {
+    public:
+        struct Stats {
+            u64 liveBytes {0};      ///< Bytes Lua currently holds
+            u64 peakBytes {0};      ///< Highest liveBytes so far
+            u64 pooledBytes {0};    ///< Bytes reserved by the pools, in use or not
+            u64 allocations {0};    ///< Allocations served since creation
+            u64 allocatedBytes {0}; ///< Bytes allocated since creation, freed or not
+            u64 poolMisses {0};     ///< Allocations that went to malloc, too large for a pool
+        };
+
+        struct ScriptStats {
+            u64 script {0};
+            u64 allocatedBytes {0};       ///< Since creation
+            u64 frameAllocatedBytes {0};  ///< Since the last NextFrame
+        };
+
+        /// @brief Counts allocations against a script for as long as it is alive
+        class ScriptScope {
+        public:
+            ScriptScope(ScriptAllocator& allocator, u64 script) : mAllocator(allocator) {
+                mAllocator.SetCurrentScript(script);
+            }
+
+            ~ScriptScope() {
+                mAllocator.SetCurrentScript(0);
+            }
+
+            ASTERA_CLASS_PREVENT_MOVES_COPIES(ScriptScope)
+
+        private:
+            ScriptAllocator& mAllocator;
+        };
+
+        ScriptAllocator() = default;
+        ~ScriptAllocator();
+
+        ASTERA_CLASS_PREVENT_MOVES_COPIES(ScriptAllocator)
+
+        /// @brief lua_Alloc entry point, `userData` is the ScriptAllocator
+        static void* Allocate(void* userData, void* ptr, size_t oldSize, size_t newSize);
+
+        /// @brief Counts following allocations against a script, or against nothing for 0
+        void SetCurrentScript(u64 script);
+
+        /// @brief Starts a new frame for ScriptStats::frameAllocatedBytes
+        void NextFrame();
+
+        ASTERA_KEEP const Stats& GetStats() const {
+            return mStats;
+        }
+
+        ASTERA_KEEP std::span<const ScriptStats> GetScriptStats() const {
+            return mScriptStats;
+        }
+
+    private:
+        static constexpr size_t kGranularity  = 16;
+        static constexpr size_t kMaxPooledSize = 512;
+        static constexpr size_t kClassCount    = kMaxPooledSize / kGranularity;
+        static constexpr size_t kChunkSize     = 64_KB;
+
+        struct FreeBlock {
+            FreeBlock* next;
+        };
+
+        std::array<FreeBlock*, kClassCount> mFreeLists {};
+        vector<void*> mChunks;
+        Stats mStats;
+        vector<ScriptStats> mScriptStats;
+        u32 mCurrentScript {UINT32_MAX};  ///< Index into mScriptStats
+
+        static size_t GetClass(size_t size) {
+            return (size - 1) / kGranularity;
+        }
+
+        void* AllocateBlock(size_t size);
+        void ReleaseBlock(void* ptr, size_t size);
+        void RefillClass(size_t sizeClass);
+    };
+}  // namespace Astera
@@ -0,0 +1,142 @@
+/*
+ *  Filename: ScriptCache.cpp
+ *  This code is part of the Astera core library
+ *  Copyright 2025 Jake Rieger
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ScriptCache.hpp"
+#include "IO.hpp"
+#include "Log.hpp"
+#include "ScriptCompiler.hpp"
+
+extern "C" {
+#include <luajit.h>
+}
+
+namespace Astera {
+    /// @brief 64-bit FNV-1a, chained through `hash` so several buffers can be hashed as one
+    static u64 HashBytes(const void* data, size_t size, u64 hash = 14695981039346656037ull) {
+        const auto* bytes = CAST<const u8*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+        return hash;
+    }
+
+    ScriptCache::ScriptCache(Path directory) : mDirectory(std::move(directory)) {}
+
+    Result<vector<u8>> ScriptCache::GetBytecode(const string& source, const string& chunkName) {
+        const u64 key = MakeKey(source, chunkName);
+        if (auto cached = Read(key)) {
+            ++mHits;
+            return std::move(*cached);
+        }
+
+        ++mMisses;
+        auto bytecode = ScriptCompiler::Compile(source, chunkName);
+        if (bytecode.has_value()) { Write(key, *bytecode); }
+        return bytecode;
+    }
+
+    void ScriptCache::Invalidate(const string& source, const string& chunkName) const {
+        std::error_code error;
+        fs::remove(GetEntryPath(MakeKey(source, chunkName)), error);
+    }
+
+    void ScriptCache::Clear() const {
+        std::error_code error;
+        if (!fs::exists(mDirectory, error)) return;
+
+        for (const auto& entry : fs::directory_iterator(mDirectory, error)) {
+            if (entry.path().extension() == ".ljbc") { fs::remove(entry.path(), error); }
+        }
+    }
+
+    u64 ScriptCache::MakeKey(const string& source, const string& chunkName) {
+        // Bytecode is only valid for the LuaJIT build and pointer size that produced it
+        static constexpr std::string_view kBuild = LUAJIT_VERSION;
+        static constexpr u32 kPointerSize        = sizeof(void*);
+
+        u64 key = HashBytes(source.data(), source.size());
+        key     = HashBytes(chunkName.data(), chunkName.size() + 1, key);
+        key     = HashBytes(kBuild.data(), kBuild.size(), key);
+        return HashBytes(&kPointerSize, sizeof(kPointerSize), key);
+    }
+
+    Path ScriptCache::GetEntryPath(u64 key) const {
+        return mDirectory / fmt::format("{:016x}.ljbc", key);
+    }
+
+    optional<vector<u8>> ScriptCache::Read(u64 key) const {
+        const Path path = GetEntryPath(key);
+        std::error_code error;
+        if (!fs::exists(path, error)) return std::nullopt;
+
+        auto bytes = IO::ReadBytes(path);
+        if (!bytes.has_value() || bytes->size() < sizeof(EntryHeader)) return std::nullopt;
+
+        EntryHeader header;
+        EntryHeader expected;
+        std::memcpy(&header, bytes->data(), sizeof(EntryHeader));
+
+        const u8* bytecode = bytes->data() + sizeof(EntryHeader);
+        const bool valid   = std::memcmp(header.magic, expected.magic, sizeof(header.magic)) == 0 &&
+                           header.format == expected.format && header.key == key &&
+                           header.size == bytes->size() - sizeof(EntryHeader) &&
+                           header.checksum == HashBytes(bytecode, header.size);
+        if (!valid) {
+            Log::Warn("ScriptCache", "Discarding damaged entry `{}`", path.string());
+            fs::remove(path, error);
+            return std::nullopt;
+        }
+
+        return vector<u8>(bytecode, bytecode + header.size);
+    }
+
+    void ScriptCache::Write(u64 key, const vector<u8>& bytecode) const {
+        std::error_code error;
+        fs::create_directories(mDirectory, error);
+
+        EntryHeader header;
+        header.key      = key;
+        header.size     = bytecode.size();
+        header.checksum = HashBytes(bytecode.data(), bytecode.size());
+
+        vector<u8> bytes(sizeof(EntryHeader) + bytecode.size());
+        std::memcpy(bytes.data(), &header, sizeof(EntryHeader));
+        std::memcpy(bytes.data() + sizeof(EntryHeader), bytecode.data(), bytecode.size());
+
+        // Write to a temporary file and rename it over the entry, so a crash never leaves half an entry behind
+        const Path path      = GetEntryPath(key);
+        const Path temporary = Path(path).replace_extension(".tmp");
+        if (!IO::WriteBytes(temporary, bytes)) {
+            Log::Warn("ScriptCache", "Failed to write `{}`", temporary.string());
+            return;
+        }
+
+        fs::rename(temporary, path, error);
+        if (error) { Log::Warn("ScriptCache", "Failed to store `{}`: {}", path.string(), error.message()); }
+    }
+}  // namespace Astera
@@ -0,0 +1,89 @@
+/*
+ *  Filename: ScriptCache.hpp
+ *  This code is part of the Astera core library
+ *  Copyright 2025 Jake Rieger
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include "EngineCommon.hpp"
+
+namespace Astera {
+    /// @brief On-disk cache of compiled Lua bytecode
+    ///
+    /// Entries are keyed by a hash of the script source, its chunk name and the Lua build, so editing a script or
+    /// upgrading LuaJIT misses the cache instead of loading stale bytecode. Entries that no longer match anything are
+    /// left on disk until Clear.
+    class ScriptCache {
+    public:
+        /// @param directory Folder to keep entries in, created on first store
+        explicit ScriptCache(Path directory);
+
+        ASTERA_CLASS_PREVENT_MOVES_COPIES(ScriptCache)
+
+        /// @brief Gets the bytecode for a script, compiling and storing it on a miss
+        /// @param source Lua source code
+        /// @param chunkName Chunk name compiled into the bytecode's debug info
+        /// @returns Bytecode, or the compile error
+        Result<vector<u8>> GetBytecode(const string& source, const string& chunkName);
+
+        /// @brief Removes the entry for a script, e.g. after its bytecode failed to load
+        void Invalidate(const string& source, const string& chunkName) const;
+
+        /// @brief Removes every entry
+        void Clear() const;
+
+        ASTERA_KEEP const Path& GetDirectory() const {
+            return mDirectory;
+        }
+
+        ASTERA_KEEP u32 GetHits() const {
+            return mHits;
+        }
+
+        ASTERA_KEEP u32 GetMisses() const {
+            return mMisses;
+        }
+
+    private:
+        /// @brief Written before the bytecode of every entry
+        struct EntryHeader {
+            u8 magic[4] {'A', 'L', 'B', 'C'};
+            u32 format {1};
+            u64 key {0};
+            u64 size {0};      ///< Bytecode size
+            u64 checksum {0};  ///< Hash of the bytecode, catches truncated or damaged entries
+        };
+
+        Path mDirectory;
+        u32 mHits {0};
+        u32 mMisses {0};
+
+        static u64 MakeKey(const string& source, const string& chunkName);
+        ASTERA_KEEP Path GetEntryPath(u64 key) const;
+        optional<vector<u8>> Read(u64 key) const;
+        void Write(u64 key, const vector<u8>& bytecode) const;
+    };
+}  // namespace Astera
@@ -49,8 +49,9 @@ namespace Astera {
 
         const i32 loadResult = luaL_loadbuffer(L, source.c_str(), source.size(), chunkName.c_str());
         if (loadResult != 0) {
+            string error = fmt::format("Failed to compile Lua script: {}", lua_tostring(L, -1));
             lua_close(L);
-            return unexpected(fmt::format("Failed to compile Lua script: {}", lua_tostring(L, -1)));
+            return unexpected(std::move(error));
         }
 
         BytecodeWriterState writerState;
@@ -65,7 +66,7 @@ namespace Astera {
 #endif
 
         if (dumpResult != 0) {
-            bytecode.clear();
+            lua_close(L);
             return unexpected("Failed to dump Lua bytecode: " + StringConvert::ToString(dumpResult));
         }
 
@@ -27,9 +27,12 @@
  */
 
 #include "ScriptEngine.hpp"
+#include "JobSystem.hpp"
 #include "Log.hpp"
 #include "ScriptTypeRegistry.hpp"
 
+#include <chrono>
+
 namespace Astera {
     static void PrintUninitializedError() {
         Log::Error("ScriptEngine", "Attempted to load script before script engine has been initialized!");
@@ -39,95 +42,642 @@ namespace Astera {
         Log::Error("ScriptEngine", "Script with id `{}` not found", id);
     }
 
+    static BehaviorScriptContext MakeBehaviorContext(sol::environment env) {
+        BehaviorScriptContext ctx;
+        ctx.OnUpdateBatch      = env["OnUpdateBatch"];
+        ctx.OnFixedUpdateBatch = env["OnFixedUpdateBatch"];
+        ctx.OnLateUpdateBatch  = env["OnLateUpdateBatch"];
+        ctx.OnCollisionEnter   = env["OnCollisionEnter"];
+        ctx.OnCollisionExit    = env["OnCollisionExit"];
+
+        // Per-entity callbacks are methods of Instance when the script declares it, global functions otherwise
+        const sol::optional<sol::table> prototype = env.raw_get<sol::optional<sol::table>>("Instance");
+        const sol::table callbacks                = prototype ? *prototype : sol::table(env);
+        ctx.OnAwake       = callbacks["OnAwake"];
+        ctx.OnUpdate      = callbacks["OnUpdate"];
+        ctx.OnFixedUpdate = callbacks["OnFixedUpdate"];
+        ctx.OnLateUpdate  = callbacks["OnLateUpdate"];
+        ctx.OnDestroyed   = callbacks["OnDestroyed"];
+        ctx.Routine       = callbacks["Routine"];
+
+        if (prototype) {
+            ctx.prototype = *prototype;
+            for ([[maybe_unused]] const auto& field : *prototype) {
+                ++ctx.prototypeFields;
+            }
+        }
+
+        ctx.env = std::move(env);
+        return ctx;
+    }
+
+    static void StoreBehaviorContext(unordered_map<u64, BehaviorScriptContext>& contexts,
+                                     u64 id,
+                                     BehaviorScriptContext ctx) {
+        // Pooled instance tables are empty, a reloaded script refills them from its new prototype
+        if (const auto it = contexts.find(id); it != contexts.end()) {
+            ctx.freeInstances = std::move(it->second.freeInstances);
+            ctx.isolated      = it->second.isolated;
+        }
+        contexts[id] = std::move(ctx);
+    }
+
+    static void ClearInstance(lua_State* L, i32 ref) {
+        // Emptied rather than dropped, the table keeps its hash part for the next entity
+        lua_rawgeti(L, LUA_REGISTRYINDEX, ref);
+        lua_pushnil(L);
+        while (lua_next(L, -2) != 0) {
+            lua_pop(L, 1);
+            lua_pushvalue(L, -1);
+            lua_pushnil(L);
+            lua_rawset(L, -4);
+        }
+        lua_pop(L, 1);
+    }
+
+    /// @brief Number of Lua calls a dispatch makes, one per batch or one per entity depending on which callback the
+    /// script defines, 0 if it defines neither
+    static u64 CountCalls(const sol::protected_function& perEntity,
+                          const sol::protected_function& batched,
+                          const BehaviorBatch& batch) {
+        if (batched.valid()) return 1;
+        return perEntity.valid() ? batch.Size() : 0;
+    }
+
+    static_assert(Behavior::kNoInstance == LUA_NOREF && Behavior::kStateless == LUA_REFNIL);
+
+    /// @brief First value the wait functions yield, tells their waits apart from a plain coroutine.yield
+    static constexpr u8 kRoutineWaitTag = 0;
+
+    static i32 YieldWait(lua_State* L, const i32 wait) {
+        lua_settop(L, 1);
+        lua_pushlightuserdata(L, CCAST<u8*>(&kRoutineWaitTag));
+        lua_insert(L, 1);
+        lua_pushinteger(L, wait);
+        lua_insert(L, 2);
+        return lua_yield(L, 3);
+    }
+
+    static i32 WaitFrames(lua_State* L) {
+        luaL_optinteger(L, 1, 1);
+        return YieldWait(L, 1);
+    }
+
+    static i32 WaitSeconds(lua_State* L) {
+        luaL_checknumber(L, 1);
+        return YieldWait(L, 2);
+    }
+
+    static i32 WaitEvent(lua_State* L) {
+        luaL_checkstring(L, 1);
+        return YieldWait(L, 3);
+    }
+
+    ScriptEngine::ScriptEngine() : mLua(CreateState(mAllocator, mUsesAllocator)) {}
+
+    sol::state ScriptEngine::CreateState(ScriptAllocator& allocator, bool& usesAllocator) {
+        // LuaJIT without GC64 returns null instead of a state, try once before handing the allocator to sol
+        if (lua_State* probe = lua_newstate(ScriptAllocator::Allocate, &allocator)) {
+            lua_close(probe);
+            usesAllocator = true;
+            return sol::state(sol::default_at_panic, ScriptAllocator::Allocate, &allocator);
+        }
+
+        usesAllocator = false;
+        return sol::state();
+    }
+
+    void ScriptEngine::OpenLibraries(sol::state& lua) {
+        // Opening jit is what turns LuaJIT's compiler on, without it every script runs in the interpreter. ffi is only
+        // opened for ScriptFFI, which hides it from scripts again. Both are no-ops without LuaJIT.
+        lua.open_libraries(sol::lib::base,
+                           sol::lib::math,
+                           sol::lib::table,
+                           sol::lib::string,
+                           sol::lib::debug,
+                           sol::lib::jit,
+                           sol::lib::ffi);
+    }
+
     void ScriptEngine::Initialize() {
         if (mInitialized)
             return;
-        mLua.open_libraries(sol::lib::base, sol::lib::math, sol::lib::table, sol::lib::string, sol::lib::debug);
+        OpenLibraries(mLua);
+
+        if (!mUsesAllocator) {
+            Log::Warn("ScriptEngine", "Lua doesn't accept a custom allocator, script memory stats are unavailable");
+        }
+
+        // Routines sleep by yielding from these, see ResumeRoutines
+        lua_register(mLua.lua_state(), "WaitFrames", WaitFrames);
+        lua_register(mLua.lua_state(), "WaitSeconds", WaitSeconds);
+        lua_register(mLua.lua_state(), "WaitEvent", WaitEvent);
+        mLua["SignalEvent"] = [this](std::string_view event) { SignalEvent(NameID(event)); };
+
+        mProfiler.Attach(mLua.lua_state(), mUsesAllocator ? &mAllocator : nullptr);
+
+        // The collector only runs from StepGC and CollectGarbage from here on
+        lua_gc(mLua.lua_state(), LUA_GCSTOP, 0);
+        mGCStats.thresholdBytes = std::max(GetMemoryBytes() * kGCPause / 100, kGCMinThreshold);
+
         mInitialized = true;
     }
 
-    void ScriptEngine::LoadScript(const string& source, ScriptID scriptId, ScriptType type) {
+    void ScriptEngine::StepGC() {
+        if (!mInitialized) return;
+
+        const auto start    = std::chrono::steady_clock::now();
+        const auto budget   = std::chrono::duration<f32, std::milli>(mGCBudget);
+        lua_State* L        = mLua.lua_state();
+        mGCStats.frameSteps = 0;
+        mAllocator.NextFrame();
+
+        // Bytes allocated since the last call, the work Lua's own collector would have paced itself against
+        u64 memory         = GetMemoryBytes();
+        const u64 produced = mUsesAllocator ? mAllocator.GetStats().allocatedBytes - mGCAllocatedBytes
+                                            : (memory > mGCStats.memoryBytes ? memory - mGCStats.memoryBytes : 0);
+        mGCAllocatedBytes  = mAllocator.GetStats().allocatedBytes;
+
+        if (mGCCycleActive || memory >= mGCStats.thresholdBytes) {
+            if (!mGCCycleActive) { mGCCycleAllocatedBytes = mGCAllocatedBytes; }
+            mGCCycleActive = true;
+
+            // Spare budget runs the cycle ahead, but a frame never does less work than the automatic collector would
+            // have for the same allocation. Scripts that outpace the budget would otherwise grow memory without bound,
+            // and a bigger heap only makes each step slower. Past kGCMaxBudgetScale times the budget the rest is
+            // left for the next frame.
+            const auto limit     = budget * kGCMaxBudgetScale;
+            const u64 requiredKB = produced / 1_KB;
+            u64 paidKB           = 0;
+            bool overdue         = false;
+            for (;;) {
+                ++mGCStats.frameSteps;
+                paidKB += kGCStepSize;
+                if (lua_gc(L, LUA_GCSTEP, kGCStepSize) != 0) {
+                    mGCCycleActive = false;
+                    ++mGCStats.completedCycles;
+
+                    // Everything allocated while the cycle ran survives it, whether it's still reachable or not.
+                    // Leave that out, or the threshold creeps up with every cycle that spans several frames.
+                    u64 live = GetMemoryBytes();
+                    if (mUsesAllocator) {
+                        const u64 floating = mAllocator.GetStats().allocatedBytes - mGCCycleAllocatedBytes;
+                        live               = live > floating ? live - floating : 0;
+                    }
+                    mGCStats.thresholdBytes = std::max(live * kGCPause / 100, kGCMinThreshold);
+                    break;
+                }
+
+                const auto elapsed = std::chrono::steady_clock::now() - start;
+                if (elapsed >= limit) break;
+                if (elapsed >= budget) {
+                    if (paidKB >= requiredKB) break;
+                    overdue = true;
+                }
+            }
+
+            if (overdue) { ++mGCStats.overdueFrames; }
+
+            // Stepping re-arms Lua's own collector
+            lua_gc(L, LUA_GCSTOP, 0);
+            memory = GetMemoryBytes();
+        }
+
+        mGCStats.memoryBytes = memory;
+        mGCStats.frameTime   = std::chrono::duration<f32, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void ScriptEngine::CollectGarbage() {
+        if (!mInitialized) return;
+
+        lua_State* L = mLua.lua_state();
+        lua_gc(L, LUA_GCCOLLECT, 0);
+        lua_gc(L, LUA_GCSTOP, 0);
+        for (const auto& lane : mLanes) {
+            lua_gc(lane->lua.lua_state(), LUA_GCCOLLECT, 0);
+        }
+
+        mGCCycleActive          = false;
+        mGCAllocatedBytes       = mAllocator.GetStats().allocatedBytes;
+        mGCStats.memoryBytes    = GetMemoryBytes();
+        mGCStats.thresholdBytes = std::max(mGCStats.memoryBytes * kGCPause / 100, kGCMinThreshold);
+    }
+
+    u64 ScriptEngine::GetMemoryBytes() {
+        lua_State* L = mLua.lua_state();
+        return CAST<u64>(lua_gc(L, LUA_GCCOUNT, 0)) * 1024 + CAST<u64>(lua_gc(L, LUA_GCCOUNTB, 0));
+    }
+
+    void ScriptEngine::EnableIsolatedScripts(u32 laneCount,
+                                             const std::function<void(sol::state&)>& initializeLane) {
+        ASTERA_ASSERT(mLanes.empty());
+        laneCount = std::clamp(laneCount, 1u, CAST<u32>(ScriptInstance::kMaxLanes));
+
+        // Lanes run on worker threads, so they keep LuaJIT's allocator and collector rather than sharing the pools
+        mLanes.reserve(laneCount);
+        for (u32 i = 0; i < laneCount; ++i) {
+            auto lane = make_unique<ScriptLane>();
+            OpenLibraries(lane->lua);
+            if (initializeLane) { initializeLane(lane->lua); }
+            mLanes.push_back(std::move(lane));
+        }
+        Log::Debug("ScriptEngine", "Running isolated scripts on {} lanes", laneCount);
+    }
+
+    void ScriptEngine::EnableScriptCache(const Path& directory) {
+        mScriptCache = make_unique<ScriptCache>(directory);
+        Log::Debug("ScriptEngine", "Caching script bytecode in `{}`", directory.string());
+    }
+
+    bool ScriptEngine::LoadScript(const string& source, ScriptID scriptId, ScriptType type) {
         if (!mInitialized) {
             PrintUninitializedError();
-            return;
+            return false;
         }
 
-        try {
-            auto env = sol::environment(mLua, sol::create, mLua.globals());
-            mLua.script(source, env);
+        const auto chunkName = fmt::format("script_{}", scriptId);
+        if (mScriptCache) {
+            // Scripts that fail to compile fall through to the source path, which reports the error
+            if (const auto bytecode = mScriptCache->GetBytecode(source, chunkName)) {
+                sol::load_result chunk = LoadBytecode(*bytecode, chunkName);
+                if (chunk.valid()) return RunScript(chunk, scriptId, type);
 
-            if (type == ScriptType::Behavior) {
-                sol::protected_function awakeFunc      = env["OnAwake"];
-                sol::protected_function updateFunc     = env["OnUpdate"];
-                sol::protected_function lateUpdateFunc = env["OnLateUpdate"];
-                sol::protected_function destroyedFunc  = env["OnDestroyed"];
+                const sol::error error = chunk;
+                Log::Warn("ScriptEngine", "Discarding cached bytecode of script `{}`: {}", scriptId, error.what());
+                mScriptCache->Invalidate(source, chunkName);
+            }
+        }
 
-                mBehaviorScriptContexts[scriptId] = {std::move(env),
-                                                     std::move(awakeFunc),
-                                                     std::move(updateFunc),
-                                                     std::move(lateUpdateFunc),
-                                                     std::move(destroyedFunc)};
+        sol::load_result chunk = mLua.load(source, chunkName, sol::load_mode::text);
+        if (!chunk.valid()) {
+            const sol::error error = chunk;
+            Log::Error("ScriptEngine", "Error loading script: {}", error.what());
+            return false;
+        }
 
-                Log::Debug("ScriptEngine", "Loaded script with id `{}`", scriptId);
-            }
-        } catch (const sol::error& e) { Log::Error("ScriptEngine", "Error loading script: {}", e.what()); }
+        return RunScript(chunk, scriptId, type);
     }
 
-    void ScriptEngine::LoadScript(const vector<u8>& bytecode, ScriptID scriptId, const ScriptType type) {
+    bool ScriptEngine::LoadScript(const vector<u8>& bytecode, ScriptID scriptId, const ScriptType type) {
         if (!mInitialized) {
             PrintUninitializedError();
-            return;
+            return false;
+        }
+
+        sol::load_result chunk = LoadBytecode(bytecode, fmt::format("script_{}", scriptId));
+        if (!chunk.valid()) {
+            const sol::error error = chunk;
+            Log::Error("ScriptEngine", "Error loading script bytecode: {}", error.what());
+            return false;
+        }
+
+        return RunScript(chunk, scriptId, type);
+    }
+
+    bool ScriptEngine::ReloadScript(const string& source, const ScriptID scriptId, std::span<const i32> instances) {
+        const auto it = mBehaviorScriptContexts.find(scriptId);
+        if (it == mBehaviorScriptContexts.end()) {
+            PrintScriptNotFoundError(scriptId);
+            return false;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+
+        // Lane 0 stands for the main state of scripts that aren't isolated
+        vector<sol::table> oldPrototypes;
+        if (it->second.isolated) {
+            for (const auto& lane : mLanes) {
+                const auto laneCtx = lane->contexts.find(scriptId);
+                oldPrototypes.push_back(laneCtx != lane->contexts.end() ? laneCtx->second.prototype : sol::table {});
+            }
+        } else {
+            oldPrototypes.push_back(it->second.prototype);
+        }
+
+        if (!LoadScript(source, scriptId)) {
+            Log::Error("ScriptEngine", "Reloading script `{}` failed, keeping the previous version", scriptId);
+            return false;
+        }
+
+        u32 refreshed = 0;
+        for (const i32 instance : instances) {
+            if (instance < 0) continue;
+
+            const auto* ctx = FindContext(scriptId, instance);
+            const u32 lane  = ScriptInstance::GetLane(instance);
+            if (!ctx || !ctx->prototype.valid() || lane >= oldPrototypes.size()) continue;
+
+            const ScriptAllocator::ScriptScope scope(mAllocator, scriptId);
+            RefreshInstance(ctx->env.lua_state(),
+                            ScriptInstance::FromBehavior(instance).ref,
+                            oldPrototypes[lane],
+                            ctx->prototype);
+            ++refreshed;
+        }
+
+        Log::Info("ScriptEngine",
+                  "Reloaded script `{}` with {} entities in {:.2f} ms",
+                  scriptId,
+                  refreshed,
+                  std::chrono::duration<f32, std::milli>(std::chrono::steady_clock::now() - start).count());
+        return true;
+    }
+
+    void ScriptEngine::RefreshInstance(lua_State* L,
+                                       const i32 ref,
+                                       const sol::table& oldPrototype,
+                                       const sol::table& prototype) {
+        lua_rawgeti(L, LUA_REGISTRYINDEX, ref);
+        const i32 instance = lua_gettop(L);
+        if (oldPrototype.valid()) {
+            oldPrototype.push(L);
+        } else {
+            lua_pushnil(L);
         }
+        const i32 old = lua_gettop(L);
+        prototype.push(L);
 
+        lua_pushnil(L);
+        while (lua_next(L, -2) != 0) {
+            // Stack: key, new value
+            lua_pushvalue(L, -2);
+            lua_rawget(L, instance);
+
+            bool replace = lua_isnil(L, -1);
+            if (!replace && !lua_istable(L, -1) && lua_istable(L, old)) {
+                lua_pushvalue(L, -3);
+                lua_rawget(L, old);
+                replace = lua_rawequal(L, -1, -2) != 0;
+                lua_pop(L, 1);
+            }
+            lua_pop(L, 1);
+
+            if (replace) {
+                lua_pushvalue(L, -2);
+                lua_insert(L, -2);
+                lua_rawset(L, instance);
+            } else {
+                lua_pop(L, 1);
+            }
+        }
+        lua_pop(L, 3);
+    }
+
+    sol::load_result ScriptEngine::LoadBytecode(const vector<u8>& bytecode, const string& chunkName) {
+        const std::string_view code(RCAST<const char*>(bytecode.data()), bytecode.size());
+        return mLua.load(code, chunkName, sol::load_mode::binary);
+    }
+
+    bool ScriptEngine::RunScript(sol::load_result& chunk, ScriptID scriptId, ScriptType type) {
+        const ScriptAllocator::ScriptScope scope(mAllocator, scriptId);
+        const ScriptProfiler::Scope timing(mProfiler, scriptId, ScriptCallback::Load);
         try {
-            auto env = sol::environment(mLua, sol::create, mLua.globals());
+            // Each script gets its own globals so callbacks of different behaviors don't overwrite each other
+            auto env                       = sol::environment(mLua, sol::create, mLua.globals());
+            sol::protected_function script = chunk;
+            sol::set_environment(env, script);
 
-            struct ReaderState {
-                const vector<u8>* bytecode {nullptr};
-                size_t position {0};
+            // Handlers are only taken while the script runs, so reloading it replaces them rather than adding to them
+            env["Subscribe"] = [this, scriptId](std::string_view type,
+                                                sol::protected_function handler,
+                                                const sol::object& filter) {
+                if (mSubscribingScript != scriptId) {
+                    Log::Warn("ScriptEngine", "Script `{}` can only subscribe to events while it loads", scriptId);
+                    return;
+                }
+
+                EventSubscription subscription {NameID(type), {}, std::move(handler)};
+                if (filter.is<u32>()) {
+                    subscription.filter = {EventFilter::Kind::Entity, filter.as<u32>()};
+                } else if (filter.is<std::string_view>()) {
+                    subscription.filter = {EventFilter::Kind::Tag, EventBus::kNoEntity, NameID(filter.as<string>())};
+                }
+                mPendingSubscriptions.push_back(std::move(subscription));
             };
 
-            ReaderState state;
-            state.bytecode = &bytecode;
+            mPendingSubscriptions.clear();
+            mSubscribingScript = scriptId;
+            const auto result  = script();
+            mSubscribingScript = 0;
+            if (!result.valid()) {
+                const sol::error error = result;
+                Log::Error("ScriptEngine", "Error running script `{}`: {}", scriptId, error.what());
+                return false;
+            }
 
-            auto reader = [](lua_State* L, void* data, size_t* size) -> const char* {
-                const auto readerState = CAST<ReaderState*>(data);
-                if (readerState->position >= readerState->bytecode->size()) {
-                    *size = 0;
-                    return nullptr;
+            if (type == ScriptType::Behavior) {
+                if (env.raw_get<sol::optional<sol::table>>("Instance")) {
+                    for (const char* name :
+                         {"OnAwake", "OnUpdate", "OnFixedUpdate", "OnLateUpdate", "OnDestroyed", "Routine"}) {
+                        if (env.raw_get<sol::object>(name).is<sol::function>()) {
+                            Log::Warn("ScriptEngine",
+                                      "Script `{}` declares Instance, its global {} is ignored",
+                                      scriptId,
+                                      name);
+                        }
+                    }
                 }
 
-                *size                 = readerState->bytecode->size() - readerState->position;
-                const auto result     = RCAST<const char*>(readerState->bytecode->data() + readerState->position);
-                readerState->position = readerState->bytecode->size();
-                return result;
-            };
+                bool isolated = env.raw_get<sol::optional<bool>>("Isolated").value_or(false);
+                if (isolated && mLanes.empty()) {
+                    Log::Warn("ScriptEngine", "Script `{}` is isolated but there are no lanes to run it on", scriptId);
+                    isolated = false;
+                }
 
-            const auto chunkName         = fmt::format("chunk_{}", scriptId);
-            sol::load_result loadedChunk = mLua.load(reader, &state, chunkName.c_str(), sol::load_mode::binary);
-            if (!loadedChunk.valid()) {
-                sol::error err = loadedChunk;
-                return;
+                const auto previous = mBehaviorScriptContexts.find(scriptId);
+                const bool subscribed =
+                  previous != mBehaviorScriptContexts.end() && !previous->second.subscriptions.empty();
+
+                // Entities keep the lane their instance table lives in, so a script can't leave the lanes on reload
+                const bool wasIsolated = previous != mBehaviorScriptContexts.end() && previous->second.isolated;
+                if (wasIsolated && !isolated) {
+                    Log::Warn("ScriptEngine", "Script `{}` stays isolated until the engine restarts", scriptId);
+                }
+
+                // Every lane loads the new version before any state switches to it, so a lane that fails leaves the
+                // previous version running everywhere
+                vector<BehaviorScriptContext> laneContexts;
+                if ((wasIsolated || isolated) && !LoadIntoLanes(script, scriptId, laneContexts)) {
+                    mPendingSubscriptions.clear();
+                    return false;
+                }
+
+                StoreBehaviorContext(mBehaviorScriptContexts, scriptId, MakeBehaviorContext(std::move(env)));
+                for (size_t i = 0; i < laneContexts.size(); ++i) {
+                    StoreBehaviorContext(mLanes[i]->contexts, scriptId, std::move(laneContexts[i]));
+                }
+
+                auto& ctx    = mBehaviorScriptContexts[scriptId];
+                ctx.isolated = ctx.isolated || isolated;
+                if (ctx.isolated && ctx.Routine.valid()) {
+                    Log::Warn("ScriptEngine", "Script `{}` is isolated, its Routine is ignored", scriptId);
+                    ctx.Routine = sol::lua_nil;
+                }
+                // Handlers run on the main state, isolated scripts keep their entities' state in the lanes
+                if (ctx.isolated && !mPendingSubscriptions.empty()) {
+                    Log::Warn("ScriptEngine", "Script `{}` is isolated, its event subscriptions are ignored", scriptId);
+                    mPendingSubscriptions.clear();
+                }
+                if (subscribed || !mPendingSubscriptions.empty()) {
+                    ctx.subscriptions = std::move(mPendingSubscriptions);
+                    mPendingSubscriptions.clear();
+                    IndexEventSubscribers();
+                }
+                Log::Debug("ScriptEngine", "Loaded script with id `{}`", scriptId);
             }
+        } catch (const sol::error& e) {
+            Log::Error("ScriptEngine", "Error loading script: {}", e.what());
+            return false;
+        }
 
-            if (const auto result = loadedChunk(env); !result.valid()) {
-                sol::error err = result;
-                return;
+        return true;
+    }
+
+    bool ScriptEngine::LoadIntoLanes(const sol::protected_function& script,
+                                     const ScriptID scriptId,
+                                     vector<BehaviorScriptContext>& outContexts) {
+        const auto chunkName = fmt::format("script_{}", scriptId);
+        outContexts.clear();
+        outContexts.reserve(mLanes.size());
+        try {
+            const auto bytecode = script.dump();
+            for (const auto& lane : mLanes) {
+                sol::load_result chunk = lane->lua.load(bytecode.as_string_view(), chunkName, sol::load_mode::binary);
+                if (!chunk.valid()) {
+                    const sol::error error = chunk;
+                    Log::Error("ScriptEngine", "Error loading script `{}` into a lane: {}", scriptId, error.what());
+                    return false;
+                }
+
+                auto env                     = sol::environment(lane->lua, sol::create, lane->lua.globals());
+                sol::protected_function copy = chunk;
+                sol::set_environment(env, copy);
+                env["Subscribe"] = [](const sol::variadic_args&) {};
+                if (const auto result = copy(); !result.valid()) {
+                    const sol::error error = result;
+                    Log::Error("ScriptEngine", "Error running script `{}` in a lane: {}", scriptId, error.what());
+                    return false;
+                }
+
+                outContexts.push_back(MakeBehaviorContext(std::move(env)));
             }
+        } catch (const sol::error& e) {
+            Log::Error("ScriptEngine", "Error loading script `{}` into lanes: {}", scriptId, e.what());
+            return false;
+        }
 
-            if (type == ScriptType::Behavior) {
-                sol::protected_function awakeFunc      = env["OnAwake"];
-                sol::protected_function updateFunc     = env["OnUpdate"];
-                sol::protected_function lateUpdateFunc = env["OnLateUpdate"];
-                sol::protected_function destroyedFunc  = env["OnDestroyed"];
+        return true;
+    }
+
+    BehaviorScriptContext* ScriptEngine::FindContext(const ScriptID id, const i32 instance) {
+        const auto it = mBehaviorScriptContexts.find(id);
+        if (it == mBehaviorScriptContexts.end()) return nullptr;
+        if (!it->second.isolated) return &it->second;
+
+        auto& contexts     = mLanes[ScriptInstance::GetLane(instance)]->contexts;
+        const auto laneCtx = contexts.find(id);
+        return laneCtx != contexts.end() ? &laneCtx->second : nullptr;
+    }
+
+    void ScriptEngine::CreateInstances(const ScriptID id, std::span<i32> outInstances) {
+        const auto it = mBehaviorScriptContexts.find(id);
+        if (it == mBehaviorScriptContexts.end() || !it->second.prototype.valid()) {
+            std::ranges::fill(outInstances, Behavior::kStateless);
+            return;
+        }
+
+        auto& ctx = it->second;
+        if (!ctx.isolated) {
+            const ScriptAllocator::ScriptScope scope(mAllocator, id);
+            FillInstances(ctx, outInstances);
+            for (auto& instance : outInstances) {
+                instance = ScriptInstance::Pack(instance, 0);
+            }
+            return;
+        }
+
+        // Dealt out in runs so entities created together share a lane and its cache, round robin across calls so
+        // scenes that spawn a few at a time still spread over every lane
+        const size_t laneCount = mLanes.size();
+        const size_t run       = std::max<size_t>(1, outInstances.size() / laneCount);
+        for (size_t first = 0; first < outInstances.size(); first += run) {
+            const u32 lane = ctx.nextLane;
+            ctx.nextLane   = CAST<u32>((lane + 1) % laneCount);
 
-                mBehaviorScriptContexts[scriptId] = {std::move(env),
-                                                     std::move(awakeFunc),
-                                                     std::move(updateFunc),
-                                                     std::move(lateUpdateFunc),
-                                                     std::move(destroyedFunc)};
+            auto& contexts   = mLanes[lane]->contexts;
+            const auto slice = outInstances.subspan(first, std::min(run, outInstances.size() - first));
+            const auto laneCtx = contexts.find(id);
+            if (laneCtx == contexts.end() || !laneCtx->second.prototype.valid()) {
+                std::ranges::fill(slice, Behavior::kStateless);
+                continue;
             }
-        } catch (const sol::error& e) { Log::Error("ScriptEngine", "Error loading script: {}", e.what()); }
+
+            FillInstances(laneCtx->second, slice);
+            for (auto& instance : slice) {
+                instance = ScriptInstance::Pack(instance, lane);
+            }
+        }
+    }
+
+    void ScriptEngine::FillInstances(BehaviorScriptContext& ctx, std::span<i32> outRefs) {
+        lua_State* L = ctx.env.lua_state();
+        ctx.prototype.push(L);
+        const i32 prototype = lua_gettop(L);
+        for (auto& instance : outRefs) {
+            if (!ctx.freeInstances.empty()) {
+                instance = ctx.freeInstances.back();
+                ctx.freeInstances.pop_back();
+                lua_rawgeti(L, LUA_REGISTRYINDEX, instance);
+            } else {
+                lua_createtable(L, 0, ctx.prototypeFields);
+                lua_pushvalue(L, -1);
+                instance = luaL_ref(L, LUA_REGISTRYINDEX);
+            }
+
+            // Shallow copy, tables held by the prototype are shared by every instance
+            lua_pushnil(L);
+            while (lua_next(L, prototype) != 0) {
+                lua_pushvalue(L, -2);
+                lua_insert(L, -2);
+                lua_rawset(L, -4);
+            }
+            lua_pop(L, 1);
+        }
+        lua_pop(L, 1);
+    }
+
+    void ScriptEngine::ReleaseInstances(std::span<const Behavior> behaviors) {
+        for (const auto& behavior : behaviors) {
+            if (behavior.instance < 0) continue;
+
+            const i32 ref = ScriptInstance::FromBehavior(behavior.instance).ref;
+            auto* ctx     = FindContext(behavior.script, behavior.instance);
+            if (!ctx) {
+                // Only isolated scripts keep instances outside the main state
+                const auto it = mBehaviorScriptContexts.find(behavior.script);
+                lua_State* L  = it != mBehaviorScriptContexts.end() && it->second.isolated
+                                  ? mLanes[ScriptInstance::GetLane(behavior.instance)]->lua.lua_state()
+                                  : mLua.lua_state();
+                luaL_unref(L, LUA_REGISTRYINDEX, ref);
+                continue;
+            }
+
+            ClearInstance(ctx->env.lua_state(), ref);
+            ctx->freeInstances.push_back(ref);
+        }
+    }
+
+    template<typename... Args>
+    sol::protected_function_result ScriptEngine::CallEntity(const BehaviorScriptContext& ctx,
+                                                            const sol::protected_function& callback,
+                                                            const BehaviorEntity& entity,
+                                                            const Args&... args) {
+        if (!ctx.prototype.valid()) return callback(entity, args...);
+
+        // Entities that were never given an instance, like ones called directly rather than through a Scene, see
+        // the prototype itself
+        if (entity.instance < 0) return callback(ctx.prototype, entity, args...);
+        return callback(ScriptInstance::FromBehavior(entity.instance), entity, args...);
     }
 
     void ScriptEngine::CallAwakeBehavior(const ScriptID id, const BehaviorEntity& entity) {
@@ -136,15 +686,17 @@ namespace Astera {
             return;
         }
 
-        if (!mBehaviorScriptContexts.contains(id)) {
+        const auto* ctx = FindContext(id, entity.instance);
+        if (!ctx) {
             PrintScriptNotFoundError(id);
             return;
         }
 
-        const auto& ctx = mBehaviorScriptContexts[id];
-        if (ctx.OnAwake.valid()) {
+        const ScriptAllocator::ScriptScope scope(mAllocator, id);
+        if (ctx->OnAwake.valid()) {
+            const ScriptProfiler::Scope timing(mProfiler, id, ScriptCallback::Awake);
             try {
-                std::ignore = ctx.OnAwake(entity);
+                std::ignore = CallEntity(*ctx, ctx->OnAwake, entity);
             } catch (const sol::error& e) { Log::Error("ScriptEngine", "{}", e.what()); }
         }
     }
@@ -155,15 +707,38 @@ namespace Astera {
             return;
         }
 
-        if (!mBehaviorScriptContexts.contains(id)) {
+        const auto* ctx = FindContext(id, entity.instance);
+        if (!ctx) {
+            PrintScriptNotFoundError(id);
+            return;
+        }
+
+        const ScriptAllocator::ScriptScope scope(mAllocator, id);
+        if (ctx->OnUpdate.valid()) {
+            const ScriptProfiler::Scope timing(mProfiler, id, ScriptCallback::Update);
+            try {
+                std::ignore = CallEntity(*ctx, ctx->OnUpdate, entity, clock);
+            } catch (const sol::error& e) { Log::Error("ScriptEngine", "{}", e.what()); }
+        }
+    }
+
+    void ScriptEngine::CallFixedUpdateBehavior(const ScriptID id, const BehaviorEntity& entity, const f32 timeStep) {
+        if (!mInitialized) {
+            PrintUninitializedError();
+            return;
+        }
+
+        const auto* ctx = FindContext(id, entity.instance);
+        if (!ctx) {
             PrintScriptNotFoundError(id);
             return;
         }
 
-        const auto& ctx = mBehaviorScriptContexts[id];
-        if (ctx.OnAwake.valid()) {
+        const ScriptAllocator::ScriptScope scope(mAllocator, id);
+        if (ctx->OnFixedUpdate.valid()) {
+            const ScriptProfiler::Scope timing(mProfiler, id, ScriptCallback::FixedUpdate);
             try {
-                std::ignore = ctx.OnUpdate(entity, clock);
+                std::ignore = CallEntity(*ctx, ctx->OnFixedUpdate, entity, timeStep);
             } catch (const sol::error& e) { Log::Error("ScriptEngine", "{}", e.what()); }
         }
     }
@@ -174,38 +749,578 @@ namespace Astera {
             return;
         }
 
-        if (!mBehaviorScriptContexts.contains(id)) {
+        const auto* ctx = FindContext(id, entity.instance);
+        if (!ctx) {
             PrintScriptNotFoundError(id);
             return;
         }
 
-        const auto& ctx = mBehaviorScriptContexts[id];
-        if (ctx.OnAwake.valid()) {
+        const ScriptAllocator::ScriptScope scope(mAllocator, id);
+        if (ctx->OnLateUpdate.valid()) {
+            const ScriptProfiler::Scope timing(mProfiler, id, ScriptCallback::LateUpdate);
             try {
-                std::ignore = ctx.OnLateUpdate(entity);
+                std::ignore = CallEntity(*ctx, ctx->OnLateUpdate, entity);
             } catch (const sol::error& e) { Log::Error("ScriptEngine", "{}", e.what()); }
         }
     }
 
+    void ScriptEngine::CallUpdateBehaviors(const ScriptID id, const BehaviorBatch& batch, const Clock& clock) {
+        const auto it = mBehaviorScriptContexts.find(id);
+        if (it == mBehaviorScriptContexts.end()) {
+            PrintScriptNotFoundError(id);
+            return;
+        }
+
+        auto& ctx = it->second;
+        const ScriptProfiler::Scope timing(
+          mProfiler, id, ScriptCallback::Update, CountCalls(ctx.OnUpdate, ctx.OnUpdateBatch, batch));
+        if (ctx.isolated) {
+            CallIsolatedBehaviors(
+              id, &BehaviorScriptContext::OnUpdate, &BehaviorScriptContext::OnUpdateBatch, batch, clock);
+            return;
+        }
+
+        const ScriptAllocator::ScriptScope scope(mAllocator, id);
+        CallBehaviors(ctx, ctx.OnUpdate, ctx.OnUpdateBatch, batch, clock);
+    }
+
+    void ScriptEngine::CallFixedUpdateBehaviors(const ScriptID id, const BehaviorBatch& batch, const f32 timeStep) {
+        const auto it = mBehaviorScriptContexts.find(id);
+        if (it == mBehaviorScriptContexts.end()) {
+            PrintScriptNotFoundError(id);
+            return;
+        }
+
+        auto& ctx = it->second;
+        const ScriptProfiler::Scope timing(
+          mProfiler, id, ScriptCallback::FixedUpdate, CountCalls(ctx.OnFixedUpdate, ctx.OnFixedUpdateBatch, batch));
+        if (ctx.isolated) {
+            CallIsolatedBehaviors(
+              id, &BehaviorScriptContext::OnFixedUpdate, &BehaviorScriptContext::OnFixedUpdateBatch, batch, timeStep);
+            return;
+        }
+
+        const ScriptAllocator::ScriptScope scope(mAllocator, id);
+        CallBehaviors(ctx, ctx.OnFixedUpdate, ctx.OnFixedUpdateBatch, batch, timeStep);
+    }
+
+    void ScriptEngine::CallLateUpdateBehaviors(const ScriptID id, const BehaviorBatch& batch) {
+        const auto it = mBehaviorScriptContexts.find(id);
+        if (it == mBehaviorScriptContexts.end()) {
+            PrintScriptNotFoundError(id);
+            return;
+        }
+
+        auto& ctx = it->second;
+        const ScriptProfiler::Scope timing(
+          mProfiler, id, ScriptCallback::LateUpdate, CountCalls(ctx.OnLateUpdate, ctx.OnLateUpdateBatch, batch));
+        if (ctx.isolated) {
+            CallIsolatedBehaviors(
+              id, &BehaviorScriptContext::OnLateUpdate, &BehaviorScriptContext::OnLateUpdateBatch, batch);
+            return;
+        }
+
+        const ScriptAllocator::ScriptScope scope(mAllocator, id);
+        CallBehaviors(ctx, ctx.OnLateUpdate, ctx.OnLateUpdateBatch, batch);
+    }
+
+    template<typename... Args>
+    void ScriptEngine::CallBehaviors(BehaviorScriptContext& ctx,
+                                     const sol::protected_function& perEntity,
+                                     const sol::protected_function& batched,
+                                     const BehaviorBatch& batch,
+                                     const Args&... args) {
+        const auto check = [](const sol::protected_function_result& result) {
+            if (!result.valid()) {
+                const sol::error err = result;
+                Log::Error("ScriptEngine", "{}", err.what());
+            }
+        };
+
+        try {
+            if (!batched.valid()) {
+                if (!perEntity.valid()) return;
+                for (size_t i = 0; i < batch.Size(); ++i) {
+                    const BehaviorEntity entity(
+                      batch.entities[i], batch.names[i], batch.transforms[i], batch.instances[i]);
+                    check(CallEntity(ctx, perEntity, entity, args...));
+                }
+                return;
+            }
+
+            if (!ctx.batchEntities.valid()) {
+                sol::state_view lua(ctx.env.lua_state());
+                ctx.batchEntities = lua.create_table();
+                if (ctx.prototype.valid()) {
+                    ctx.batchInstances             = lua.create_table();
+                    ctx.batchEntities["instances"] = ctx.batchInstances;
+                }
+            }
+
+            // Entities usually keep their slot from one call to the next, only the entries that changed are pushed so
+            // a steady scene refills the table without creating any userdata. Entries past `count` are stale.
+            auto& pushed = ctx.pushedEntities;
+            for (size_t i = 0; i < batch.Size(); ++i) {
+                const u32 entity     = batch.entities[i];
+                const NameID name    = batch.names[i];
+                Transform* transform = batch.transforms[i];
+                const i32 instance   = batch.instances[i];
+                if (i < pushed.Size()) {
+                    if (pushed.entities[i] == entity && pushed.names[i] == name && pushed.transforms[i] == transform &&
+                        pushed.instances[i] == instance) {
+                        continue;
+                    }
+                    pushed.entities[i]   = entity;
+                    pushed.names[i]      = name;
+                    pushed.transforms[i] = transform;
+                    pushed.instances[i]  = instance;
+                } else {
+                    pushed.Add(entity, name, transform, instance);
+                }
+                ctx.batchEntities.raw_set(i + 1, BehaviorEntity(entity, name, transform, instance));
+                if (ctx.batchInstances.valid()) {
+                    ctx.batchInstances.raw_set(i + 1, ScriptInstance::FromBehavior(instance));
+                }
+            }
+            ctx.batchEntities["count"]      = batch.Size();
+            ctx.batchEntities["transforms"] = RCAST<void*>(CCAST<Transform**>(batch.transforms.data()));
+
+            check(batched(ctx.batchEntities, args...));
+        } catch (const sol::error& e) { Log::Error("ScriptEngine", "{}", e.what()); }
+    }
+
+    template<typename... Args>
+    void ScriptEngine::CallIsolatedBehaviors(const ScriptID id,
+                                             sol::protected_function BehaviorScriptContext::*perEntity,
+                                             sol::protected_function BehaviorScriptContext::*batched,
+                                             const BehaviorBatch& batch,
+                                             const Args&... args) {
+        for (const auto& lane : mLanes) {
+            lane->batch.Clear();
+        }
+
+        // Stateless entities have nothing tying them to a lane and are spread evenly
+        const size_t laneCount = mLanes.size();
+        for (size_t i = 0; i < batch.Size(); ++i) {
+            const i32 instance = batch.instances[i];
+            const size_t lane  = instance >= 0 ? ScriptInstance::GetLane(instance) : i % laneCount;
+            mLanes[lane]->batch.Add(batch.entities[i], batch.names[i], batch.transforms[i], instance);
+        }
+
+        // Each lane only touches its own state and its entities' transforms, so lanes need no locking. Script memory
+        // stats don't cover lanes, they use LuaJIT's allocator.
+        ParallelFor(
+          0,
+          laneCount,
+          [&](const size_t index) {
+              auto& lane = *mLanes[index];
+              if (lane.batch.Size() == 0) return;
+
+              const auto it = lane.contexts.find(id);
+              if (it == lane.contexts.end()) return;
+              auto& ctx = it->second;
+              CallBehaviors(ctx, ctx.*perEntity, ctx.*batched, lane.batch, args...);
+          },
+          1);
+    }
+
+    void ScriptEngine::CallIsolatedCollisions(const ScriptID id,
+                                              sol::protected_function BehaviorScriptContext::*callback,
+                                              const CollisionEventBatch& batch) {
+        for (const auto& lane : mLanes) {
+            lane->collisions.Clear();
+        }
+        for (size_t i = 0; i < batch.Size(); ++i) {
+            const u32 lane = ScriptInstance::GetLane(batch.instances[i]);
+            mLanes[lane]->collisions.Add(
+              batch.entities[i], batch.others[i], batch.triggers[i] != 0, batch.instances[i]);
+        }
+
+        // Collision events are few enough that the lanes take them in turn
+        for (const auto& lane : mLanes) {
+            if (lane->collisions.Size() == 0) continue;
+
+            const auto it = lane->contexts.find(id);
+            if (it == lane->contexts.end() || !(it->second.*callback).valid()) continue;
+            CallCollisionBehavior(it->second, it->second.*callback, lane->collisions);
+        }
+    }
+
     void ScriptEngine::CallDestroyedBehavior(const ScriptID id, const BehaviorEntity& entity) {
         if (!mInitialized) {
             PrintUninitializedError();
             return;
         }
 
-        if (!mBehaviorScriptContexts.contains(id)) {
+        const auto* ctx = FindContext(id, entity.instance);
+        if (!ctx) {
             PrintScriptNotFoundError(id);
             return;
         }
 
-        const auto& ctx = mBehaviorScriptContexts[id];
-        if (ctx.OnAwake.valid()) {
+        const ScriptAllocator::ScriptScope scope(mAllocator, id);
+        if (ctx->OnDestroyed.valid()) {
+            const ScriptProfiler::Scope timing(mProfiler, id, ScriptCallback::Destroyed);
             try {
-                std::ignore = ctx.OnDestroyed(entity);
+                std::ignore = CallEntity(*ctx, ctx->OnDestroyed, entity);
             } catch (const sol::error& e) { Log::Error("ScriptEngine", "{}", e.what()); }
         }
     }
 
+    bool ScriptEngine::HasCollisionCallbacks(const ScriptID id) const {
+        const auto it = mBehaviorScriptContexts.find(id);
+        if (it == mBehaviorScriptContexts.end())
+            return false;
+        return it->second.OnCollisionEnter.valid() || it->second.OnCollisionExit.valid();
+    }
+
+    void ScriptEngine::CallCollisionEnterBehavior(const ScriptID id, const CollisionEventBatch& batch) {
+        if (!mInitialized) {
+            PrintUninitializedError();
+            return;
+        }
+
+        if (!mBehaviorScriptContexts.contains(id)) {
+            PrintScriptNotFoundError(id);
+            return;
+        }
+
+        auto& ctx = mBehaviorScriptContexts[id];
+        const ScriptProfiler::Scope timing(
+          mProfiler, id, ScriptCallback::CollisionEnter, ctx.OnCollisionEnter.valid() ? 1 : 0);
+        if (ctx.isolated) {
+            CallIsolatedCollisions(id, &BehaviorScriptContext::OnCollisionEnter, batch);
+            return;
+        }
+
+        const ScriptAllocator::ScriptScope scope(mAllocator, id);
+        if (ctx.OnCollisionEnter.valid())
+            CallCollisionBehavior(ctx, ctx.OnCollisionEnter, batch);
+    }
+
+    void ScriptEngine::CallCollisionExitBehavior(const ScriptID id, const CollisionEventBatch& batch) {
+        if (!mInitialized) {
+            PrintUninitializedError();
+            return;
+        }
+
+        if (!mBehaviorScriptContexts.contains(id)) {
+            PrintScriptNotFoundError(id);
+            return;
+        }
+
+        auto& ctx = mBehaviorScriptContexts[id];
+        const ScriptProfiler::Scope timing(
+          mProfiler, id, ScriptCallback::CollisionExit, ctx.OnCollisionExit.valid() ? 1 : 0);
+        if (ctx.isolated) {
+            CallIsolatedCollisions(id, &BehaviorScriptContext::OnCollisionExit, batch);
+            return;
+        }
+
+        const ScriptAllocator::ScriptScope scope(mAllocator, id);
+        if (ctx.OnCollisionExit.valid())
+            CallCollisionBehavior(ctx, ctx.OnCollisionExit, batch);
+    }
+
+    void ScriptEngine::CallCollisionBehavior(BehaviorScriptContext& ctx,
+                                             const sol::protected_function& callback,
+                                             const CollisionEventBatch& batch) {
+        try {
+            // The same tables are refilled every frame, entries past `count` are left over from earlier frames
+            if (!ctx.collisionEvents.valid()) {
+                sol::state_view lua(ctx.env.lua_state());
+                ctx.collisionEvents            = lua.create_table();
+                ctx.collisionEvents["count"]   = 0;
+                ctx.collisionEvents["entity"]  = lua.create_table();
+                ctx.collisionEvents["other"]   = lua.create_table();
+                ctx.collisionEvents["trigger"] = lua.create_table();
+                if (ctx.prototype.valid()) { ctx.collisionEvents["instance"] = lua.create_table(); }
+            }
+
+            sol::table entities = ctx.collisionEvents["entity"];
+            sol::table others   = ctx.collisionEvents["other"];
+            sol::table triggers = ctx.collisionEvents["trigger"];
+            sol::table instances;
+            if (ctx.prototype.valid()) { instances = ctx.collisionEvents["instance"]; }
+            for (size_t i = 0; i < batch.Size(); ++i) {
+                entities.raw_set(i + 1, batch.entities[i]);
+                others.raw_set(i + 1, batch.others[i]);
+                triggers.raw_set(i + 1, batch.triggers[i] != 0);
+                if (instances.valid()) { instances.raw_set(i + 1, ScriptInstance::FromBehavior(batch.instances[i])); }
+            }
+            ctx.collisionEvents["count"] = batch.Size();
+
+            const auto result = callback(ctx.collisionEvents);
+            if (!result.valid()) {
+                const sol::error err = result;
+                Log::Error("ScriptEngine", "{}", err.what());
+            }
+        } catch (const sol::error& e) { Log::Error("ScriptEngine", "{}", e.what()); }
+    }
+
+    void ScriptEngine::QueueEvent(const ScriptEvent& event, const NameID targetName, const Behavior* target) {
+        const auto it = mEventSubscribers.find(event.type);
+        if (it == mEventSubscribers.end()) return;
+
+        for (auto& subscriber : it->second) {
+            if (!subscriber.filter.Matches(event, targetName)) continue;
+
+            // Instance tables are only meaningful to the script that owns them
+            const i32 instance = target && target->script == subscriber.script ? target->instance : Behavior::kStateless;
+            subscriber.batch.Add(event.target, event.sender, event.value, instance);
+        }
+    }
+
+    void ScriptEngine::DeliverEvents() {
+        if (!mInitialized) return;
+
+        // Handlers can load scripts, e.g. by changing scenes, the index is only rebuilt once this loop is done
+        mDeliveringEvents = true;
+        for (auto& [type, subscribers] : mEventSubscribers) {
+            for (auto& subscriber : subscribers) {
+                if (subscriber.batch.Size() == 0) continue;
+
+                // A script loaded by an earlier handler may have other subscriptions now
+                const auto it = mBehaviorScriptContexts.find(subscriber.script);
+                if (it != mBehaviorScriptContexts.end() && subscriber.subscription < it->second.subscriptions.size() &&
+                    it->second.subscriptions[subscriber.subscription].type == type) {
+                    const ScriptAllocator::ScriptScope scope(mAllocator, subscriber.script);
+                    const ScriptProfiler::Scope timing(mProfiler, subscriber.script, ScriptCallback::Event);
+                    CallEventBehavior(it->second, it->second.subscriptions[subscriber.subscription], subscriber.batch);
+                }
+                subscriber.batch.Clear();
+            }
+        }
+        mDeliveringEvents = false;
+
+        if (mEventSubscribersDirty) { IndexEventSubscribers(); }
+    }
+
+    void ScriptEngine::IndexEventSubscribers() {
+        if (mDeliveringEvents) {
+            mEventSubscribersDirty = true;
+            return;
+        }
+
+        mEventSubscribersDirty = false;
+        mEventSubscribers.clear();
+        for (const auto& [id, ctx] : mBehaviorScriptContexts) {
+            for (u32 i = 0; i < ctx.subscriptions.size(); ++i) {
+                const auto& subscription = ctx.subscriptions[i];
+                mEventSubscribers[subscription.type].push_back({id, i, subscription.filter});
+            }
+        }
+    }
+
+    void ScriptEngine::CallEventBehavior(const BehaviorScriptContext& ctx,
+                                         EventSubscription& subscription,
+                                         const ScriptEventBatch& batch) {
+        try {
+            // Refilled every frame like the collision tables, entries past `count` are left over from earlier frames
+            if (!subscription.events.valid()) {
+                sol::state_view lua(ctx.env.lua_state());
+                subscription.events           = lua.create_table();
+                subscription.events["count"]  = 0;
+                subscription.events["target"] = lua.create_table();
+                subscription.events["sender"] = lua.create_table();
+                subscription.events["value"]  = lua.create_table();
+                if (ctx.prototype.valid()) { subscription.events["instance"] = lua.create_table(); }
+            }
+
+            sol::table targets = subscription.events["target"];
+            sol::table senders = subscription.events["sender"];
+            sol::table values  = subscription.events["value"];
+            sol::table instances;
+            if (ctx.prototype.valid()) { instances = subscription.events["instance"]; }
+            // Missing entities are nil, which also clears what earlier frames left at the same index
+            const auto entity = [](const u32 id) -> sol::optional<u32> {
+                return id != EventBus::kNoEntity ? sol::optional<u32>(id) : sol::nullopt;
+            };
+            for (size_t i = 0; i < batch.Size(); ++i) {
+                targets.raw_set(i + 1, entity(batch.targets[i]));
+                senders.raw_set(i + 1, entity(batch.senders[i]));
+                values.raw_set(i + 1, batch.values[i]);
+                if (instances.valid()) {
+                    if (batch.instances[i] >= 0) {
+                        instances.raw_set(i + 1, ScriptInstance::FromBehavior(batch.instances[i]));
+                    } else {
+                        instances.raw_set(i + 1, sol::lua_nil);
+                    }
+                }
+            }
+            subscription.events["count"] = batch.Size();
+
+            const auto result = subscription.handler(subscription.events);
+            if (!result.valid()) {
+                const sol::error err = result;
+                Log::Error("ScriptEngine", "{}", err.what());
+            }
+        } catch (const sol::error& e) { Log::Error("ScriptEngine", "{}", e.what()); }
+    }
+
+    bool ScriptEngine::HasRoutine(const ScriptID id) const {
+        const auto it = mBehaviorScriptContexts.find(id);
+        return it != mBehaviorScriptContexts.end() && it->second.Routine.valid();
+    }
+
+    void ScriptEngine::StartRoutines(const ScriptID id, const BehaviorBatch& batch) {
+        const auto it = mBehaviorScriptContexts.find(id);
+        if (it == mBehaviorScriptContexts.end() || !it->second.Routine.valid()) return;
+
+        const auto& ctx = it->second;
+        lua_State* L    = mLua.lua_state();
+        for (size_t i = 0; i < batch.Size(); ++i) {
+            const u32 entityId = batch.entities[i];
+            const i32 instance = batch.instances[i];
+            if (const auto running = mEntityRoutines.find(entityId); running != mEntityRoutines.end()) {
+                EndRoutine(running->second, false);
+            }
+
+            u32 index;
+            if (!mFreeRoutines.empty()) {
+                index = mFreeRoutines.back();
+                mFreeRoutines.pop_back();
+            } else {
+                index = CAST<u32>(mRoutines.size());
+                mRoutines.emplace_back();
+            }
+
+            auto& routine = mRoutines[index];
+            if (!mFreeThreads.empty()) {
+                std::tie(routine.thread, routine.threadRef) = mFreeThreads.back();
+                mFreeThreads.pop_back();
+            } else {
+                routine.thread    = lua_newthread(L);
+                routine.threadRef = luaL_ref(L, LUA_REGISTRYINDEX);
+            }
+            routine.script            = id;
+            routine.entityId          = entityId;
+            routine.instance          = instance;
+            mEntityRoutines[entityId] = index;
+
+            lua_State* thread = routine.thread;
+            ctx.Routine.push(thread);
+            i32 argCount = 1;
+            if (ctx.prototype.valid()) {
+                if (instance < 0) {
+                    ctx.prototype.push(thread);
+                } else {
+                    sol::stack::push(thread, ScriptInstance::FromBehavior(instance));
+                }
+                ++argCount;
+            }
+
+            // The routine keeps its Entity across waits, so it's pinned and its transform refreshed on every resume
+            sol::stack::push(thread, BehaviorEntity(entityId, batch.names[i], batch.transforms[i], instance));
+            routine.entity = sol::stack::get<BehaviorEntity*>(thread, -1);
+            lua_pushvalue(thread, -1);
+            routine.entityRef = luaL_ref(thread, LUA_REGISTRYINDEX);
+
+            ResumeRoutine(index, argCount);
+        }
+    }
+
+    void ScriptEngine::ResumeRoutines(const Clock& clock, const RoutineResolver& resolve) {
+        if (!mInitialized) return;
+
+        mDueRoutines.clear();
+        mScheduler.Advance(clock.GetDeltaTimePrecise(), mDueRoutines);
+        for (const auto handle : mDueRoutines) {
+            auto& routine = mRoutines[handle.index];
+            if (!routine.thread || routine.generation != handle.generation) continue;
+
+            routine.wait         = RoutineWait::None;
+            Transform* transform = resolve(routine.entityId, routine.script, routine.instance);
+            if (!transform) {
+                EndRoutine(handle.index, false);
+                continue;
+            }
+
+            routine.entity->transform = transform;
+            ResumeRoutine(handle.index, 0);
+        }
+    }
+
+    void ScriptEngine::StopRoutines() {
+        for (u32 index = 0; index < mRoutines.size(); ++index) {
+            if (mRoutines[index].thread) { EndRoutine(index, false); }
+        }
+        mScheduler.Clear();
+    }
+
+    void ScriptEngine::SignalEvent(const NameID event) {
+        mScheduler.Signal(event);
+    }
+
+    void ScriptEngine::ResumeRoutine(const u32 index, const i32 argCount) {
+        lua_State* thread     = mRoutines[index].thread;
+        const ScriptID script = mRoutines[index].script;
+
+        i32 status;
+        {
+            const ScriptAllocator::ScriptScope scope(mAllocator, script);
+            const ScriptProfiler::Scope timing(mProfiler, script, ScriptCallback::Routine);
+            status = lua_resume(thread, nullptr, argCount);
+        }
+
+        if (status == 0) {
+            EndRoutine(index, true);
+            return;
+        }
+
+        if (status != LUA_YIELD) {
+            Log::Error("ScriptEngine", "Routine of script `{}` failed: {}", script, lua_tostring(thread, -1));
+            EndRoutine(index, false);
+            return;
+        }
+
+        // Anything yielded other than a wait, like a bare coroutine.yield(), sleeps for a frame
+        auto& routine = mRoutines[index];
+        const ScriptScheduler::Handle handle {index, routine.generation};
+        const bool isWait = lua_gettop(thread) == 3 && lua_touserdata(thread, 1) == &kRoutineWaitTag;
+        switch (isWait ? lua_tointeger(thread, 2) : 1) {
+            case 2:
+                routine.wait = RoutineWait::Seconds;
+                mScheduler.WaitSeconds(handle, lua_tonumber(thread, 3));
+                break;
+            case 3:
+                routine.wait  = RoutineWait::Event;
+                routine.event = NameID(lua_tostring(thread, 3));
+                mScheduler.WaitEvent(handle, routine.event);
+                break;
+            default: {
+                const lua_Integer frames = isWait ? lua_tointeger(thread, 3) : 1;
+                routine.wait             = RoutineWait::Frames;
+                mScheduler.WaitFrames(handle, CAST<u64>(std::max<lua_Integer>(frames, 1)));
+                break;
+            }
+        }
+        lua_settop(thread, 0);
+    }
+
+    void ScriptEngine::EndRoutine(const u32 index, const bool finished) {
+        auto& routine = mRoutines[index];
+        lua_State* L  = mLua.lua_state();
+        if (routine.wait == RoutineWait::Event) { mScheduler.CancelEvent({index, routine.generation}, routine.event); }
+
+        luaL_unref(L, LUA_REGISTRYINDEX, routine.entityRef);
+        if (finished) {
+            lua_settop(routine.thread, 0);
+            mFreeThreads.emplace_back(routine.thread, routine.threadRef);
+        } else {
+            // A thread that was cut short or raised an error can't run anything else
+            luaL_unref(L, LUA_REGISTRYINDEX, routine.threadRef);
+        }
+
+        const auto it = mEntityRoutines.find(routine.entityId);
+        if (it != mEntityRoutines.end() && it->second == index) { mEntityRoutines.erase(it); }
+
+        const u32 generation = routine.generation + 1;
+        routine              = {};
+        routine.generation   = generation;
+        mFreeRoutines.push_back(index);
+    }
+
     void ScriptEngine::ExecuteFile(const Path& filename) {
         if (!mInitialized) {
             PrintUninitializedError();
@@ -34,8 +34,18 @@
 #include "Vendor/sol/sol.hpp"
 
 #include "Clock.hpp"
+#include "EventBus.hpp"
+#include "NameID.hpp"
+#include "ScriptAllocator.hpp"
+#include "ScriptCache.hpp"
+#include "ScriptProfiler.hpp"
+#include "ScriptScheduler.hpp"
+#include "Components/Behavior.hpp"
 #include "Components/Transform.hpp"
 
+#include <functional>
+#include <span>
+
 namespace Astera {
     struct BehaviorEntity;
 
@@ -82,18 +92,204 @@ namespace Astera {
         }
     };
 
+    /// @brief Registry reference to an entity's instance table, pushed to Lua as the table itself
+    struct ScriptInstance {
+        /// @brief Most lanes isolated scripts can be spread over, see ScriptEngine::EnableIsolatedScripts
+        static constexpr i32 kMaxLanes = 64;
+
+        i32 ref;
+
+        /// @brief Packs a registry reference with the lane whose Lua state holds it, giving a Behavior::instance
+        static i32 Pack(i32 ref, u32 lane) {
+            return ref * kMaxLanes + CAST<i32>(lane);
+        }
+
+        /// @brief Unpacks a Behavior::instance, Behavior::kNoInstance and kStateless pass through
+        static ScriptInstance FromBehavior(i32 instance) {
+            return {instance >= 0 ? instance / kMaxLanes : instance};
+        }
+
+        /// @brief Lane of a Behavior::instance, lane 0 for entities without an instance table
+        static u32 GetLane(i32 instance) {
+            return instance >= 0 ? CAST<u32>(instance % kMaxLanes) : 0;
+        }
+    };
+
+    inline int sol_lua_push(sol::types<ScriptInstance>, lua_State* L, const ScriptInstance& instance) {
+        lua_rawgeti(L, LUA_REGISTRYINDEX, instance.ref);
+        return 1;
+    }
+
+    /// @brief Entities that share a behavior script, stored as parallel arrays
+    struct BehaviorBatch {
+        vector<u32> entities;
+        vector<NameID> names;
+        vector<Transform*> transforms;
+        vector<i32> instances;
+
+        ASTERA_KEEP size_t Size() const {
+            return entities.size();
+        }
+
+        void Add(u32 entity, NameID name, Transform* transform, i32 instance) {
+            entities.push_back(entity);
+            names.push_back(name);
+            transforms.push_back(transform);
+            instances.push_back(instance);
+        }
+
+        void Clear() {
+            entities.clear();
+            names.clear();
+            transforms.clear();
+            instances.clear();
+        }
+    };
+
+    /// @brief Which events of its type a subscription receives
+    struct EventFilter {
+        enum class Kind : u8 {
+            Any,     ///< Every event
+            Entity,  ///< Events sent to one entity
+            Tag,     ///< Events sent to a tag, or to an entity whose name is the tag
+        };
+
+        Kind kind {Kind::Any};
+        u32 entity {EventBus::kNoEntity};
+        NameID tag;
+
+        /// @param targetName Name of the event's target, empty for events without one
+        ASTERA_KEEP bool Matches(const ScriptEvent& event, NameID targetName) const {
+            switch (kind) {
+                case Kind::Entity:
+                    return event.target == entity;
+                case Kind::Tag:
+                    return event.tag == tag || (!targetName.IsNone() && targetName == tag);
+                default:
+                    return true;
+            }
+        }
+    };
+
+    /// @brief A handler a behavior script registers with `Subscribe(type, handler, filter)` while it loads
+    struct EventSubscription {
+        NameID type;
+        EventFilter filter;
+        sol::protected_function handler;
+        /// @brief Event table handed to the handler, reused every frame
+        sol::table events;
+    };
+
+    /// @brief Events gathered for one subscription during a frame, stored as parallel arrays
+    struct ScriptEventBatch {
+        vector<u32> targets;
+        vector<u32> senders;
+        vector<f32> values;
+        /// @brief Instance of each target, for targets running the subscribing script, see Behavior::instance
+        vector<i32> instances;
+
+        ASTERA_KEEP size_t Size() const {
+            return targets.size();
+        }
+
+        void Add(u32 target, u32 sender, f32 value, i32 instance) {
+            targets.push_back(target);
+            senders.push_back(sender);
+            values.push_back(value);
+            instances.push_back(instance);
+        }
+
+        void Clear() {
+            targets.clear();
+            senders.clear();
+            values.clear();
+            instances.clear();
+        }
+    };
+
     /// @brief Context data for a behavior script, including its environment and lifecycle callbacks
+    ///
+    /// A script that declares an `Instance` table gets a copy of it for each entity. Its per-entity callbacks are
+    /// then read from that table and called as methods, with the entity's copy as self.
     struct BehaviorScriptContext {
         /// @brief Isolated Lua environment for this script
         sol::environment env;
+        /// @brief The script's Instance table, invalid for scripts whose entities share the script's state
+        sol::table prototype;
+        /// @brief Number of fields in prototype, used to size new instance tables
+        i32 prototypeFields {0};
+        /// @brief Instance tables given back by destroyed entities, emptied and ready to be refilled
+        vector<i32> freeInstances;
+        /// @brief Whether the script declares `Isolated = true` and runs on the lanes, see
+        /// ScriptEngine::EnableIsolatedScripts. Only set on the main state's context.
+        bool isolated {false};
+        /// @brief Lane the next entity's instance table goes to
+        u32 nextLane {0};
         /// @brief Lua function called when the behavior is initialized
         sol::protected_function OnAwake;
         /// @brief Lua function called every frame during update
         sol::protected_function OnUpdate;
+        /// @brief Lua function called at the fixed update rate, before the physics step
+        sol::protected_function OnFixedUpdate;
         /// @brief Lua function called after all updates for the frame
         sol::protected_function OnLateUpdate;
+        /// @brief Optional replacement for OnUpdate, called once per frame with every entity running this script
+        sol::protected_function OnUpdateBatch;
+        /// @brief Optional replacement for OnFixedUpdate, called once per fixed update with every entity
+        sol::protected_function OnFixedUpdateBatch;
+        /// @brief Optional replacement for OnLateUpdate, called once per frame with every entity
+        sol::protected_function OnLateUpdateBatch;
         /// @brief Lua function called when the behavior is destroyed
         sol::protected_function OnDestroyed;
+        /// @brief Lua function run as a coroutine for every entity, started once the entity has its instance table.
+        /// It sleeps on WaitSeconds, WaitFrames and WaitEvent, see ScriptEngine::ResumeRoutines.
+        sol::protected_function Routine;
+        /// @brief Lua function called once per frame with every contact that began for this script's entities
+        sol::protected_function OnCollisionEnter;
+        /// @brief Lua function called once per frame with every contact that ended for this script's entities
+        sol::protected_function OnCollisionExit;
+        /// @brief Event table handed to the collision callbacks, reused every frame
+        sol::table collisionEvents;
+        /// @brief Event handlers registered while the script loaded, in the order they were registered
+        vector<EventSubscription> subscriptions;
+        /// @brief Entity table handed to the batch callbacks, reused every call. Holds `count` entities, their
+        /// `instances` when the script declares Instance, and the `transforms` array that FFI:Transforms reads, which
+        /// is only valid during the call.
+        sol::table batchEntities;
+        /// @brief The `instances` array of batchEntities
+        sol::table batchInstances;
+        /// @brief What batchEntities currently holds, entries that are unchanged aren't pushed again
+        BehaviorBatch pushedEntities;
+    };
+
+    /// @brief Collision events for the entities of one behavior script, stored as parallel arrays
+    struct CollisionEventBatch {
+        /// @brief Entity receiving each event
+        vector<u32> entities;
+        /// @brief Entity on the other side of each contact
+        vector<u32> others;
+        /// @brief Whether either collider of each contact is a trigger
+        vector<u8> triggers;
+        /// @brief Script instance of the entity receiving each event, see Behavior::instance
+        vector<i32> instances;
+
+        ASTERA_KEEP size_t Size() const {
+            return entities.size();
+        }
+
+        void Add(u32 entity, u32 other, bool trigger, i32 instance) {
+            entities.push_back(entity);
+            others.push_back(other);
+            triggers.push_back(trigger);
+            instances.push_back(instance);
+        }
+
+        void Clear() {
+            entities.clear();
+            others.clear();
+            triggers.clear();
+            instances.clear();
+        }
     };
 
     /// @brief Types of scripts supported by the engine
@@ -104,13 +300,23 @@ namespace Astera {
         ScriptTypeCount,
     };
 
+    /// @brief Garbage collector activity, see ScriptEngine::StepGC
+    struct ScriptGCStats {
+        f32 frameTime {0.f};       ///< Milliseconds spent collecting in the last StepGC
+        u32 frameSteps {0};        ///< Collector steps taken in the last StepGC
+        u32 completedCycles {0};   ///< Collection cycles finished since startup
+        u32 overdueFrames {0};     ///< Frames that went over budget to keep up with allocation
+        u64 memoryBytes {0};       ///< Memory held by Lua after the last StepGC
+        u64 thresholdBytes {0};    ///< Memory at which the next cycle starts
+    };
+
     /// @brief Manages Lua script execution and lifecycle for the game engine
     class ScriptEngine {
     public:
         /// @brief Type alias for script identifiers
         using ScriptID = u64;
 
-        ScriptEngine()  = default;
+        ScriptEngine();
         ~ScriptEngine() = default;
 
         ASTERA_CLASS_PREVENT_MOVES_COPIES(ScriptEngine)
@@ -118,17 +324,110 @@ namespace Astera {
         /// @brief Initializes the script engine and Lua state
         void Initialize();
 
-        /// @brief Loads a script from source code
+        /// @brief Sets how long StepGC may collect for each frame
+        /// @param milliseconds Time budget per frame
+        void SetGCBudget(f32 milliseconds) {
+            mGCBudget = milliseconds;
+        }
+
+        /// @brief Runs incremental collector steps until the frame's budget is spent or the cycle finishes
+        ///
+        /// Lua's own collector is switched off, so this is the only place garbage is collected outside of
+        /// CollectGarbage. Call it once per frame at a point where a short pause is cheapest. A new cycle starts once
+        /// memory has grown to kGCPause percent of what the last cycle left alive. While a cycle runs each call does at
+        /// least as much work as Lua's collector would have for the bytes allocated since the previous call, going
+        /// over budget by up to kGCMaxBudgetScale times if it has to.
+        void StepGC();
+
+        /// @brief Runs a full collection, for loading screens and scene changes rather than gameplay
+        void CollectGarbage();
+
+        /// @brief Gets collector activity as of the last StepGC
+        ASTERA_KEEP const ScriptGCStats& GetGCStats() const {
+            return mGCStats;
+        }
+
+        /// @brief Gets the allocator behind the Lua state
+        /// @return The allocator, or nullptr if the Lua build doesn't accept custom allocators
+        ASTERA_KEEP const ScriptAllocator* GetAllocator() const {
+            return mUsesAllocator ? &mAllocator : nullptr;
+        }
+
+        /// @brief Gets the profiler timing every call into scripts, disabled until turned on
+        ASTERA_KEEP ScriptProfiler& GetProfiler() {
+            return mProfiler;
+        }
+
+        /// @brief Creates the Lua states isolated scripts run on, one per lane. Call once, before loading scripts.
+        ///
+        /// A script opts in with `Isolated = true`. It is then also loaded into every lane, its entities are dealt out
+        /// to the lanes as their instance tables are created, and the batched calls of each lane run in parallel on
+        /// the job system. Lanes only have what initializeLane registers, so isolated scripts change the shared world
+        /// through the scene's command buffer. Per-entity state belongs in Instance since file-level locals exist once
+        /// per lane. Lanes collect their own garbage, StepGC only paces the main state.
+        /// @param laneCount Number of lanes, at most ScriptInstance::kMaxLanes
+        /// @param initializeLane Registers globals and types on each lane's state
+        void EnableIsolatedScripts(u32 laneCount, const std::function<void(sol::state&)>& initializeLane);
+
+        /// @brief Gets the number of lanes isolated scripts run on, 0 while they're disabled
+        ASTERA_KEEP u32 GetLaneCount() const {
+            return CAST<u32>(mLanes.size());
+        }
+
+        /// @brief Stores the bytecode of every script loaded from source in a directory and loads it from there
+        /// next time, skipping the Lua parser
+        /// @param directory Cache directory, created on first use
+        void EnableScriptCache(const Path& directory);
+
+        /// @brief Gets the script cache
+        /// @return The cache, or nullptr if EnableScriptCache hasn't been called
+        ASTERA_KEEP ScriptCache* GetScriptCache() const {
+            return mScriptCache.get();
+        }
+
+        /// @brief Loads a script from source code, going through the script cache when it is enabled
         /// @param source The Lua source code to load
         /// @param scriptId Unique identifier for this script
         /// @param type The type of script being loaded (default: Behavior)
-        void LoadScript(const string& source, ScriptID scriptId, ScriptType type = ScriptType::Behavior);
+        /// @return True if the script loaded and ran
+        bool LoadScript(const string& source, ScriptID scriptId, ScriptType type = ScriptType::Behavior);
 
         /// @brief Loads a script from compiled bytecode
         /// @param bytecode The compiled Lua bytecode to load
         /// @param scriptId Unique identifier for this script
         /// @param type The type of script being loaded (default: Behavior)
-        void LoadScript(const vector<u8>& bytecode, ScriptID scriptId, ScriptType type = ScriptType::Behavior);
+        /// @return True if the script loaded and ran
+        bool LoadScript(const vector<u8>& bytecode, ScriptID scriptId, ScriptType type = ScriptType::Behavior);
+
+        /// @brief Loads a new version of a behavior script in place, keeping the state of its entities
+        ///
+        /// The script runs again in a fresh environment and its callbacks are swapped in the main state and every
+        /// lane, so file-level locals start over. Instance tables stay. A field is set to the new prototype's value if
+        /// the entity doesn't have it yet or still holds the old prototype's value, so edited methods and defaults
+        /// reach live entities while values the entity changed are kept. Table fields are never replaced. Running
+        /// routines finish on the old code, entities spawned from now on start the new Routine. A script that fails to
+        /// load leaves the old version running.
+        /// @param source The new Lua source code
+        /// @param scriptId The script to replace
+        /// @param instances Behavior::instance of every entity running the script
+        /// @return True if the new version loaded
+        bool ReloadScript(const string& source, ScriptID scriptId, std::span<const i32> instances);
+
+        /// @brief Checks whether a behavior script has been loaded
+        ASTERA_KEEP bool HasScript(ScriptID id) const {
+            return mBehaviorScriptContexts.contains(id);
+        }
+
+        /// @brief Gives entities their instance tables, copied from the script's Instance prototype. Tables given back
+        /// by destroyed entities are refilled before new ones are created.
+        /// @param id The script the entities run
+        /// @param outInstances Receives a registry reference per entity, or Behavior::kStateless for every entity if
+        /// the script doesn't declare Instance
+        void CreateInstances(ScriptID id, std::span<i32> outInstances);
+
+        /// @brief Empties the instance tables of behaviors whose entities are gone and pools them for CreateInstances
+        /// @param behaviors Behaviors from SceneState::GetRetiredBehaviors
+        void ReleaseInstances(std::span<const Behavior> behaviors);
 
         /// @brief Calls the OnAwake callback for a behavior script
         /// @param id The script ID to execute
@@ -141,16 +440,100 @@ namespace Astera {
         /// @param clock Reference to the game clock for timing information
         void CallUpdateBehavior(ScriptID id, const BehaviorEntity& entity, const Clock& clock);
 
+        /// @brief Calls the OnFixedUpdate callback for a behavior script
+        /// @param id The script ID to execute
+        /// @param entity The entity associated with this behavior
+        /// @param timeStep Fixed time step in seconds
+        void CallFixedUpdateBehavior(ScriptID id, const BehaviorEntity& entity, f32 timeStep);
+
         /// @brief Calls the OnLateUpdate callback for a behavior script
         /// @param id The script ID to execute
         /// @param entity The entity associated with this behavior
         void CallLateUpdateBehavior(ScriptID id, const BehaviorEntity& entity);
 
+        /// @brief Calls OnUpdateBatch once with every entity of a behavior script, or OnUpdate for each entity when
+        /// the script doesn't define it
+        /// @param id The script ID to execute
+        /// @param batch Entities running this script
+        /// @param clock Reference to the game clock for timing information
+        void CallUpdateBehaviors(ScriptID id, const BehaviorBatch& batch, const Clock& clock);
+
+        /// @brief Calls OnFixedUpdateBatch once with every entity of a behavior script, or OnFixedUpdate for each
+        /// entity when the script doesn't define it
+        /// @param id The script ID to execute
+        /// @param batch Entities running this script
+        /// @param timeStep Fixed time step in seconds
+        void CallFixedUpdateBehaviors(ScriptID id, const BehaviorBatch& batch, f32 timeStep);
+
+        /// @brief Calls OnLateUpdateBatch once with every entity of a behavior script, or OnLateUpdate for each entity
+        /// when the script doesn't define it
+        /// @param id The script ID to execute
+        /// @param batch Entities running this script
+        void CallLateUpdateBehaviors(ScriptID id, const BehaviorBatch& batch);
+
         /// @brief Calls the OnDestroyed callback for a behavior script
         /// @param id The script ID to execute
         /// @param entity The entity associated with this behavior
         void CallDestroyedBehavior(ScriptID id, const BehaviorEntity& entity);
 
+        /// @brief Checks whether a behavior script defines OnCollisionEnter or OnCollisionExit
+        /// @param id The script ID to check
+        /// @return True if either callback exists
+        ASTERA_KEEP bool HasCollisionCallbacks(ScriptID id) const;
+
+        /// @brief Calls the OnCollisionEnter callback once with every contact that began for the script's entities
+        /// @param id The script ID to execute
+        /// @param batch Events gathered for this script
+        void CallCollisionEnterBehavior(ScriptID id, const CollisionEventBatch& batch);
+
+        /// @brief Calls the OnCollisionExit callback once with every contact that ended for the script's entities
+        /// @param id The script ID to execute
+        /// @param batch Events gathered for this script
+        void CallCollisionExitBehavior(ScriptID id, const CollisionEventBatch& batch);
+
+        /// @brief Checks whether any script subscribed to an event type
+        ASTERA_KEEP bool HasEventSubscribers(NameID type) const {
+            return mEventSubscribers.contains(type);
+        }
+
+        /// @brief Adds an event to the batch of every subscription whose filter it passes, see DeliverEvents
+        /// @param event The event
+        /// @param targetName Name of the event's target, empty for events without one
+        /// @param target Behavior of the event's target, or nullptr. Subscribers that run its script get its instance.
+        void QueueEvent(const ScriptEvent& event, NameID targetName, const Behavior* target);
+
+        /// @brief Calls each subscription that was given events by QueueEvent once with all of them
+        void DeliverEvents();
+
+        /// @brief Looks an entity up for a routine that is about to resume
+        /// @return The entity's transform, or nullptr if the entity is gone, inactive or no longer runs this script
+        ///         with this instance, which ends the routine
+        using RoutineResolver = std::function<Transform*(u32 entity, ScriptID script, i32 instance)>;
+
+        /// @brief Checks whether a behavior script defines Routine
+        ASTERA_KEEP bool HasRoutine(ScriptID id) const;
+
+        /// @brief Starts the Routine of each entity in the batch and runs it up to its first wait. An entity that
+        /// already has a routine has it ended first.
+        void StartRoutines(ScriptID id, const BehaviorBatch& batch);
+
+        /// @brief Moves the routine clock on by one frame and resumes every routine whose wait is over. Routines that
+        /// sleep cost nothing here.
+        /// @param clock Frame clock, only its delta time is used
+        /// @param resolve Gives each resumed routine its entity's current transform
+        void ResumeRoutines(const Clock& clock, const RoutineResolver& resolve);
+
+        /// @brief Ends every routine, call before the entities they belong to go away with their scene
+        void StopRoutines();
+
+        /// @brief Wakes the routines waiting on an event on the next ResumeRoutines, scripts call `SignalEvent(name)`
+        void SignalEvent(NameID event);
+
+        /// @brief Gets the number of routines that are running or waiting
+        ASTERA_KEEP u32 GetRoutineCount() const {
+            return CAST<u32>(mEntityRoutines.size());
+        }
+
         /// @brief Executes a Lua script file
         /// @param filename Path to the Lua file to execute
         void ExecuteFile(const Path& filename);
@@ -186,11 +569,176 @@ namespace Astera {
         }
 
     private:
+        static constexpr i32 kGCPause          = 200;  ///< Percent, same meaning as Lua's setpause
+        static constexpr u64 kGCMinThreshold   = 4_MB;
+        static constexpr f32 kGCMaxBudgetScale = 8.f;
+        static constexpr i32 kGCStepSize       = 16;  ///< KB of allocation each lua_gc step pays back
+
         /// @brief Whether the script engine is initialized
         bool mInitialized {false};
+        /// @brief Backs every Lua allocation, declared before mLua so it outlives the state
+        ScriptAllocator mAllocator;
+        /// @brief Whether mLua was created with mAllocator
+        bool mUsesAllocator {false};
         /// @brief The underlying Lua state
         sol::state mLua;
+        /// @brief Times script callbacks, declared after mLua so it can take its hook off the state
+        ScriptProfiler mProfiler;
+        /// @brief Collector time allowed per frame, in milliseconds
+        f32 mGCBudget {1.f};
+        /// @brief Whether a collection cycle is in progress
+        bool mGCCycleActive {false};
+        /// @brief ScriptAllocator::Stats::allocatedBytes as of the last StepGC
+        u64 mGCAllocatedBytes {0};
+        /// @brief ScriptAllocator::Stats::allocatedBytes when the current cycle started
+        u64 mGCCycleAllocatedBytes {0};
+        ScriptGCStats mGCStats;
         /// @brief Map of script IDs to their behavior script contexts
         unordered_map<ScriptID, BehaviorScriptContext> mBehaviorScriptContexts;
+        /// @brief Bytecode cache for scripts loaded from source, null while disabled
+        unique_ptr<ScriptCache> mScriptCache;
+
+        /// @brief Entry of the event type index, pointing at a subscription of a script
+        struct EventSubscriber {
+            ScriptID script {0};
+            u32 subscription {0};  ///< Index in BehaviorScriptContext::subscriptions
+            EventFilter filter;
+            ScriptEventBatch batch;  ///< Events queued for the subscription this frame
+        };
+
+        /// @brief Subscribers of each event type
+        unordered_map<NameID, vector<EventSubscriber>> mEventSubscribers;
+        /// @brief Subscriptions the script being run registers, moved into its context once it loaded
+        vector<EventSubscription> mPendingSubscriptions;
+        /// @brief Script that Subscribe registers handlers for, 0 outside RunScript
+        ScriptID mSubscribingScript {0};
+        /// @brief Whether DeliverEvents is iterating mEventSubscribers
+        bool mDeliveringEvents {false};
+        /// @brief Whether subscriptions changed during DeliverEvents and the index has to be rebuilt after it
+        bool mEventSubscribersDirty {false};
+
+        /// @brief Lua state running isolated scripts for a share of their entities
+        struct ScriptLane {
+            sol::state lua;
+            unordered_map<ScriptID, BehaviorScriptContext> contexts;
+            BehaviorBatch batch;             ///< The lane's share of the batch being dispatched
+            CollisionEventBatch collisions;  ///< The lane's share of the events being dispatched
+        };
+
+        vector<unique_ptr<ScriptLane>> mLanes;
+
+        /// @brief What a routine is waiting for
+        enum class RoutineWait : u8 {
+            None,
+            Frames,
+            Seconds,
+            Event,
+        };
+
+        /// @brief Coroutine running an entity's Routine
+        struct ScriptRoutine {
+            lua_State* thread {nullptr};       ///< Null while the slot is free
+            i32 threadRef {LUA_NOREF};         ///< Keeps the thread alive
+            i32 entityRef {LUA_NOREF};         ///< Keeps the Entity userdata the routine was given alive
+            BehaviorEntity* entity {nullptr};  ///< That userdata, its transform is refreshed before every resume
+            ScriptID script {0};
+            u32 entityId {0};
+            i32 instance {Behavior::kStateless};
+            u32 generation {0};  ///< Bumped when the slot is freed, stale scheduler handles no longer match
+            RoutineWait wait {RoutineWait::None};
+            NameID event;  ///< Event waited on while wait is Event
+        };
+
+        ScriptScheduler mScheduler;
+        vector<ScriptRoutine> mRoutines;
+        vector<u32> mFreeRoutines;
+        unordered_map<u32, u32> mEntityRoutines;  ///< Entity to its routine's slot
+        /// @brief Threads of routines that returned, a finished coroutine can run a new function
+        vector<std::pair<lua_State*, i32>> mFreeThreads;
+        vector<ScriptScheduler::Handle> mDueRoutines;  ///< Scratch for ResumeRoutines
+
+        /// @brief Opens the libraries every script can use
+        static void OpenLibraries(sol::state& lua);
+
+        /// @brief Creates the Lua state on the allocator, or on Lua's default one when the build refuses custom
+        /// allocators like LuaJIT without GC64 does
+        static sol::state CreateState(ScriptAllocator& allocator, bool& usesAllocator);
+
+        /// @brief Memory held by Lua in bytes
+        ASTERA_KEEP u64 GetMemoryBytes();
+
+        /// @brief Loads precompiled bytecode without running it
+        sol::load_result LoadBytecode(const vector<u8>& bytecode, const string& chunkName);
+
+        /// @brief Runs a loaded script in a fresh environment and registers its callbacks
+        /// @return True if the script ran without errors
+        bool RunScript(sol::load_result& chunk, ScriptID scriptId, ScriptType type);
+
+        /// @brief Loads and runs a script that already ran on the main state in every lane, without replacing the
+        /// lanes' current version of it
+        /// @param outContexts Receives the new context of each lane, in lane order
+        /// @return True if it ran without errors everywhere
+        bool LoadIntoLanes(const sol::protected_function& script,
+                           ScriptID scriptId,
+                           vector<BehaviorScriptContext>& outContexts);
+
+        /// @brief Rebuilds mEventSubscribers from the subscriptions of every script, deferred during DeliverEvents
+        void IndexEventSubscribers();
+
+        /// @brief Copies a batch into the subscription's event table and calls its handler with it
+        static void CallEventBehavior(const BehaviorScriptContext& ctx,
+                                      EventSubscription& subscription,
+                                      const ScriptEventBatch& batch);
+
+        /// @brief Resumes a routine with the arguments on its thread's stack, then schedules its wait or ends it
+        void ResumeRoutine(u32 index, i32 argCount);
+
+        /// @brief Ends a routine, its thread is reused if it returned rather than being cut short
+        void EndRoutine(u32 index, bool finished);
+
+        /// @brief Finds the context that runs a script for an entity, in the entity's lane for isolated scripts
+        /// @param instance The entity's Behavior::instance
+        /// @return The context, or nullptr if the script isn't loaded
+        BehaviorScriptContext* FindContext(ScriptID id, i32 instance);
+
+        /// @brief Gives an instance table the fields of a reloaded prototype, see ReloadScript
+        static void RefreshInstance(lua_State* L, i32 ref, const sol::table& oldPrototype, const sol::table& prototype);
+
+        /// @brief Fills instance tables from the context's prototype in the context's own Lua state
+        /// @param outRefs Receives a registry reference per table
+        static void FillInstances(BehaviorScriptContext& ctx, std::span<i32> outRefs);
+
+        /// @brief Calls a per-entity callback, as a method of the entity's instance table when the script has one
+        template<typename... Args>
+        static sol::protected_function_result CallEntity(const BehaviorScriptContext& ctx,
+                                                         const sol::protected_function& callback,
+                                                         const BehaviorEntity& entity,
+                                                         const Args&... args);
+
+        /// @brief Splits a batch of an isolated script by lane and calls each lane's share in parallel
+        template<typename... Args>
+        void CallIsolatedBehaviors(ScriptID id,
+                                   sol::protected_function BehaviorScriptContext::*perEntity,
+                                   sol::protected_function BehaviorScriptContext::*batched,
+                                   const BehaviorBatch& batch,
+                                   const Args&... args);
+
+        /// @brief Splits collision events of an isolated script by lane and calls each lane's share in turn
+        void CallIsolatedCollisions(ScriptID id,
+                                    sol::protected_function BehaviorScriptContext::*callback,
+                                    const CollisionEventBatch& batch);
+
+        /// @brief Calls the batch callback with every entity of the batch, or the per-entity callback for each one
+        template<typename... Args>
+        static void CallBehaviors(BehaviorScriptContext& ctx,
+                                  const sol::protected_function& perEntity,
+                                  const sol::protected_function& batched,
+                                  const BehaviorBatch& batch,
+                                  const Args&... args);
+
+        /// @brief Copies a batch into the context's event table and calls the given callback with it
+        static void CallCollisionBehavior(BehaviorScriptContext& ctx,
+                                          const sol::protected_function& callback,
+                                          const CollisionEventBatch& batch);
     };
 }  // namespace Astera
\ No newline at end of file
@@ -0,0 +1,120 @@
+/*
+ *  Filename: ScriptFFI.cpp
+ *  This code is part of the Astera core library
+ *  Copyright 2025 Jake Rieger
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ScriptFFI.hpp"
+#include "Log.hpp"
+#include "Components/Transform.hpp"
+
+namespace Astera {
+    // The cdefs below mirror these layouts
+    static_assert(sizeof(Vec2) == 2 * sizeof(f32) && offsetof(Vec2, y) == sizeof(f32));
+    static_assert(std::is_standard_layout_v<Transform> && sizeof(Transform) == 3 * sizeof(Vec2));
+    static_assert(offsetof(Transform, rotation) == sizeof(Vec2) && offsetof(Transform, scale) == 2 * sizeof(Vec2));
+
+    /// @brief Builds the `FFI` global, run with the ffi library as its only argument
+    static constexpr auto kBindings = R"lua(
+local ffi = ...
+
+ffi.cdef[[
+typedef struct { float x, y; } AsteraVec2;
+typedef struct { AsteraVec2 position, rotation, scale; } AsteraTransform;
+]]
+
+local Vec2              = ffi.typeof("AsteraVec2")
+local TransformPtr      = ffi.typeof("AsteraTransform*")
+local TransformPtrArray = ffi.typeof("AsteraTransform**")
+local sqrt              = math.sqrt
+
+ffi.metatype(Vec2, {
+    __add = function(a, b) return Vec2(a.x + b.x, a.y + b.y) end,
+    __sub = function(a, b) return Vec2(a.x - b.x, a.y - b.y) end,
+    __mul = function(a, b)
+        if type(a) == "number" then return Vec2(a * b.x, a * b.y) end
+        if type(b) == "number" then return Vec2(a.x * b, a.y * b) end
+        return Vec2(a.x * b.x, a.y * b.y)
+    end,
+    __unm = function(a) return Vec2(-a.x, -a.y) end,
+    __tostring = function(a) return string.format("Vec2(%g, %g)", a.x, a.y) end,
+    __index = {
+        Length = function(a) return sqrt(a.x * a.x + a.y * a.y) end,
+    },
+})
+
+ffi.metatype("AsteraTransform", {
+    __index = {
+        Translate = function(t, delta)
+            local position = t.position
+            position.x     = position.x + delta.x
+            position.y     = position.y + delta.y
+        end,
+        Rotate = function(t, angle)
+            t.rotation.x = t.rotation.x + angle
+        end,
+        Scale = function(t, factor)
+            local scale = t.scale
+            scale.x     = scale.x * factor.x
+            scale.y     = scale.y * factor.y
+        end,
+    },
+})
+
+-- Vec2 is the ctype itself, a Lua wrapper around it gets blacklisted by the JIT when it is called a lot from
+-- interpreted code and then drags every trace that calls it down with it
+FFI = {
+    Vec2 = Vec2,
+    Transform = function(_, entity) return ffi.cast(TransformPtr, entity.transformPointer) end,
+    Transforms = function(_, entities) return ffi.cast(TransformPtrArray, entities.transforms) end,
+}
+)lua";
+
+    bool ScriptFFI::IsAvailable(sol::state& lua) {
+        return lua["FFI"].get_type() == sol::type::table;
+    }
+
+    void ScriptFFI::RegisterLuaGlobals(sol::state& lua) {
+        const sol::object ffi = lua["ffi"];
+        if (ffi.get_type() != sol::type::table) {
+            Log::Warn("ScriptFFI", "LuaJIT FFI is not available, scripts only get the usertype bindings");
+            return;
+        }
+
+        sol::load_result bindings = lua.load(kBindings, "=ScriptFFI");
+        if (!bindings.valid()) {
+            const sol::error error = bindings;
+            Log::Error("ScriptFFI", "Failed to load FFI bindings: {}", error.what());
+            return;
+        }
+
+        if (const auto result = bindings(ffi); !result.valid()) {
+            const sol::error error = result;
+            Log::Error("ScriptFFI", "Failed to register FFI bindings: {}", error.what());
+        }
+
+        lua["ffi"] = sol::lua_nil;
+    }
+}  // namespace Astera
@@ -0,0 +1,54 @@
+/*
+ *  Filename: ScriptFFI.hpp
+ *  This code is part of the Astera core library
+ *  Copyright 2025 Jake Rieger
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include "EngineCommon.hpp"
+#include "Vendor/sol/sol.hpp"
+
+namespace Astera {
+    /// @brief LuaJIT FFI bindings for the hottest component data
+    ///
+    /// Exposes Transform and Vec2 to scripts as FFI structs that point straight into component storage, so reading or
+    /// writing a field compiles down to a plain load or store and temporary vectors don't allocate once a loop is
+    /// compiled. The usertype bindings stay available for everything else.
+    ///
+    /// The `ffi` library itself is hidden from scripts since it can read and write any memory.
+    class ScriptFFI {
+    public:
+        ScriptFFI() = delete;
+
+        /// @brief Checks whether the FFI bindings were registered, they need LuaJIT
+        ASTERA_KEEP static bool IsAvailable(sol::state& lua);
+
+    private:
+        friend class Game;
+
+        static void RegisterLuaGlobals(sol::state& lua);
+    };
+}  // namespace Astera
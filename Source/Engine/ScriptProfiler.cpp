@@ -0,0 +1,307 @@
+/*
+ *  Filename: ScriptProfiler.cpp
+ *  This code is part of the Astera core library
+ *  Copyright 2025 Jake Rieger
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ScriptProfiler.hpp"
+#include "IO.hpp"
+#include "Log.hpp"
+
+#include <algorithm>
+
+extern "C" {
+#include <lua.h>
+#include <luajit.h>
+}
+
+namespace Astera {
+    /// @brief Profiler the count hook reports to, hooks don't carry user data
+    static ScriptProfiler* gSamplingProfiler {nullptr};
+
+    /// @brief Escapes a string for use inside a JSON string literal
+    static string EscapeJson(const std::string_view text) {
+        string escaped;
+        escaped.reserve(text.size());
+        for (const char c : text) {
+            switch (c) {
+                case '"':
+                    escaped += "\\\"";
+                    break;
+                case '\\':
+                    escaped += "\\\\";
+                    break;
+                case '\n':
+                    escaped += "\\n";
+                    break;
+                case '\r':
+                    escaped += "\\r";
+                    break;
+                case '\t':
+                    escaped += "\\t";
+                    break;
+                default:
+                    if (CAST<u8>(c) < 0x20) {
+                        fmt::format_to(std::back_inserter(escaped), "\\u{:04x}", CAST<u8>(c));
+                    } else {
+                        escaped += c;
+                    }
+            }
+        }
+        return escaped;
+    }
+
+    const char* ToString(const ScriptCallback callback) {
+        switch (callback) {
+            case ScriptCallback::Load:
+                return "Load";
+            case ScriptCallback::Awake:
+                return "OnAwake";
+            case ScriptCallback::Update:
+                return "OnUpdate";
+            case ScriptCallback::FixedUpdate:
+                return "OnFixedUpdate";
+            case ScriptCallback::LateUpdate:
+                return "OnLateUpdate";
+            case ScriptCallback::Destroyed:
+                return "OnDestroyed";
+            case ScriptCallback::CollisionEnter:
+                return "OnCollisionEnter";
+            case ScriptCallback::CollisionExit:
+                return "OnCollisionExit";
+            case ScriptCallback::Routine:
+                return "Routine";
+            case ScriptCallback::Event:
+                return "Event";
+            default:
+                return "Unknown";
+        }
+    }
+
+    ScriptProfiler::~ScriptProfiler() {
+        StopSampling();
+    }
+
+    void ScriptProfiler::Attach(lua_State* L, const ScriptAllocator* allocator) {
+        mLua       = L;
+        mAllocator = allocator;
+    }
+
+    void ScriptProfiler::SetNameResolver(std::function<string(u64)> resolver) {
+        mNameResolver = std::move(resolver);
+        mNames.clear();
+    }
+
+    const string& ScriptProfiler::GetScriptName(const u64 script) {
+        if (const auto it = mNames.find(script); it != mNames.end()) return it->second;
+
+        string name = mNameResolver ? mNameResolver(script) : string {};
+        if (name.empty()) { name = fmt::format("{:016x}", script); }
+        return mNames.emplace(script, std::move(name)).first->second;
+    }
+
+    void ScriptProfiler::SetEnabled(const bool enabled) {
+        // Scopes that are open still close through End, so the switch waits for them
+        if (!mOpenScopes.empty()) {
+            mPendingEnabled = enabled;
+            return;
+        }
+
+        mPendingEnabled.reset();
+        mEnabled = enabled;
+        if (!enabled) { mCapturing = false; }
+    }
+
+    void ScriptProfiler::NextFrame() {
+        if (mEnabled) { ++mFrames; }
+    }
+
+    void ScriptProfiler::Reset() {
+        // Open scopes point into mEntries
+        if (!mOpenScopes.empty()) {
+            mPendingReset = true;
+            return;
+        }
+
+        mPendingReset = false;
+        mEntries.clear();
+        mEntryIndices.clear();
+        mSamples.clear();
+        mFrames = 0;
+    }
+
+    void ScriptProfiler::StartSampling(const i32 instructions) {
+        if (!mLua || mSampling) return;
+        if (gSamplingProfiler) {
+            Log::Warn("ScriptProfiler", "Another profiler is already sampling");
+            return;
+        }
+
+        gSamplingProfiler = this;
+        mSampling         = true;
+        luaJIT_setmode(mLua, 0, LUAJIT_MODE_ENGINE | LUAJIT_MODE_FLUSH);
+        luaJIT_setmode(mLua, 0, LUAJIT_MODE_ENGINE | LUAJIT_MODE_OFF);
+        lua_sethook(mLua, SampleHook, LUA_MASKCOUNT, std::max(instructions, 1));
+    }
+
+    void ScriptProfiler::StopSampling() {
+        if (!mSampling) return;
+
+        lua_sethook(mLua, nullptr, 0, 0);
+        luaJIT_setmode(mLua, 0, LUAJIT_MODE_ENGINE | LUAJIT_MODE_ON);
+        gSamplingProfiler = nullptr;
+        mSampling         = false;
+    }
+
+    vector<ScriptProfiler::Sample> ScriptProfiler::GetSamples() const {
+        vector<Sample> samples;
+        samples.reserve(mSamples.size());
+        for (const auto& sample : mSamples | std::views::values) {
+            samples.push_back(sample);
+        }
+        std::ranges::sort(samples, std::greater {}, &Sample::count);
+        return samples;
+    }
+
+    void ScriptProfiler::StartCapture(const u32 maxEvents) {
+        mEvents.clear();
+        mEvents.reserve(std::min<u32>(maxEvents, 64 * 1024));
+        mMaxEvents    = maxEvents;
+        mCaptureStart = std::chrono::steady_clock::now();
+        mCapturing    = true;
+        SetEnabled(true);
+    }
+
+    void ScriptProfiler::StopCapture() {
+        mCapturing = false;
+    }
+
+    bool ScriptProfiler::WriteTrace(const Path& filename) {
+        string json;
+        json.reserve(mEvents.size() * 128 + 64);
+        json += R"({"displayTimeUnit":"ns","traceEvents":[)";
+        for (size_t i = 0; i < mEvents.size(); ++i) {
+            const auto& event = mEvents[i];
+            // Trace timestamps are microseconds, fractions keep the nanoseconds
+            fmt::format_to(std::back_inserter(json),
+                           R"({}{{"name":"{}","cat":"{}","ph":"X","pid":1,"tid":1,"ts":{:.3f},"dur":{:.3f},)"
+                           R"("args":{{"depth":{},"allocatedBytes":{}}}}})",
+                           i > 0 ? "," : "",
+                           ToString(event.callback),
+                           EscapeJson(GetScriptName(event.script)),
+                           CAST<f64>(event.startNs) / 1000.0,
+                           CAST<f64>(event.durationNs) / 1000.0,
+                           event.depth,
+                           event.allocatedBytes);
+        }
+        json += "]}";
+
+        if (filename.has_parent_path()) {
+            std::error_code ec;
+            fs::create_directories(filename.parent_path(), ec);
+        }
+
+        if (!IO::WriteText(filename, json)) {
+            Log::Error("ScriptProfiler", "Failed to write trace to `{}`", filename.string());
+            return false;
+        }
+
+        Log::Info("ScriptProfiler", "Wrote {} script events to `{}`", mEvents.size(), filename.string());
+        return true;
+    }
+
+    void ScriptProfiler::Begin(const u64 script, const ScriptCallback callback, const u64 calls) {
+        auto [it, inserted] = mEntryIndices.try_emplace(script);
+        if (inserted) { it->second.fill(UINT32_MAX); }
+
+        u32& index = it->second[CAST<size_t>(callback)];
+        if (index == UINT32_MAX) {
+            index = CAST<u32>(mEntries.size());
+            mEntries.push_back({script, callback});
+        }
+
+        mEntries[index].calls += calls;
+        mOpenScopes.push_back({index, std::chrono::steady_clock::now(), GetAllocatedBytes()});
+    }
+
+    void ScriptProfiler::End() {
+        const TimePoint end = std::chrono::steady_clock::now();
+        const OpenScope scope = mOpenScopes.back();
+        mOpenScopes.pop_back();
+
+        const auto elapsed = CAST<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - scope.start).count());
+        const u64 bytes    = GetAllocatedBytes() - scope.startBytes;
+
+        auto& entry = mEntries[scope.entry];
+        entry.totalNs += elapsed;
+        entry.selfNs += elapsed - std::min(scope.childNs, elapsed);
+        entry.allocatedBytes += bytes - std::min(scope.childBytes, bytes);
+
+        if (!mOpenScopes.empty()) {
+            mOpenScopes.back().childNs += elapsed;
+            mOpenScopes.back().childBytes += bytes;
+        }
+
+        if (mCapturing) {
+            if (mEvents.size() >= mMaxEvents) {
+                Log::Warn("ScriptProfiler", "Capture is full at {} events, stopping it", mEvents.size());
+                mCapturing = false;
+            } else {
+                const auto start =
+                  CAST<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(scope.start - mCaptureStart).count());
+                mEvents.push_back({entry.script, entry.callback, CAST<u32>(mOpenScopes.size()), start, elapsed, bytes});
+            }
+        }
+
+        if (mOpenScopes.empty()) { ApplyPending(); }
+    }
+
+    void ScriptProfiler::ApplyPending() {
+        if (mPendingReset) { Reset(); }
+        if (mPendingEnabled) { SetEnabled(*mPendingEnabled); }
+    }
+
+    u64 ScriptProfiler::GetAllocatedBytes() const {
+        return mAllocator ? mAllocator->GetStats().allocatedBytes : 0;
+    }
+
+    size_t ScriptProfiler::SampleKeyHash::operator()(const SampleKey& key) const noexcept {
+        const size_t hash = std::hash<const void*> {}(key.source) ^ (std::hash<i32> {}(key.line) << 1);
+        return hash ^ (std::hash<u64> {}(key.script) << 2);
+    }
+
+    void ScriptProfiler::SampleHook(lua_State* L, lua_Debug* ar) {
+        ScriptProfiler* profiler = gSamplingProfiler;
+        if (!profiler || !lua_getinfo(L, "Sln", ar)) return;
+
+        const u64 script =
+          profiler->mOpenScopes.empty() ? 0 : profiler->mEntries[profiler->mOpenScopes.back().entry].script;
+        auto& sample = profiler->mSamples[{ar->source, ar->currentline, script}];
+        if (sample.count++ == 0) {
+            sample.script   = script;
+            sample.location = fmt::format("{}:{} ({})", ar->short_src, ar->currentline, ar->name ? ar->name : "?");
+        }
+    }
+}  // namespace Astera
@@ -0,0 +1,244 @@
+/*
+ *  Filename: ScriptProfiler.hpp
+ *  This code is part of the Astera core library
+ *  Copyright 2025 Jake Rieger
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include "EngineCommon.hpp"
+#include "ScriptAllocator.hpp"
+
+#include <array>
+#include <chrono>
+#include <functional>
+#include <span>
+
+struct lua_State;
+struct lua_Debug;
+
+namespace Astera {
+    /// @brief Engine callbacks the profiler tells apart
+    enum class ScriptCallback : u8 {
+        Load,
+        Awake,
+        Update,
+        FixedUpdate,
+        LateUpdate,
+        Destroyed,
+        CollisionEnter,
+        CollisionExit,
+        Routine,
+        Event,
+        Count,
+    };
+
+    ASTERA_KEEP const char* ToString(ScriptCallback callback);
+
+    /// @brief Times the calls the engine makes into scripts
+    ///
+    /// Every call into a script opens a Scope, which costs a branch while the profiler is disabled. While enabled it
+    /// records calls, total time, self time and bytes allocated per script and callback. Self time leaves out nested
+    /// scopes, like routines started from a callback. Batched callbacks count one call per batch, per-entity ones
+    /// count one per entity. Isolated scripts are timed as a whole on the main thread, their lanes don't allocate
+    /// through ScriptAllocator so they report no bytes.
+    ///
+    /// Sampling is a separate, heavier mode: a count hook records the function and line running every N Lua
+    /// instructions. LuaJIT doesn't run hooks inside compiled code, so the JIT is switched off while sampling to keep
+    /// hot loops from going unsampled. Timings taken at the same time are interpreter timings.
+    ///
+    /// Only use from the main thread.
+    class ScriptProfiler {
+    public:
+        struct Entry {
+            u64 script {0};
+            ScriptCallback callback {ScriptCallback::Load};
+            u64 calls {0};
+            u64 totalNs {0};
+            u64 selfNs {0};
+            u64 allocatedBytes {0};  ///< Allocated by the callback itself, not by nested scopes
+        };
+
+        struct Sample {
+            u64 script {0};  ///< Script whose scope was open, 0 if none was
+            string location;  ///< `chunk:line (function)`
+            u64 count {0};
+        };
+
+        /// @brief Times a call into a script for as long as it is alive, scopes without calls aren't recorded
+        class Scope {
+        public:
+            Scope(ScriptProfiler& profiler, u64 script, ScriptCallback callback, u64 calls = 1)
+                : mProfiler(profiler.mEnabled && calls > 0 ? &profiler : nullptr) {
+                if (mProfiler) { mProfiler->Begin(script, callback, calls); }
+            }
+
+            ~Scope() {
+                if (mProfiler) { mProfiler->End(); }
+            }
+
+            ASTERA_CLASS_PREVENT_MOVES_COPIES(Scope)
+
+        private:
+            ScriptProfiler* mProfiler;
+        };
+
+        /// @brief Default number of events a capture keeps before it stops recording
+        static constexpr u32 kDefaultCaptureEvents = 1'000'000;
+
+        ScriptProfiler() = default;
+        ~ScriptProfiler();
+
+        ASTERA_CLASS_PREVENT_MOVES_COPIES(ScriptProfiler)
+
+        /// @brief Gives the profiler the state to sample and the allocator to count bytes with
+        /// @param allocator Allocator of the state, or nullptr when Lua uses its own
+        void Attach(lua_State* L, const ScriptAllocator* allocator);
+
+        /// @brief Turns a script ID into the name shown in the overlay and traces, IDs are shown in hex without one
+        void SetNameResolver(std::function<string(u64)> resolver);
+
+        /// @brief Looks up a script's name, resolved once and cached
+        const string& GetScriptName(u64 script);
+
+        /// @brief Turns the profiler on or off. Called from inside a script call, the change waits until the
+        /// outermost scope closes so no scope is left half-recorded.
+        void SetEnabled(bool enabled);
+
+        /// @brief Whether the profiler is on, or will be once the open scopes close
+        ASTERA_KEEP bool IsEnabled() const {
+            return mPendingEnabled.value_or(mEnabled);
+        }
+
+        /// @brief Counts a frame, entries are usually read as averages per frame
+        void NextFrame();
+
+        /// @brief Drops every entry and sample and restarts the frame count. Captured events keep their labels. Called
+        /// from inside a script call, the reset waits until the outermost scope closes.
+        void Reset();
+
+        ASTERA_KEEP std::span<const Entry> GetEntries() const {
+            return mEntries;
+        }
+
+        ASTERA_KEEP u64 GetFrameCount() const {
+            return mFrames;
+        }
+
+        /// @brief Starts recording where the running function is every `instructions` Lua instructions
+        void StartSampling(i32 instructions);
+
+        void StopSampling();
+
+        ASTERA_KEEP bool IsSampling() const {
+            return mSampling;
+        }
+
+        /// @brief Gets the samples taken so far, most frequent first
+        vector<Sample> GetSamples() const;
+
+        /// @brief Records every scope from now on, up to `maxEvents`, for WriteTrace. Enables the profiler.
+        void StartCapture(u32 maxEvents = kDefaultCaptureEvents);
+
+        void StopCapture();
+
+        ASTERA_KEEP bool IsCapturing() const {
+            return mCapturing;
+        }
+
+        ASTERA_KEEP size_t GetCapturedEventCount() const {
+            return mEvents.size();
+        }
+
+        /// @brief Writes the captured scopes in the Chrome trace event format, readable by chrome://tracing and
+        /// Perfetto
+        /// @return False if the file couldn't be written
+        bool WriteTrace(const Path& filename);
+
+    private:
+        using TimePoint = std::chrono::steady_clock::time_point;
+
+        struct OpenScope {
+            u32 entry;
+            TimePoint start;
+            u64 startBytes;
+            u64 childNs {0};
+            u64 childBytes {0};
+        };
+
+        /// @brief Labelled by script and callback rather than entry, so a Reset during a capture can't relabel it
+        struct TraceEvent {
+            u64 script;
+            ScriptCallback callback;
+            u32 depth;
+            u64 startNs;  ///< Since the capture started
+            u64 durationNs;
+            u64 allocatedBytes;
+        };
+
+        struct SampleKey {
+            const void* source;  ///< Chunk name, interned by Lua so the pointer identifies it
+            i32 line;
+            u64 script;
+
+            bool operator==(const SampleKey&) const = default;
+        };
+
+        struct SampleKeyHash {
+            size_t operator()(const SampleKey& key) const noexcept;
+        };
+
+        bool mEnabled {false};
+        /// @brief SetEnabled and Reset calls made while scopes were open, applied once they have closed
+        optional<bool> mPendingEnabled;
+        bool mPendingReset {false};
+        lua_State* mLua {nullptr};
+        const ScriptAllocator* mAllocator {nullptr};
+
+        vector<Entry> mEntries;
+        /// @brief Index in mEntries of each callback of a script, UINT32_MAX for callbacks that weren't called
+        unordered_map<u64, std::array<u32, CAST<size_t>(ScriptCallback::Count)>> mEntryIndices;
+        vector<OpenScope> mOpenScopes;
+        u64 mFrames {0};
+
+        std::function<string(u64)> mNameResolver;
+        unordered_map<u64, string> mNames;
+
+        bool mSampling {false};
+        unordered_map<SampleKey, Sample, SampleKeyHash> mSamples;
+
+        bool mCapturing {false};
+        u32 mMaxEvents {0};
+        TimePoint mCaptureStart;
+        vector<TraceEvent> mEvents;
+
+        void Begin(u64 script, ScriptCallback callback, u64 calls);
+        void End();
+        void ApplyPending();
+        u64 GetAllocatedBytes() const;
+
+        static void SampleHook(lua_State* L, lua_Debug* ar);
+    };
+}  // namespace Astera
@@ -0,0 +1,124 @@
+/*
+ *  Filename: ScriptScheduler.cpp
+ *  This code is part of the Astera core library
+ *  Copyright 2025 Jake Rieger
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ScriptScheduler.hpp"
+
+#include <cmath>
+
+namespace Astera {
+    /// @brief Fraction of a tick ignored when turning seconds into ticks. Frame times summed in floating point land a
+    /// hair either side of whole ticks, without this a wait would regularly end a frame late.
+    static constexpr f64 kTickTolerance = 1e-6;
+
+    void ScriptScheduler::WaitFrames(const Handle routine, const u64 frames) {
+        mFrames.Schedule(routine, mFrames.GetTick() + std::max<u64>(frames, 1));
+    }
+
+    void ScriptScheduler::WaitSeconds(const Handle routine, const f64 seconds) {
+        // Rounded up so a wait never ends early, an advance ends it once its floored tick reaches this one
+        const f64 endTime = mSeconds + std::max(seconds, 0.0);
+        mTime.Schedule(routine, CAST<u64>(std::ceil(endTime * kTicksPerSecond - kTickTolerance)));
+    }
+
+    void ScriptScheduler::WaitEvent(const Handle routine, const NameID event) {
+        mEventWaits[event].push_back(routine);
+    }
+
+    void ScriptScheduler::CancelEvent(const Handle routine, const NameID event) {
+        const auto it = mEventWaits.find(event);
+        if (it == mEventWaits.end()) return;
+
+        auto& waits = it->second;
+        for (size_t i = 0; i < waits.size(); ++i) {
+            if (waits[i].index == routine.index && waits[i].generation == routine.generation) {
+                waits[i] = waits.back();
+                waits.pop_back();
+                return;
+            }
+        }
+    }
+
+    void ScriptScheduler::Signal(const NameID event) {
+        if (const auto it = mEventWaits.find(event); it != mEventWaits.end() && !it->second.empty()) {
+            mSignalled.push_back(event);
+        }
+    }
+
+    void ScriptScheduler::Advance(const f64 deltaTime, vector<Handle>& outDue) {
+        mSeconds += deltaTime;
+        mFrames.Advance(mFrames.GetTick() + 1, outDue);
+        mTime.Advance(CAST<u64>(std::floor(mSeconds * kTicksPerSecond + kTickTolerance)), outDue);
+
+        // Waits added by routines woken here belong to the next advance, the lists are taken before any run
+        for (const NameID event : mSignalled) {
+            if (const auto it = mEventWaits.find(event); it != mEventWaits.end()) {
+                outDue.insert(outDue.end(), it->second.begin(), it->second.end());
+                it->second.clear();
+            }
+        }
+        mSignalled.clear();
+    }
+
+    void ScriptScheduler::Clear() {
+        mFrames.Clear();
+        mTime.Clear();
+        mEventWaits.clear();
+        mSignalled.clear();
+    }
+
+    void ScriptScheduler::TimerWheel::Schedule(const Handle routine, u64 dueTick) {
+        dueTick = std::max(dueTick, mTick + 1);
+        mSlots[dueTick % kSlotCount].push_back({routine, dueTick});
+    }
+
+    void ScriptScheduler::TimerWheel::Advance(const u64 tick, vector<Handle>& outDue) {
+        if (tick <= mTick) return;
+
+        // A long frame may pass more than one turn of the ring, every slot is then visited once
+        const u64 first = tick - mTick > kSlotCount ? tick - kSlotCount + 1 : mTick + 1;
+        for (u64 current = first; current <= tick; ++current) {
+            auto& slot = mSlots[current % kSlotCount];
+            for (size_t i = 0; i < slot.size();) {
+                if (slot[i].dueTick <= tick) {
+                    outDue.push_back(slot[i].routine);
+                    slot[i] = slot.back();
+                    slot.pop_back();
+                } else {
+                    ++i;
+                }
+            }
+        }
+        mTick = tick;
+    }
+
+    void ScriptScheduler::TimerWheel::Clear() {
+        for (auto& slot : mSlots) {
+            slot.clear();
+        }
+    }
+}  // namespace Astera
@@ -0,0 +1,115 @@
+/*
+ *  Filename: ScriptScheduler.hpp
+ *  This code is part of the Astera core library
+ *  Copyright 2025 Jake Rieger
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include "EngineCommon.hpp"
+#include "NameID.hpp"
+
+namespace Astera {
+    /// @brief Keeps track of what each waiting script routine waits for and says when the wait is over
+    ///
+    /// Waits on a frame count or a duration go into a timer wheel: a ring of slots indexed by the tick a wait ends
+    /// on. Advancing only visits the slots of the ticks that passed since the last advance, so the cost of a frame
+    /// follows the number of routines that wake up rather than the number that sleep. Waits further out than one turn
+    /// of the ring stay in their slot until their turn comes around. Waits on an event are kept per event until it's
+    /// signalled.
+    ///
+    /// The scheduler only deals in handles, routines that ended while waiting are filtered out by their owner.
+    class ScriptScheduler {
+    public:
+        /// @brief Routine slot and the generation it had when the wait began
+        struct Handle {
+            u32 index;
+            u32 generation;
+        };
+
+        /// @brief Resolution of WaitSeconds, waits end on the first advance at or after their end time
+        static constexpr u32 kTicksPerSecond = 1000;
+
+        ScriptScheduler() = default;
+
+        ASTERA_CLASS_PREVENT_MOVES_COPIES(ScriptScheduler)
+
+        /// @brief Wakes a routine once `frames` more advances have happened, at least one
+        void WaitFrames(Handle routine, u64 frames);
+
+        /// @brief Wakes a routine on the first advance that is at least `seconds` later than the last one
+        void WaitSeconds(Handle routine, f64 seconds);
+
+        /// @brief Wakes a routine on the first advance after `event` is signalled
+        void WaitEvent(Handle routine, NameID event);
+
+        /// @brief Drops a routine that waits on an event, frame and time waits are filtered when they end instead
+        void CancelEvent(Handle routine, NameID event);
+
+        /// @brief Wakes every routine waiting on an event on the next advance
+        void Signal(NameID event);
+
+        /// @brief Moves on by one frame and `deltaTime` seconds
+        /// @param outDue Receives the routines whose wait is over, in no particular order
+        void Advance(f64 deltaTime, vector<Handle>& outDue);
+
+        /// @brief Drops every wait
+        void Clear();
+
+    private:
+        /// @brief Ring of slots holding the waits that end on each tick
+        class TimerWheel {
+        public:
+            static constexpr u64 kSlotCount = 1024;
+
+            /// @brief Adds a wait ending on `dueTick`, ticks that already passed end on the next one
+            void Schedule(Handle routine, u64 dueTick);
+
+            /// @brief Visits every tick up to `tick` and hands out the waits that ended
+            void Advance(u64 tick, vector<Handle>& outDue);
+
+            ASTERA_KEEP u64 GetTick() const {
+                return mTick;
+            }
+
+            void Clear();
+
+        private:
+            struct Entry {
+                Handle routine;
+                u64 dueTick;
+            };
+
+            std::array<vector<Entry>, kSlotCount> mSlots;
+            u64 mTick {0};  ///< Last tick visited
+        };
+
+        TimerWheel mFrames;
+        TimerWheel mTime;
+        f64 mSeconds {0.0};  ///< Seconds since creation, summed from Advance
+        unordered_map<NameID, vector<Handle>> mEventWaits;
+        vector<NameID> mSignalled;
+    };
+}  // namespace Astera
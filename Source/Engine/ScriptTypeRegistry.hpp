@@ -32,13 +32,15 @@
 #include "ScriptEngine.hpp"
 
 namespace Astera {
+    /// @brief Entity handed to behavior callbacks, trivially copyable so passing it to Lua never allocates
     struct BehaviorEntity {
         u32 id;
-        string name;
+        NameID name;
         Transform* transform;
+        i32 instance;  ///< Behavior::instance, handed to the script's Instance methods as self
 
-        explicit BehaviorEntity(u32 id, const string& name, Transform* transform)
-            : id(id), name(name), transform(transform) {}
+        explicit BehaviorEntity(u32 id, NameID name, Transform* transform, i32 instance = Behavior::kStateless)
+            : id(id), name(name), transform(transform), instance(instance) {}
     };
 
     template<>
@@ -46,8 +48,16 @@ namespace Astera {
         static constexpr std::string_view typeName = "Entity";
 
         static void RegisterMembers(sol::usertype<BehaviorEntity>& usertype) {
-            usertype["name"]      = &BehaviorEntity::name;
+            usertype["id"]        = sol::readonly(&BehaviorEntity::id);
+            usertype["name"]      = sol::readonly_property([](const BehaviorEntity& entity) -> const string& {
+                return entity.name.ToString();
+            });
             usertype["transform"] = &BehaviorEntity::transform;
+
+            // Raw address for FFI:Transform
+            usertype["transformPointer"] = sol::readonly_property([](const BehaviorEntity& entity) -> void* {
+                return entity.transform;
+            });
         }
     };
 
@@ -90,30 +100,71 @@ namespace Astera {
         }
     };
 
+    template<>
+    struct LuaTypeTraits<Rigidbody2D> {
+        static constexpr std::string_view typeName = "Rigidbody2D";
+
+        static void RegisterMembers(sol::usertype<Rigidbody2D>& usertype) {
+            usertype["velocity"]        = &Rigidbody2D::velocity;
+            usertype["angularVelocity"] = &Rigidbody2D::angularVelocity;
+            usertype["gravityScale"]    = &Rigidbody2D::gravityScale;
+            usertype["mass"]            = sol::readonly(&Rigidbody2D::mass);
+            usertype["allowSleep"]      = &Rigidbody2D::allowSleep;
+            usertype["awake"]           = sol::readonly(&Rigidbody2D::awake);
+            usertype["bullet"]          = &Rigidbody2D::bullet;
+            usertype["UpdateMass"]      = &Rigidbody2D::UpdateMass;
+            usertype["ApplyForce"]      = &Rigidbody2D::ApplyForce;
+            usertype["ApplyImpulse"]    = &Rigidbody2D::ApplyImpulse;
+            usertype["ApplyTorque"]     = &Rigidbody2D::ApplyTorque;
+            usertype["WakeUp"]          = &Rigidbody2D::WakeUp;
+        }
+    };
+
     template<>
     struct LuaTypeTraits<SceneState> {
         static constexpr std::string_view typeName = "SceneState";
 
         static void RegisterMembers(sol::usertype<SceneState>& usertype) {
-            usertype["FindEntityByName"] = [](SceneState& scene, const string& name) -> sol::optional<Entity> {
-                const auto view = scene.View<Transform>();
-                for (auto entity : view) {
-                    if (scene.GetEntityName(entity) == name) { return entity; }
-                }
-                return sol::nullopt;
+            usertype["FindEntityByName"] = [](SceneState& scene, std::string_view name) -> sol::optional<Entity> {
+                const Entity entity = scene.FindEntityByName(name);
+                if (entity == entt::null) return sol::nullopt;
+                return entity;
             };
 
             usertype["GetEntityTransform"] = [](SceneState& scene, Entity entity) -> Transform* {
                 auto& transform = scene.GetTransform(entity);
                 return &transform;
             };
+
+            usertype["GetEntityRigidbody"] = [](SceneState& scene, Entity entity) -> Rigidbody2D* {
+                return scene.TryGetComponent<Rigidbody2D>(entity);
+            };
+
+            usertype["SetParent"] = [](SceneState& scene, Entity child, sol::optional<Entity> parent) -> bool {
+                return scene.SetParent(child, parent.value_or(entt::null));
+            };
+
+            usertype["GetParent"] = [](SceneState& scene, Entity entity) -> sol::optional<Entity> {
+                const Entity parent = scene.GetParent(entity);
+                if (parent == entt::null) return sol::nullopt;
+                return parent;
+            };
         }
     };
 
     class ScriptTypeRegistry {
     public:
         inline static void RegisterTypes(ScriptEngine& engine) {
-            engine.RegisterTypes<BehaviorEntity, Clock, Transform, SceneState, Vec2>();
+            engine.RegisterTypes<BehaviorEntity, Clock, Transform, Rigidbody2D, SceneState, Vec2>();
+        }
+
+        /// @brief Registers the types isolated scripts see on a lane, which has no access to the scene
+        inline static void RegisterIsolatedTypes(sol::state& lua) {
+            LuaRegistry<BehaviorEntity> {}.RegisterWithLua(lua);
+            LuaRegistry<Clock> {}.RegisterWithLua(lua);
+            LuaRegistry<Transform> {}.RegisterWithLua(lua);
+            LuaRegistry<Rigidbody2D> {}.RegisterWithLua(lua);
+            LuaRegistry<Vec2> {}.RegisterWithLua(lua);
         }
     };
 }  // namespace Astera
\ No newline at end of file
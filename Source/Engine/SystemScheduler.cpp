@@ -0,0 +1,136 @@
+/*
+ *  Filename: SystemScheduler.cpp
+ *  This code is part of the Astera core library
+ *  Copyright 2025 Jake Rieger
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "SystemScheduler.hpp"
+
+#include <chrono>
+
+namespace Astera {
+    bool SystemAccess::ConflictsWith(const SystemAccess& other) const {
+        if (mExclusive || other.mExclusive) return true;
+
+        const auto touches = [](const vector<entt::id_type>& components, entt::id_type component) {
+            return std::ranges::find(components, component) != components.end();
+        };
+
+        for (const auto component : mWrites) {
+            if (touches(other.mReads, component) || touches(other.mWrites, component)) return true;
+        }
+
+        for (const auto component : other.mWrites) {
+            if (touches(mReads, component)) return true;
+        }
+
+        return false;
+    }
+
+    void SystemScheduler::AddSystem(const string& name, const SystemAccess& access, SystemFunc func) {
+        ASTERA_ASSERT_MSG(std::ranges::find(mSystems, name, &System::name) == mSystems.end(),
+                          "System names must be unique");
+        mSystems.push_back({name, access, std::move(func)});
+        mStagesDirty = true;
+    }
+
+    bool SystemScheduler::RemoveSystem(const string& name) {
+        const auto it = std::ranges::find(mSystems, name, &System::name);
+        if (it == mSystems.end()) return false;
+
+        mSystems.erase(it);
+        mStagesDirty = true;
+        return true;
+    }
+
+    void SystemScheduler::Run(SceneState& state, f32 deltaTime) {
+        if (mStagesDirty) { BuildStages(); }
+
+        for (const auto& stage : mStages) {
+            RunStage(stage, state, deltaTime);
+        }
+    }
+
+    void SystemScheduler::BuildStages() {
+        mStages.clear();
+        vector<u32> stageOfSystem(mSystems.size(), 0);
+
+        for (u32 i = 0; i < mSystems.size(); ++i) {
+            u32 stage = 0;
+            for (u32 j = 0; j < i; ++j) {
+                if (mSystems[i].access.ConflictsWith(mSystems[j].access)) {
+                    stage = std::max(stage, stageOfSystem[j] + 1);
+                }
+            }
+
+            stageOfSystem[i] = stage;
+            if (stage >= mStages.size()) { mStages.resize(stage + 1); }
+            mStages[stage].push_back(i);
+        }
+
+        mTimings.clear();
+        mTimingOfSystem.resize(mSystems.size());
+        for (u32 stage = 0; stage < mStages.size(); ++stage) {
+            for (const u32 system : mStages[stage]) {
+                mTimingOfSystem[system] = CAST<u32>(mTimings.size());
+                mTimings.push_back({mSystems[system].name, stage, 0.0f});
+            }
+        }
+
+        mStagesDirty = false;
+    }
+
+    void SystemScheduler::RunStage(const vector<u32>& stage, SceneState& state, f32 deltaTime) {
+        if (stage.size() == 1 || !gJobSystem || !gJobSystem->IsInitialized()) {
+            for (const u32 system : stage) {
+                RunSystem(system, state, deltaTime);
+            }
+            return;
+        }
+
+        mJobs.clear();
+        for (const u32 system : stage) {
+            if (mSystems[system].access.IsMainThread()) continue;
+            mJobs.push_back([this, system, &state, deltaTime] { RunSystem(system, state, deltaTime); });
+        }
+
+        const auto counter = mJobs.empty() ? nullptr : gJobSystem->SubmitBatch(mJobs);
+
+        // Main thread systems run here while the workers take the rest of the stage
+        for (const u32 system : stage) {
+            if (mSystems[system].access.IsMainThread()) { RunSystem(system, state, deltaTime); }
+        }
+
+        gJobSystem->WaitForCounter(counter);
+    }
+
+    void SystemScheduler::RunSystem(u32 index, SceneState& state, f32 deltaTime) {
+        const auto start = std::chrono::steady_clock::now();
+        mSystems[index].func(state, deltaTime);
+        const auto end = std::chrono::steady_clock::now();
+
+        mTimings[mTimingOfSystem[index]].time = std::chrono::duration<f32, std::milli>(end - start).count();
+    }
+}  // namespace Astera
@@ -0,0 +1,163 @@
+/*
+ *  Filename: SystemScheduler.hpp
+ *  This code is part of the Astera core library
+ *  Copyright 2025 Jake Rieger
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include "EngineCommon.hpp"
+#include "JobSystem.hpp"
+#include "SceneState.hpp"
+
+#include <span>
+
+namespace Astera {
+    /// @brief Components a system reads and writes, used to decide which systems may run at the same time
+    class SystemAccess {
+    public:
+        template<typename... Components>
+            requires(ValidComponent<Components> && ...)
+        SystemAccess& Read() {
+            (mReads.push_back(entt::type_hash<Components>::value()), ...);
+            return *this;
+        }
+
+        template<typename... Components>
+            requires(ValidComponent<Components> && ...)
+        SystemAccess& Write() {
+            (mWrites.push_back(entt::type_hash<Components>::value()), ...);
+            return *this;
+        }
+
+        /// @brief Marks state outside the registry as touched (audio, the physics engine, game globals), the system
+        /// then never runs alongside another system
+        SystemAccess& Exclusive() {
+            mExclusive = true;
+            return *this;
+        }
+
+        /// @brief Runs the system on the thread that calls SystemScheduler::Run, required for Lua and OpenGL
+        SystemAccess& MainThread() {
+            mMainThread = true;
+            return *this;
+        }
+
+        ASTERA_KEEP bool IsMainThread() const {
+            return mMainThread;
+        }
+
+        /// @brief Two systems conflict when either writes a component the other reads or writes
+        ASTERA_KEEP bool ConflictsWith(const SystemAccess& other) const;
+
+    private:
+        vector<entt::id_type> mReads;
+        vector<entt::id_type> mWrites;
+        bool mExclusive {false};
+        bool mMainThread {false};
+    };
+
+    /// @brief Time a system took during the last SystemScheduler::Run
+    struct SystemTiming {
+        string name;
+        u32 stage {0};    ///< Systems in the same stage may run concurrently
+        f32 time {0.0f};  ///< Milliseconds
+    };
+
+    /// @brief Runs native per-frame systems over the scene, concurrently where their component access allows
+    ///
+    /// Systems are split into stages. A system goes into the stage after the last earlier-registered system it
+    /// conflicts with, so conflicting systems always run in registration order and everything in one stage runs in
+    /// parallel on the job system. Systems must not create or destroy entities, or add or remove components, since
+    /// other systems may be iterating the registry at the same time.
+    class SystemScheduler {
+    public:
+        using SystemFunc = std::function<void(SceneState& state, f32 deltaTime)>;
+
+        SystemScheduler() = default;
+
+        ASTERA_CLASS_PREVENT_MOVES_COPIES(SystemScheduler)
+
+        /// @brief Registers a system
+        /// @param name Unique name shown in the debug overlay
+        /// @param access Components the system reads and writes
+        /// @param func Called once per Run
+        void AddSystem(const string& name, const SystemAccess& access, SystemFunc func);
+
+        /// @brief Unregisters a system
+        /// @return False if no system has that name
+        bool RemoveSystem(const string& name);
+
+        /// @brief Runs every system once, returning after all of them have finished
+        void Run(SceneState& state, f32 deltaTime);
+
+        /// @brief Per-system timings from the last Run, in stage order
+        ASTERA_KEEP std::span<const SystemTiming> GetTimings() const {
+            return mTimings;
+        }
+
+        ASTERA_KEEP size_t GetSystemCount() const {
+            return mSystems.size();
+        }
+
+    private:
+        struct System {
+            string name;
+            SystemAccess access;
+            SystemFunc func;
+        };
+
+        vector<System> mSystems;
+        vector<vector<u32>> mStages;  ///< System indices per stage
+        vector<SystemTiming> mTimings;
+        vector<u32> mTimingOfSystem;  ///< Index into mTimings per system
+        vector<JobSystem::Job> mJobs;
+        bool mStagesDirty {false};
+
+        void BuildStages();
+        void RunStage(const vector<u32>& stage, SceneState& state, f32 deltaTime);
+        void RunSystem(u32 index, SceneState& state, f32 deltaTime);
+    };
+
+    /// @brief Calls `func(entity, components&...)` for every entity in a view, split into chunks over the job system
+    ///
+    /// Meant for use inside systems: `func` may only touch the components its system declared and must not add or
+    /// remove components or entities.
+    template<typename... Components, typename Func>
+        requires(ValidComponent<Components> && ...)
+    void ParallelEach(SceneState& state, Func&& func, size_t chunkSize = 256) {
+        auto view = state.View<Components...>();
+        const vector<Entity> entities(view.begin(), view.end());
+
+        ParallelFor(
+          0,
+          entities.size(),
+          [&](size_t i) {
+              const Entity entity = entities[i];
+              func(entity, view.template get<Components>(entity)...);
+          },
+          chunkSize);
+    }
+}  // namespace Astera
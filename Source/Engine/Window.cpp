@@ -19,11 +19,19 @@
 #include "Window.hpp"
 #include "Log.hpp"
 
+#include <cmath>
 #include <stb_image.h>
 
 namespace Astera {
     Window::Window(const WindowConfig& config)
-        : mTitle(config.title), mWidth(config.width), mHeight(config.height), mVsync(config.vsync) {}
+        : mTitle(config.title),
+          mWidth(config.width),
+          mHeight(config.height),
+          mVsync(config.vsync),
+          mFixedTimeStep(1.0 / CAST<f64>(config.fixedUpdateRate)),
+          mMaxFixedSteps(config.maxFixedStepsPerFrame) {
+        ASTERA_ASSERT(config.fixedUpdateRate > 0);
+    }
 
     Window::~Window() {
         Shutdown();
@@ -38,6 +46,7 @@ namespace Astera {
 
         while (mRunning && !glfwWindowShouldClose(mWindow)) {
             mClock.Tick();
+            RunFixedUpdates(mClock.GetDeltaTimePrecise());
             OnUpdate(mClock);
             OnLateUpdate();
             glfwPollEvents();
@@ -47,6 +56,26 @@ namespace Astera {
         Shutdown();
     }
 
+    void Window::RunFixedUpdates(f64 deltaTime) {
+        mFixedAccumulator += deltaTime;
+        mFixedSteps = 0;
+
+        while (mFixedAccumulator >= mFixedTimeStep && mFixedSteps < mMaxFixedSteps) {
+            OnFixedUpdate(CAST<f32>(mFixedTimeStep));
+            mFixedAccumulator -= mFixedTimeStep;
+            ++mFixedSteps;
+        }
+
+        // Too far behind to catch up, drop whole steps instead of spiralling into ever longer frames
+        if (mFixedAccumulator >= mFixedTimeStep) { mFixedAccumulator = std::fmod(mFixedAccumulator, mFixedTimeStep); }
+    }
+
+    void Window::SetFixedUpdateRate(u32 rate) {
+        ASTERA_ASSERT(rate > 0);
+        mFixedTimeStep    = 1.0 / CAST<f64>(rate);
+        mFixedAccumulator = 0.0;
+    }
+
     void Window::Close() {
         mRunning = false;
     }
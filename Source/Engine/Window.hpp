@@ -31,6 +31,8 @@ namespace Astera {
         bool vsync {false};
         bool resizable {true};
         bool decorated {true};
+        u32 fixedUpdateRate {60};       ///< Fixed updates per second of game time
+        u32 maxFixedStepsPerFrame {8};  ///< Fixed updates a single frame may run before excess time is dropped
     };
 
     /// @brief Base class for platform window management
@@ -103,12 +105,39 @@ namespace Astera {
             return mClock;
         }
 
+        /// @brief Changes how many fixed updates run per second of game time
+        /// @param rate Fixed updates per second, must be greater than zero
+        void SetFixedUpdateRate(u32 rate);
+
+        /// @brief Gets the length of a fixed update
+        /// @return Fixed time step in seconds
+        ASTERA_KEEP f32 GetFixedTimeStep() const {
+            return CAST<f32>(mFixedTimeStep);
+        }
+
+        /// @brief Gets how far the frame is between the last fixed update and the next one
+        /// @return Blend factor in [0, 1) used to interpolate render state between fixed updates
+        ASTERA_KEEP f32 GetInterpolationAlpha() const {
+            return CAST<f32>(mFixedAccumulator / mFixedTimeStep);
+        }
+
+        /// @brief Gets the number of fixed updates run during the current frame
+        ASTERA_KEEP u32 GetFixedStepCount() const {
+            return mFixedSteps;
+        }
+
     protected:
         // Lifecycle hooks - override these in derived classes
 
         /// @brief Called once when the window is initialized
         virtual void OnAwake() {}
 
+        /// @brief Called zero or more times per frame at a fixed rate, before OnUpdate
+        /// @param timeStep Fixed time step in seconds
+        virtual void OnFixedUpdate(f32 timeStep) {
+            ASTERA_UNUSED(timeStep);
+        }
+
         /// @brief Called every frame to update logic
         /// @param clock Reference to the game clock
         virtual void OnUpdate(const Clock& clock) {
@@ -193,6 +222,7 @@ namespace Astera {
 
         bool Initialize();
         void Shutdown();
+        void RunFixedUpdates(f64 deltaTime);
 
     protected:
         GLFWwindow* mWindow {nullptr};
@@ -204,5 +234,10 @@ namespace Astera {
 
         Clock mClock;
         InputManager mInputManager;
+
+        f64 mFixedTimeStep;
+        u32 mMaxFixedSteps;
+        f64 mFixedAccumulator {0.0};  ///< Game time not yet consumed by fixed updates
+        u32 mFixedSteps {0};          ///< Fixed updates run during the current frame
     };
 }  // namespace Astera
\ No newline at end of file
@@ -85,6 +85,8 @@ namespace AsteraCLI {
                 type = AssetType::TextData;
             } else if (fileExt == "spritesheet") {
                 type = AssetType::SpriteSheet;
+            } else if (fileExt == ".tilemap") {
+                type = AssetType::Tilemap;
             } else if (std::ranges::find(shaderExtensions, fileExt) != shaderExtensions.end()) {
                 type = AssetType::Shader;
             }